@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(chain_block_benchmarks)
+
+const auto hash_tx1 = hash_literal(
+    "bf7c3f5a69a78edd81f3eff7e93a37fb2d7da394d48db4d85e7e5353b9b8e270");
+
+BOOST_AUTO_TEST_CASE(block__is_internal_double_spend__ten_thousand_inputs)
+{
+    static const uint32_t inputs = 10000;
+    chain::transaction spend;
+    spend.inputs().reserve(inputs);
+
+    for (uint32_t index = 0; index < inputs; ++index)
+        spend.inputs().emplace_back(chain::output_point{ hash_tx1, index }, chain::script{}, 0);
+
+    chain::block instance;
+    instance.set_transactions({ chain::transaction{}, spend });
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    const auto result = instance.is_internal_double_spend();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count();
+    BOOST_TEST_MESSAGE("block::is_internal_double_spend(): " << elapsed <<
+        " us for " << inputs << " inputs");
+
+    BOOST_REQUIRE(!result);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
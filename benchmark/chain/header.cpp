@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(chain_header_benchmarks)
+
+BOOST_AUTO_TEST_CASE(header__proof_of_work__one_million_headers)
+{
+    static const uint32_t iterations = 1000000;
+    typedef std::chrono::high_resolution_clock clock;
+    const settings settings(bc::config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto nonce = genesis.header().nonce();
+    auto header = genesis.header();
+    size_t valid = 0;
+    uint256_t work;
+
+    // Only the genesis nonce satisfies the genesis target.
+    auto start = clock::now();
+    for (uint32_t count = 0; count < iterations; ++count)
+    {
+        header.set_nonce(nonce + count);
+        valid += header.is_valid_proof_of_work(settings.proof_of_work_limit,
+            false) ? 1 : 0;
+    }
+    const auto checked = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(clock::now() - start).count();
+
+    start = clock::now();
+    for (uint32_t count = 0; count < iterations; ++count)
+        work += chain::header::proof(header.bits());
+    const auto summed = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(clock::now() - start).count();
+
+    BOOST_TEST_MESSAGE("header::is_valid_proof_of_work(): " <<
+        checked / iterations << " ns, header::proof(): " <<
+        summed / iterations << " ns per header");
+
+    BOOST_REQUIRE_EQUAL(valid, 1u);
+    BOOST_REQUIRE_EQUAL(work, uint256_t(0x0000000100010001) * iterations);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
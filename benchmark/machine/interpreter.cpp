@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::machine;
+
+// Counts global heap allocations of this benchmark process.
+static std::atomic<size_t> heap_allocations(0);
+
+void* operator new(size_t size)
+{
+    ++heap_allocations;
+    const auto block = std::malloc(size == 0 ? 1 : size);
+
+    if (block == nullptr)
+        throw std::bad_alloc();
+
+    return block;
+}
+
+void operator delete(void* block) BC_NOEXCEPT
+{
+    std::free(block);
+}
+
+BOOST_AUTO_TEST_SUITE(interpreter_benchmarks)
+
+static const auto forks = static_cast<uint32_t>(rule_fork::all_rules);
+static const ec_secret secret = base16_literal(
+    "8010b1bb119ad37d4b65a1022a314897b1b3614b345974332cb1b9582cf03536");
+
+// Benchmark helper, the pay key hash script of the secret's public key.
+static chain::script make_pay_key_hash()
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    return chain::script::to_pay_key_hash_pattern(bitcoin_short_hash(
+        to_chunk(point)));
+}
+
+// Benchmark helper, a transaction whose input spends with [endorsement][key].
+static chain::transaction make_spend(const chain::script& prevout_script)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+
+    chain::transaction tx{ 1, 0, { { { null_hash, 0 }, {}, 0 } }, {} };
+    endorsement out;
+    BOOST_REQUIRE(chain::script::create_endorsement(out, secret,
+        prevout_script, tx, 0, sighash_algorithm::all));
+
+    tx.inputs().front().set_script(chain::script({ { to_chunk(out) },
+        { to_chunk(point) } }));
+    return tx;
+}
+
+// Benchmark helper, the allocations of a prevout script run alone.
+static size_t run_allocations(const chain::transaction& tx,
+    const chain::script& prevout_script)
+{
+    program input(tx.inputs().front().script(), tx, 0, forks);
+    BOOST_REQUIRE_EQUAL(input.evaluate(), error::success);
+
+    program prevout(prevout_script, input);
+    const auto before = heap_allocations.load();
+    const auto ec = interpreter::run(prevout);
+    const auto allocations = heap_allocations.load() - before;
+
+    BOOST_REQUIRE_EQUAL(ec, error::success);
+    BOOST_REQUIRE(prevout.stack_true(false));
+    return allocations;
+}
+
+BOOST_AUTO_TEST_CASE(interpreter__run__pay_key_hash_inputs__no_heap_allocation)
+{
+    const auto tx = make_spend(make_pay_key_hash());
+
+    // Pushing the endorsement and key copies them into inline stack items.
+    program input(tx.inputs().front().script(), tx, 0, forks);
+    const auto before = heap_allocations.load();
+    BOOST_REQUIRE_EQUAL(interpreter::run(input), error::success);
+    const auto allocations = heap_allocations.load() - before;
+
+    BOOST_TEST_MESSAGE("pay key hash input run: " << allocations <<
+        " allocations");
+    BOOST_REQUIRE_EQUAL(allocations, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(interpreter__run__pay_key_hash_verify__no_heap_allocation)
+{
+    // [endorsement][key] dup hash160 [key_hash] equalverify checksig.
+    const auto pay_key_hash = make_pay_key_hash();
+    const auto tx = make_spend(pay_key_hash);
+
+    // [endorsement][key] dup hash160 [key_hash] equalverify, which leaves the
+    // endorsement on the stack. This is all of the standard stack traffic.
+    auto operations = pay_key_hash.operations();
+    operations.pop_back();
+    const chain::script key_hash_verify(operations);
+
+    const auto allocations = run_allocations(tx, key_hash_verify);
+    BOOST_TEST_MESSAGE("pay key hash verify run: " << allocations <<
+        " allocations");
+    BOOST_REQUIRE_EQUAL(allocations, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(interpreter__run__pay_key_hash__succeeds)
+{
+    const auto pay_key_hash = make_pay_key_hash();
+    const auto tx = make_spend(pay_key_hash);
+
+    // The first run populates the signature cache.
+    run_allocations(tx, pay_key_hash);
+
+    // Signature checking allocates (script code, sighash and cache key).
+    const auto allocations = run_allocations(tx, pay_key_hash);
+    BOOST_TEST_MESSAGE("pay key hash run: " << allocations << " allocations");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
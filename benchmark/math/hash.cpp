@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(hash_benchmarks)
+
+template <typename Set>
+static size_t duplicates(const hash_list& hashes, int64_t& elapsed)
+{
+    typedef std::chrono::high_resolution_clock clock;
+    const auto start = clock::now();
+    Set set(hashes.size());
+    size_t count = 0;
+
+    for (const auto& hash: hashes)
+        count += set.insert(hash).second ? 0 : 1;
+
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        clock::now() - start).count();
+    return count;
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__dedup__matches_hash_range)
+{
+    static const size_t count = 100000;
+    struct range_hash
+    {
+        size_t operator()(const hash_digest& hash) const
+        {
+            return boost::hash_range(hash.begin(), hash.end());
+        }
+    };
+
+    // Each hash appears twice, as in a double spend check.
+    hash_list hashes;
+    hashes.reserve(2 * count);
+    for (size_t index = 0; index < count; ++index)
+        hashes.push_back(sha256_hash(to_chunk(to_little_endian(index))));
+    for (size_t index = 0; index < count; ++index)
+        hashes.push_back(hashes[index]);
+
+    int64_t ranged;
+    int64_t salted;
+    const auto expected = duplicates<std::unordered_set<hash_digest,
+        range_hash>>(hashes, ranged);
+    const auto actual = duplicates<std::unordered_set<hash_digest>>(hashes,
+        salted);
+
+    BOOST_TEST_MESSAGE("unordered_set<hash_digest> dedup hash_range: " <<
+        ranged << " us, salted_hash: " << salted << " us");
+
+    BOOST_REQUIRE_EQUAL(expected, count);
+    BOOST_REQUIRE_EQUAL(actual, count);
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__seeds__batch_matches_single)
+{
+    // A bip39 seed is 2048 iterations over the sentence and salted passphrase.
+    static const size_t count = 32;
+    static const size_t iterations = 2048;
+    typedef std::chrono::high_resolution_clock clock;
+    data_stack passphrases;
+    data_stack salts(count, to_chunk(std::string("mnemonic")));
+
+    for (size_t index = 0; index < count; ++index)
+        passphrases.push_back(to_chunk("sentence " + std::to_string(index)));
+
+    long_hash_list expected;
+    const auto single = clock::now();
+
+    for (size_t index = 0; index < count; ++index)
+        expected.push_back(pkcs5_pbkdf2_hmac_sha512(passphrases[index],
+            salts[index], iterations));
+
+    const auto batch = clock::now();
+    const auto actual = pkcs5_pbkdf2_hmac_sha512(passphrases, salts,
+        iterations);
+    const auto end = clock::now();
+
+    BOOST_TEST_MESSAGE("pbkdf2 hmac sha512 " << count << " seeds single: " <<
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            batch - single).count() << " us, batch: " <<
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            end - batch).count() << " us");
+
+    BOOST_REQUIRE(actual == expected);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_hash__headers__matches_crypto_scrypt)
+{
+    static const size_t iterations = 32;
+    typedef std::chrono::high_resolution_clock clock;
+    const auto elapsed = [](const clock::time_point& start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            clock::now() - start).count() / iterations;
+    };
+
+    data_chunk blocks;
+    for (size_t index = 0; index < iterations; ++index)
+        extend_data(blocks, data_chunk(80, static_cast<uint8_t>(index)));
+
+    hash_list expected;
+    auto start = clock::now();
+    for (size_t index = 0; index < iterations; ++index)
+    {
+        const data_slice header(&blocks[index * 80], &blocks[(index + 1) * 80]);
+        expected.push_back(scrypt<hash_size>(header, header, 1024u, 1u, 1u));
+    }
+    const auto reference = elapsed(start);
+
+    hash_list singles;
+    start = clock::now();
+    for (size_t index = 0; index < iterations; ++index)
+    {
+        const data_slice header(&blocks[index * 80], &blocks[(index + 1) * 80]);
+        singles.push_back(scrypt_hash(header));
+    }
+    const auto single = elapsed(start);
+
+    start = clock::now();
+    const auto batch = scrypt_hash_blocks(blocks, 80);
+    const auto batched = elapsed(start);
+
+    BOOST_TEST_MESSAGE("scrypt (" << scrypt_engines() << ") crypto_scrypt: " <<
+        reference << " us, scrypt_hash: " << single <<
+        " us, scrypt_hash_blocks: " << batched << " us per header");
+
+    BOOST_REQUIRE(singles == expected);
+    BOOST_REQUIRE(batch == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(once_value_benchmarks)
+
+BOOST_AUTO_TEST_CASE(once_value__header_hash__uncontended)
+{
+    static const size_t iterations = 100000;
+    const chain::header header(1, null_hash, null_hash, 2, 3, 4);
+    const auto expected = header.hash();
+    auto matched = true;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (size_t count = 0; count < iterations; ++count)
+        matched &= (header.hash() == expected);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    const auto elapsed = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(end - start).count();
+    BOOST_TEST_MESSAGE("header::hash(): " << elapsed / iterations <<
+        " ns per call");
+
+    BOOST_REQUIRE(matched);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
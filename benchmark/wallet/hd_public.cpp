@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(hd_public_benchmarks)
+
+#define LONG_SEED "fffcf9f6f3f0edeae7e4e1dedbd8d5d2cfccc9c6c3c0bdbab7b4b1aeaba8a5a29f9c999693908d8a8784817e7b7875726f6c696663605d5a5754514e4b484542"
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__gap_scan)
+{
+    static const uint32_t count = 1000;
+    typedef std::chrono::high_resolution_clock clock;
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    point_list expected;
+    expected.reserve(count);
+
+    const auto single = clock::now();
+
+    for (uint32_t index = 0; index < count; ++index)
+        expected.push_back(m_pub.derive_public(index).point());
+
+    const auto range = clock::now();
+    point_list actual;
+    BOOST_REQUIRE(m_pub.derive_public_range(actual, 0, count));
+
+    const auto concurrent = clock::now();
+    point_list partitioned;
+    threadpool pool(4);
+    BOOST_REQUIRE(m_pub.derive_public_range(partitioned, 0, count, pool));
+    const auto end = clock::now();
+
+    BOOST_TEST_MESSAGE("hd_public " << count << " children derive_public: " <<
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            range - single).count() << " us, derive_public_range: " <<
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            concurrent - range).count() << " us, four threads: " <<
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            end - concurrent).count() << " us");
+
+    BOOST_REQUIRE(actual == expected);
+    BOOST_REQUIRE(partitioned == expected);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -32,10 +32,13 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/merkle_tree.hpp>
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/script_arena.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -59,11 +62,15 @@ public:
         asio::time_point start_populate;
         asio::time_point start_accept;
         asio::time_point start_connect;
+        asio::time_point end_connect;
         asio::time_point start_notify;
         asio::time_point start_pop;
         asio::time_point start_push;
         asio::time_point end_push;
         float cache_efficiency;
+
+        /// Inputs verified per second by the last successful connect.
+        float connect_rate;
     };
 
     // Constructors.
@@ -94,10 +101,24 @@ public:
     static block factory(std::istream& stream, bool witness=false);
     static block factory(reader& source, bool witness=false);
 
+    /// Deserialize with script bytes allocated from the arena (if not null).
+    /// Each script retains the arena, but a script copy owns its bytes, so
+    /// copy a script that outlives the block to allow release of the arena.
+    static block factory(const data_chunk& data,
+        const script_arena::ptr& memory, bool witness=false);
+    static block factory(reader& source, const script_arena::ptr& memory,
+        bool witness=false);
+
     bool from_data(const data_chunk& data, bool witness=false);
     bool from_data(std::istream& stream, bool witness=false);
     bool from_data(reader& source, bool witness=false);
 
+    /// Deserialize with script bytes allocated from the arena (if not null).
+    bool from_data(const data_chunk& data, const script_arena::ptr& memory,
+        bool witness=false);
+    bool from_data(reader& source, const script_arena::ptr& memory,
+        bool witness=false);
+
     bool is_valid() const;
 
     // Serialization.
@@ -143,6 +164,7 @@ public:
     uint64_t reward(size_t height, uint64_t subsidy_interval,
         uint64_t initial_block_subsidy_satoshi) const;
     hash_digest generate_merkle_root(bool witness=false) const;
+    merkle_tree generate_merkle_tree(bool witness=false) const;
     size_t signature_operations() const;
     size_t signature_operations(bool bip16, bool bip141) const;
     size_t total_non_coinbase_inputs() const;
@@ -152,12 +174,22 @@ public:
     bool is_extra_coinbases() const;
     bool is_final(size_t height, uint32_t block_time) const;
     bool is_distinct_transaction_set() const;
+
+    /// Sets the position of the first repeated transaction hash if not.
+    bool is_distinct_transaction_set(size_t& out_transaction) const;
+
     bool is_valid_coinbase_claim(size_t height, uint64_t subsidy_interval,
         uint64_t initial_block_subsidy_satoshi) const;
     bool is_valid_coinbase_script(size_t height) const;
     bool is_valid_witness_commitment() const;
     bool is_forward_reference() const;
     bool is_internal_double_spend() const;
+
+    /// Sets the position of the transaction and input of the first repeated
+    /// previous output if true.
+    bool is_internal_double_spend(size_t& out_transaction,
+        size_t& out_input) const;
+
     bool is_valid_merkle_root() const;
     bool is_segregated() const;
 
@@ -173,6 +205,15 @@ public:
     code connect(const chain_state& state) const;
     code connect_transactions(const chain_state& state) const;
 
+    /// Parallel connect, fans input script verification out over the pool.
+    /// Returns the same code as the serial overloads. The calling thread also
+    /// verifies and blocks until all inputs are verified, so this completes
+    /// when called from a pool thread or on a stopped pool.
+    code connect(threadpool& pool) const;
+    code connect(const chain_state& state, threadpool& pool) const;
+    code connect_transactions(const chain_state& state,
+        threadpool& pool) const;
+
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
     mutable validation metadata;
 
@@ -184,6 +225,8 @@ private:
 
     optional_size total_inputs_cache() const;
     optional_size non_coinbase_inputs_cache() const;
+    void release_signature_hashes() const;
+    void set_connect_rate() const;
 
     chain::header header_;
     transaction::list transactions_;
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_BLOCK_PIPELINE_HPP
+#define LIBBITCOIN_CHAIN_BLOCK_PIPELINE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+class settings;
+
+namespace chain {
+
+/// This class is thread safe.
+/// Validates a sequence of blocks with the check, accept and connect stages
+/// overlapped, so that block N connects while N+1 accepts and N+2 checks.
+/// Each stage runs in order on its own dispatcher strand of the threadpool.
+/// Blocks must be pushed in chain order and each header must carry its chain
+/// state. Prevouts must be populated by the time the block is accepted, which
+/// may be done by a populator invoked at the start of the accept stage.
+class BC_API block_pipeline
+  : noncopyable
+{
+public:
+    typedef std::shared_ptr<const block> block_const_ptr;
+    typedef std::function<void(const code&, block_const_ptr)> result_handler;
+    typedef std::function<code(const block&)> populate_handler;
+
+    /// Three blocks allow all stages to overlap, more absorb stage jitter.
+    static const size_t default_capacity;
+
+    enum class stage
+    {
+        check,
+        accept,
+        connect
+    };
+
+    struct statistics
+    {
+        /// Blocks waiting for or executing in the stage.
+        size_t depth;
+
+        /// Blocks that have passed through the stage.
+        size_t completed;
+
+        /// Duration of the most recent execution of the stage.
+        asio::microseconds last;
+
+        /// Total duration of all executions of the stage.
+        asio::microseconds total;
+    };
+
+    /// At most capacity (minimum one) blocks are held by the pipeline.
+    /// The settings must outlive the pipeline.
+    block_pipeline(threadpool& pool, const bc::settings& settings,
+        size_t capacity=default_capacity, bool scrypt=false);
+
+    /// Stops the pipeline and waits for the blocks in flight to complete.
+    ~block_pipeline();
+
+    /// Set the populator, invoked for each block prior to accept.
+    /// This is not thread safe and must be set before the first push.
+    void set_populator(populate_handler populator);
+
+    /// Submit the next block, waiting while the pipeline is at capacity.
+    /// Handlers are invoked in submission order from the connect strand.
+    /// Blocks following a failed block are not validated and complete with
+    /// operation_failed. Returns false (handler not invoked) if stopped.
+    /// Do not call from a thread of the pool, as the caller may block.
+    bool push(block_const_ptr block, result_handler handler);
+
+    /// Refuse further blocks, blocks in flight complete with service_stopped.
+    void stop();
+
+    /// Wait until there are no blocks in flight.
+    void wait() const;
+
+    /// The number of blocks pushed and not yet completed.
+    size_t in_flight() const;
+
+    /// The queue depth and latency of the given stage.
+    statistics stage_statistics(stage value) const;
+
+private:
+    struct job
+    {
+        size_t sequence;
+        block_const_ptr block;
+        result_handler handler;
+        code ec;
+    };
+
+    struct counters
+    {
+        std::atomic<size_t> depth;
+        std::atomic<size_t> completed;
+        std::atomic<int64_t> last;
+        std::atomic<int64_t> total;
+    };
+
+    typedef std::shared_ptr<job> job_ptr;
+
+    bool skip(job& job) const;
+    void fail(const job& job);
+    void enter(counters& stage);
+    void leave(counters& stage, const asio::time_point& start);
+
+    void do_check(job_ptr job);
+    void do_accept(job_ptr job);
+    void do_connect(job_ptr job);
+
+    // These are thread safe.
+    const bc::settings& settings_;
+    const size_t capacity_;
+    const bool scrypt_;
+    std::atomic<bool> stopped_;
+    std::atomic<size_t> failed_;
+    counters check_;
+    counters accept_;
+    counters connect_;
+    dispatcher check_dispatch_;
+    dispatcher accept_dispatch_;
+    dispatcher connect_dispatch_;
+
+    // This is not thread safe, set before the first push.
+    populate_handler populator_;
+
+    // These are protected by mutex.
+    size_t next_;
+    size_t in_flight_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable completed_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
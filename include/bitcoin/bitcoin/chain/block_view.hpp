@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+#define LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+
+#include <cstddef>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// A read-only index of a wire serialized block, see transaction_view.
+/// The view does not own the buffer, which must outlive the view.
+class BC_API block_view
+{
+public:
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    block_view();
+
+    // Deserialization.
+    //-------------------------------------------------------------------------
+
+    bool from_data(data_slice data);
+    bool is_valid() const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    /// The serialized byte range of the block.
+    data_slice data() const;
+    size_t serialized_size() const;
+
+    chain::header header() const;
+    hash_digest hash() const;
+    const transaction_view::list& transactions() const;
+
+    // Validation.
+    //-------------------------------------------------------------------------
+
+    hash_list to_hashes(bool witness=false) const;
+    hash_digest generate_merkle_root(bool witness=false) const;
+    bool is_internal_double_spend() const;
+
+    /// Fully deserialize the block.
+    block to_block(bool witness=true) const;
+
+private:
+    void reset();
+
+    data_slice data_;
+    transaction_view::list transactions_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
@@ -19,16 +19,17 @@
 #ifndef LIBBITCOIN_CHAIN_CHAIN_STATE_HPP
 #define LIBBITCOIN_CHAIN_CHAIN_STATE_HPP
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
-#include <deque>
 #include <bitcoin/bitcoin/config/checkpoint.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/utility/persistent_window.hpp>
 
 namespace libbitcoin {
 
@@ -42,9 +43,9 @@ class header;
 class BC_API chain_state
 {
 public:
-    typedef std::deque<uint32_t> bitss;
-    typedef std::deque<uint32_t> versions;
-    typedef std::deque<uint32_t> timestamps;
+    typedef persistent_window<uint32_t> bitss;
+    typedef persistent_window<uint32_t> versions;
+    typedef persistent_window<uint32_t> timestamps;
     typedef struct { size_t count; size_t high; } range;
 
     typedef std::shared_ptr<chain_state> ptr;
@@ -194,9 +195,27 @@ protected:
         uint32_t maximum_transaction_version;
     };
 
+    /// Summaries of the ordered values, promoted along with the values.
+    struct samples
+    {
+        // The number of sampled versions at or above bip34/66/65 versions.
+        size_t count_2;
+        size_t count_3;
+        size_t count_4;
+
+        // The sampled timestamps sorted by value (if within the interval).
+        size_t times_count;
+        std::array<uint32_t, median_time_past_interval> times;
+    };
+
+    static samples summarize(const data& values, const settings& settings);
     static activations activation(const data& values, uint32_t forks,
         const settings& settings);
+    static activations activation(const data& values, const samples& sample,
+        uint32_t forks, const settings& settings);
     static uint32_t median_time_past(const data& values, uint32_t forks);
+    static uint32_t median_time_past(const data& values,
+        const samples& sample);
     static uint32_t work_required(const data& values, uint32_t forks,
         const settings& settings);
 
@@ -219,6 +238,8 @@ private:
         const config::checkpoint& bip9_bit1_active_checkpoint);
     data to_header(const chain_state& parent, const header& header,
         const settings& settings);
+    static samples to_samples(const chain_state& parent, const data& values,
+        const settings& settings);
 
     static uint32_t work_required_retarget(const data& values, uint32_t forks,
         uint32_t proof_of_work_limit, uint32_t minimum_timespan,
@@ -250,6 +271,9 @@ private:
     // Checkpoints do not affect the data that is collected or promoted.
     const config::checkpoint::list& checkpoints_;
 
+    // Summaries are promoted from the parent, or computed from raw data.
+    const samples samples_;
+
     // These are computed on construct from sample and checkpoints.
     const activations active_;
     const uint32_t work_required_;
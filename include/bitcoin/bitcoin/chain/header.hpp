@@ -30,8 +30,8 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/once_value.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
-#include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -179,12 +179,7 @@ protected:
     void invalidate_cache() const;
 
 private:
-    typedef std::shared_ptr<hash_digest> hash_ptr;
-
-    hash_ptr hash_cache() const;
-
-    mutable hash_ptr hash_;
-    mutable upgrade_mutex mutex_;
+    mutable once_value<hash_digest> hash_;
 
     uint32_t version_;
     hash_digest previous_block_hash_;
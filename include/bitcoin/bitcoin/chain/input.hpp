@@ -29,8 +29,9 @@
 #include <bitcoin/bitcoin/chain/witness.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/once_value.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
-#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/script_arena.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
 
@@ -80,6 +81,10 @@ public:
     bool from_data(std::istream& stream, bool wire=true, bool witness=false);
     bool from_data(reader& source, bool wire=true, bool witness=false);
 
+    /// Deserialize with script bytes allocated from the arena (if not null).
+    bool from_data(reader& source, const script_arena::ptr& memory,
+        bool wire=true, bool witness=false);
+
     bool is_valid() const;
 
     // Serialization.
@@ -140,12 +145,7 @@ protected:
     void invalidate_cache() const;
 
 private:
-    typedef std::shared_ptr<wallet::payment_address::list> addresses_ptr;
-
-    addresses_ptr addresses_cache() const;
-
-    mutable upgrade_mutex mutex_;
-    mutable addresses_ptr addresses_;
+    mutable once_value<wallet::payment_address::list> addresses_;
 
     output_point previous_output_;
     chain::script script_;
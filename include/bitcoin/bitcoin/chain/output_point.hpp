@@ -114,4 +114,17 @@ protected:
 } // namespace chain
 } // namespace libbitcoin
 
+// Allow output_point to be in indexed in std::*map classes.
+namespace std
+{
+template <>
+struct hash<bc::chain::output_point>
+{
+    size_t operator()(const bc::chain::output_point& point) const
+    {
+        return bc::salted_hash(point.hash(), point.index());
+    }
+};
+} // namespace std
+
 #endif
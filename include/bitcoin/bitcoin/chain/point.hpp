@@ -27,6 +27,7 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/flat_hash_set.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
@@ -120,7 +121,32 @@ private:
     bool valid_;
 };
 
+/// Hashes a point by its checksum, equal checksums are compared exactly.
+struct point_checksum
+{
+    uint64_t operator()(const point& value) const
+    {
+        return value.checksum();
+    }
+};
+
+/// A fixed capacity set of points for duplicate detection.
+typedef flat_hash_set<point, point_checksum> point_set;
+
 } // namespace chain
 } // namespace libbitcoin
 
+// Allow point to be in indexed in std::*map classes.
+namespace std
+{
+template <>
+struct hash<bc::chain::point>
+{
+    size_t operator()(const bc::chain::point& point) const
+    {
+        return bc::salted_hash(point.hash(), point.index());
+    }
+};
+} // namespace std
+
 #endif
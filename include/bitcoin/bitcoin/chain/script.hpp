@@ -24,6 +24,8 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
@@ -32,9 +34,13 @@
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
 #include <bitcoin/bitcoin/machine/script_pattern.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
+#include <bitcoin/bitcoin/machine/validation_cache.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/once_value.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
-#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/script_arena.hpp>
+#include <bitcoin/bitcoin/utility/small_chunk.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -65,6 +71,8 @@ public:
     script(data_chunk&& encoded, bool prefix);
     script(const data_chunk& encoded, bool prefix);
 
+    ~script();
+
     // Operators.
     //-------------------------------------------------------------------------
 
@@ -87,6 +95,11 @@ public:
     bool from_data(std::istream& stream, bool prefix);
     bool from_data(reader& source, bool prefix);
 
+    /// Deserialize with script bytes held in the arena (if not null).
+    /// Arena bytes are copied to the heap when the script is copied.
+    bool from_data(reader& source, const script_arena::ptr& memory,
+        bool prefix);
+
     /// Deserialization invalidates the iterator.
     void from_operations(operation::list&& ops);
     void from_operations(const operation::list& ops);
@@ -134,11 +147,19 @@ public:
         uint64_t value=max_uint64);
 
     static bool check_signature(const ec_signature& signature,
-        uint8_t sighash_type, const data_chunk& public_key,
+        uint8_t sighash_type, data_slice public_key,
         const script& script_code, const transaction& tx, uint32_t input_index,
         script_version version=script_version::unversioned,
         uint64_t value=max_uint64);
 
+    /// Check a signature against its previously generated signature hash.
+    static bool check_signature(const ec_signature& signature,
+        const hash_digest& sighash, data_slice public_key);
+
+    /// Check prepared signatures concurrently, as check_signature, setting
+    /// the result of each job. True if all are valid.
+    static bool check_signatures(verify_job::list& jobs, threadpool& pool);
+
     static bool create_endorsement(endorsement& out, const ec_secret& secret,
         const script& prevout_script, const transaction& tx,
         uint32_t input_index, uint8_t sighash_type,
@@ -203,7 +224,7 @@ public:
 
     /// Consensus computations.
     size_t sigops(bool accurate) const;
-    void find_and_delete(const data_stack& endorsements);
+    void find_and_delete(const small_stack& endorsements);
     bool is_unspendable() const;
 
     // Validation.
@@ -216,6 +237,21 @@ public:
     static code verify(const transaction& tx, uint32_t input_index,
         uint32_t forks, const script& prevout_script, uint64_t value);
 
+    /// Prepare the signature check of a standard key hash spend (p2pkh or
+    /// p2wpkh), false if the input requires script evaluation. The job refers
+    /// to the public key of the input, so must not outlive the transaction.
+    static bool prepare_signature(verify_job& out, const transaction& tx,
+        uint32_t input_index, uint32_t forks, const script& prevout_script,
+        uint64_t value);
+
+    /// Successful signature verifications, shared by all validation.
+    /// Keyed on public key, signature hash and signature (enabled).
+    static machine::validation_cache& signature_cache();
+
+    /// Successful input script verifications, shared by all validation.
+    /// Keyed on wtxid, input index, forks and previous output (disabled).
+    static machine::validation_cache& script_cache();
+
 protected:
     // So that input and output may call reset from their own.
     friend class input;
@@ -226,6 +262,20 @@ protected:
     bool is_pay_to_script_hash(uint32_t forks) const;
 
 private:
+    // Script bytes held in an arena, which the script retains.
+    struct arena_bytes
+    {
+        const uint8_t* data;
+        size_t size;
+        script_arena::ptr memory;
+    };
+
+    // Either owned bytes (data_chunk) or arena bytes, in the same space.
+    typedef std::aligned_storage<
+        (sizeof(data_chunk) > sizeof(arena_bytes) ?
+            sizeof(data_chunk) : sizeof(arena_bytes)),
+        std::alignment_of<data_chunk>::value>::type bytes_storage;
+
     static size_t serialized_size(const operation::list& ops);
     static data_chunk operations_to_data(const operation::list& ops);
     static hash_digest generate_unversioned_signature_hash(
@@ -234,18 +284,28 @@ private:
     static hash_digest generate_version_0_signature_hash(const transaction& tx,
         uint32_t input_index, const script& script_code, uint64_t value,
         uint8_t sighash_type);
-
-    void find_and_delete_(const data_chunk& endorsement);
-
-    operation::list& operations_move();
-    const operation::list& operations_copy() const;
-
-    // These are protected by mutex.
-    mutable operation::list operations_;
-    mutable bool cached_;
-    mutable upgrade_mutex mutex_;
-
-    data_chunk bytes_;
+    static code verify_input(const transaction& tx, uint32_t input_index,
+        uint32_t forks, const script& prevout_script, uint64_t value);
+    static bool prepare_pay_key_hash(verify_job& out, const transaction& tx,
+        uint32_t input_index, uint32_t forks, const script& prevout_script);
+    static bool prepare_pay_witness_key_hash(verify_job& out,
+        const transaction& tx, uint32_t input_index, uint32_t forks,
+        const script& prevout_script, uint64_t value);
+
+    void find_and_delete_(const small_chunk& endorsement);
+
+    data_slice bytes() const;
+    data_chunk& owned_bytes();
+    void set_bytes(data_chunk&& bytes);
+    void set_bytes(const script_arena::ptr& memory, const uint8_t* data,
+        size_t size);
+    void destroy_bytes();
+
+    // The operations are parsed from bytes once and published without a lock.
+    mutable once_value<operation::list> operations_;
+
+    bytes_storage bytes_;
+    bool arena_;
     bool valid_;
 };
 
@@ -25,7 +25,6 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <boost/optional.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/input.hpp>
 #include <bitcoin/bitcoin/chain/output.hpp>
@@ -36,13 +35,17 @@
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/machine/sighash_algorithm.hpp>
+#include <bitcoin/bitcoin/utility/once_value.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
-#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/script_arena.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
 
+class sighash_context;
+
 class BC_API transaction
 {
 public:
@@ -117,6 +120,10 @@ public:
     bool from_data(std::istream& stream, bool wire=true, bool witness=false);
     bool from_data(reader& source, bool wire=true, bool witness=false);
 
+    /// Deserialize with script bytes allocated from the arena (if not null).
+    bool from_data(reader& source, const script_arena::ptr& memory,
+        bool wire=true, bool witness=false);
+
     // Non-wire store deserializations to preserve hash.
     bool from_data(reader& source, hash_digest&& hash, bool wire=true, bool witness=false);
     bool from_data(reader& source, const hash_digest& hash, bool wire=true, bool witness=false);
@@ -161,6 +168,19 @@ public:
     hash_digest sequences_hash() const;
     hash_digest hash(bool witness=false) const;
 
+    // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
+    /// Unversioned signature hash from a cached serialization context.
+    /// The index must be valid for the algorithm and the script code must be
+    /// stripped of code separators (see script::generate_signature_hash).
+    /// The context is cached only for multiple inputs, until released.
+    hash_digest unversioned_signature_hash(uint32_t input_index,
+        const script& script_code, machine::sighash_algorithm algorithm,
+        uint8_t sighash_type) const;
+
+    /// Release the cached signature hash context, not concurrency-safe.
+    /// Connect releases it, call after verifying inputs by connect_input.
+    void release_signature_hashes() const;
+
     // Utilities.
     //-------------------------------------------------------------------------
 
@@ -210,31 +230,29 @@ protected:
     bool all_inputs_final() const;
 
 private:
-    typedef std::shared_ptr<hash_digest> hash_ptr;
-    typedef boost::optional<uint64_t> optional_value;
+    typedef std::shared_ptr<const sighash_context> sighash_ptr;
+
+    void reset_derived() const;
 
-    hash_ptr hash_cache() const;
-    optional_value total_input_value_cache() const;
-    optional_value total_output_value_cache() const;
+    void cache_hashes(const uint8_t* begin, const uint8_t* inputs,
+        const uint8_t* outputs_end, const uint8_t* locktime,
+        const uint8_t* end, bool marker, bool witness);
 
     uint32_t version_;
     uint32_t locktime_;
     input::list inputs_;
     output::list outputs_;
 
-    // These share a mutex as they are not expected to contend.
-    mutable hash_ptr hash_;
-    mutable hash_ptr witness_hash_;
-    mutable hash_ptr outputs_hash_;
-    mutable hash_ptr inpoints_hash_;
-    mutable hash_ptr sequences_hash_;
-    mutable upgrade_mutex hash_mutex_;
-
-    // These share a mutex as they are not expected to contend.
-    mutable optional_value total_input_value_;
-    mutable optional_value total_output_value_;
-    mutable boost::optional<bool> segregated_;
-    mutable upgrade_mutex mutex_;
+    // These are computed once and published without a lock.
+    mutable once_value<hash_digest> hash_;
+    mutable once_value<hash_digest> witness_hash_;
+    mutable once_value<hash_digest> outputs_hash_;
+    mutable once_value<hash_digest> inpoints_hash_;
+    mutable once_value<hash_digest> sequences_hash_;
+    mutable once_value<sighash_ptr> sighash_context_;
+    mutable once_value<uint64_t> total_input_value_;
+    mutable once_value<uint64_t> total_output_value_;
+    mutable once_value<bool> segregated_;
 };
 
 } // namespace chain
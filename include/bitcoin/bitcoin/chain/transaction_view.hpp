@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_TRANSACTION_VIEW_HPP
+#define LIBBITCOIN_CHAIN_TRANSACTION_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// A read-only index of field offsets into a wire serialized transaction.
+/// The view does not own the buffer, which must outlive the view. Points and
+/// scripts are decoded on demand and hashes are computed over the original
+/// byte ranges, without reserialization.
+class BC_API transaction_view
+{
+public:
+    typedef std::vector<transaction_view> list;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    transaction_view();
+
+    // Deserialization.
+    //-------------------------------------------------------------------------
+
+    /// Index the transaction at the front of the buffer, which may contain
+    /// trailing data (such as subsequent transactions of a block).
+    bool from_data(data_slice data);
+    bool is_valid() const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    /// The serialized byte range of the transaction, including witnesses.
+    data_slice data() const;
+    size_t serialized_size() const;
+    bool is_segregated() const;
+    bool is_coinbase() const;
+
+    uint32_t version() const;
+    uint32_t locktime() const;
+
+    size_t inputs() const;
+    output_point previous_output(size_t index) const;
+    script input_script(size_t index) const;
+    uint32_t sequence(size_t index) const;
+
+    size_t outputs() const;
+    uint64_t value(size_t index) const;
+    script output_script(size_t index) const;
+
+    /// The txid, or the wtxid if witness is set and the tx is segregated.
+    /// The wtxid of a segregated coinbase is null_hash (bip141).
+    hash_digest hash(bool witness=false) const;
+
+    /// Fully deserialize the transaction.
+    transaction to_transaction(bool witness=true) const;
+
+private:
+    struct input_offsets
+    {
+        size_t point;
+        size_t script;
+        size_t script_size;
+    };
+
+    struct output_offsets
+    {
+        size_t value;
+        size_t script;
+        size_t script_size;
+    };
+
+    void reset();
+    script to_script(size_t offset, size_t size) const;
+
+    data_slice data_;
+    bool segregated_;
+
+    // The stripped (txid) serialization omits marker, flag and witnesses.
+    size_t inputs_begin_;
+    size_t outputs_end_;
+    size_t locktime_;
+
+    std::vector<input_offsets> inputs_;
+    std::vector<output_offsets> outputs_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
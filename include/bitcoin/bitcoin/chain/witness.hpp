@@ -27,6 +27,7 @@
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/small_chunk.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
@@ -37,7 +38,7 @@ class BC_API witness
 {
 public:
     typedef machine::operation operation;
-    typedef data_stack::const_iterator iterator;
+    typedef small_stack::const_iterator iterator;
 
     // Constructors.
     //-------------------------------------------------------------------------
@@ -47,6 +48,8 @@ public:
     witness(witness&& other);
     witness(const witness& other);
 
+    witness(small_stack&& stack);
+    witness(const small_stack& stack);
     witness(data_stack&& stack);
     witness(const data_stack& stack);
 
@@ -94,27 +97,27 @@ public:
     void clear();
     bool empty() const;
     size_t size() const;
-    const data_chunk& front() const;
-    const data_chunk& back() const;
+    const small_chunk& front() const;
+    const small_chunk& back() const;
     iterator begin() const;
     iterator end() const;
-    const data_chunk& operator[](size_t index) const;
+    const small_chunk& operator[](size_t index) const;
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
 
     size_t serialized_size(bool prefix) const;
-    const data_stack& stack() const;
+    const small_stack& stack() const;
 
     // Utilities.
     //-------------------------------------------------------------------------
 
-    static bool is_push_size(const data_stack& stack);
-    static bool is_reserved_pattern(const data_stack& stack);
+    static bool is_push_size(const small_stack& stack);
+    static bool is_reserved_pattern(const small_stack& stack);
 
     bool extract_sigop_script(script& out_script,
         const script& program_script) const;
-    bool extract_embedded_script(script& out_script, data_stack& out_stack,
+    bool extract_embedded_script(script& out_script, small_stack& out_stack,
         const script& program_script) const;
 
     // Validation.
@@ -130,11 +133,11 @@ protected:
     void reset();
 
 private:
-    static size_t serialized_size(const data_stack& stack);
+    static size_t serialized_size(const small_stack& stack);
     static operation::list to_pay_key_hash(data_chunk&& program);
 
     bool valid_;
-    data_stack stack_;
+    small_stack stack_;
 };
 
 } // namespace chain
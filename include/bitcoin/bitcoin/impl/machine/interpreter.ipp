@@ -74,7 +74,7 @@ inline interpreter::result interpreter::op_push_size(program& program,
 }
 
 inline interpreter::result interpreter::op_push_data(program& program,
-    const data_chunk& data, uint32_t size_limit)
+    const small_chunk& data, uint32_t size_limit)
 {
     if (data.size() > size_limit)
         return error::op_push_data;
@@ -603,7 +603,7 @@ inline interpreter::result interpreter::op_ripemd160(program& program)
     if (program.empty())
         return error::op_ripemd160;
 
-    program.push_move(ripemd160_hash_chunk(program.pop()));
+    program.push_move(to_small_chunk(ripemd160_hash(program.pop())));
     return error::success;
 }
 
@@ -612,7 +612,7 @@ inline interpreter::result interpreter::op_sha1(program& program)
     if (program.empty())
         return error::op_sha1;
 
-    program.push_move(sha1_hash_chunk(program.pop()));
+    program.push_move(to_small_chunk(sha1_hash(program.pop())));
     return error::success;
 }
 
@@ -621,7 +621,7 @@ inline interpreter::result interpreter::op_sha256(program& program)
     if (program.empty())
         return error::op_sha256;
 
-    program.push_move(sha256_hash_chunk(program.pop()));
+    program.push_move(to_small_chunk(sha256_hash(program.pop())));
     return error::success;
 }
 
@@ -630,7 +630,7 @@ inline interpreter::result interpreter::op_hash160(program& program)
     if (program.empty())
         return error::op_hash160;
 
-    program.push_move(ripemd160_hash_chunk(sha256_hash(program.pop())));
+    program.push_move(to_small_chunk(bitcoin_short_hash(program.pop())));
     return error::success;
 }
 
@@ -639,7 +639,7 @@ inline interpreter::result interpreter::op_hash256(program& program)
     if (program.empty())
         return error::op_hash256;
 
-    program.push_move(sha256_hash_chunk(sha256_hash(program.pop())));
+    program.push_move(to_small_chunk(bitcoin_hash(program.pop())));
     return error::success;
 }
 
@@ -713,7 +713,7 @@ inline interpreter::result interpreter::op_check_multisig_verify(
     if (!program.increment_operation_count(key_count))
         return error::op_check_multisig_verify2;
 
-    data_stack public_keys;
+    small_stack public_keys;
     if (!program.pop(public_keys, key_count))
         return error::op_check_multisig_verify3;
 
@@ -724,7 +724,7 @@ inline interpreter::result interpreter::op_check_multisig_verify(
     if (signature_count < 0 || signature_count > key_count)
         return error::op_check_multisig_verify5;
 
-    data_stack endorsements;
+    small_stack endorsements;
     if (!program.pop(endorsements, signature_count))
         return error::op_check_multisig_verify6;
 
@@ -739,8 +739,10 @@ inline interpreter::result interpreter::op_check_multisig_verify(
         return error::op_check_multisig_verify8;
 
     uint8_t sighash;
+    hash_digest signature_hash;
     ec_signature signature;
     der_signature distinguished;
+    auto parsed = false;
     auto endorsement = endorsements.begin();
     auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
     auto bip143 = chain::script::is_enabled(program.forks(), bip143_rule);
@@ -763,16 +765,28 @@ inline interpreter::result interpreter::op_check_multisig_verify(
         if (endorsement->empty())
             continue;
 
-        // Parse endorsement into DER signature into an EC signature.
-        if (!parse_endorsement(sighash, distinguished, *endorsement) ||
-            !parse_signature(signature, distinguished, bip66))
-            return error::invalid_signature_encoding;
-
-        // Version condition preserves independence of bip141 and bip143.
-        if (chain::script::check_signature(signature, sighash, public_key,
-            script_code, program.transaction(), program.input_index(),
-            version, program.value()))
+        // Each endorsement is parsed and hashed once, when first tried.
+        if (!parsed)
+        {
+            // Parse endorsement into DER signature into an EC signature.
+            if (!parse_endorsement(sighash, distinguished, *endorsement) ||
+                !parse_signature(signature, distinguished, bip66))
+                return error::invalid_signature_encoding;
+
+            // Version condition preserves independence of bip141 and bip143.
+            signature_hash = chain::script::generate_signature_hash(
+                program.transaction(), program.input_index(), script_code,
+                sighash, version, program.value());
+
+            parsed = true;
+        }
+
+        if (chain::script::check_signature(signature, signature_hash,
+            public_key))
+        {
             ++endorsement;
+            parsed = false;
+        }
     }
 
     return endorsement == endorsements.end() ? error::success :
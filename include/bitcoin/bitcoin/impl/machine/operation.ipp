@@ -51,7 +51,7 @@ inline operation::operation(const operation& other)
 {
 }
 
-inline operation::operation(data_chunk&& uncoded, bool minimal)
+inline operation::operation(small_chunk&& uncoded, bool minimal)
   : code_(opcode_from_data(uncoded, minimal)),
     data_(std::move(uncoded)),
     valid_(!is_oversized())
@@ -67,7 +67,7 @@ inline operation::operation(data_chunk&& uncoded, bool minimal)
     }
 }
 
-inline operation::operation(const data_chunk& uncoded, bool minimal)
+inline operation::operation(const small_chunk& uncoded, bool minimal)
   : code_(opcode_from_data(uncoded, minimal)),
     data_(uncoded),
     valid_(!is_oversized())
@@ -89,13 +89,14 @@ inline operation::operation(opcode code)
 }
 
 // protected
-inline operation::operation(opcode code, data_chunk&& data, bool valid)
+inline operation::operation(opcode code, small_chunk&& data, bool valid)
   : code_(code), data_(std::move(data)), valid_(valid)
 {
 }
 
 // protected
-inline operation::operation(opcode code, const data_chunk& data, bool valid)
+inline operation::operation(opcode code, const small_chunk& data,
+    bool valid)
   : code_(code), data_(data), valid_(valid)
 {
 }
@@ -155,7 +156,7 @@ inline opcode operation::code() const
     return code_;
 }
 
-inline const data_chunk& operation::data() const
+inline const small_chunk& operation::data() const
 {
     return data_;
 }
@@ -206,13 +207,13 @@ inline opcode operation::opcode_from_size(size_t size)
         return opcode::push_four_size;
 }
 
-inline opcode operation::minimal_opcode_from_data(const data_chunk& data)
+inline opcode operation::minimal_opcode_from_data(data_slice data)
 {
     const auto size = data.size();
 
     if (size == 1)
     {
-        const auto value = data.front();
+        const auto value = *data.begin();
 
         if (value == number::negative_1)
             return opcode::push_negative_1;
@@ -228,13 +229,12 @@ inline opcode operation::minimal_opcode_from_data(const data_chunk& data)
     return opcode_from_size(size);
 }
 
-inline opcode operation::nominal_opcode_from_data(const data_chunk& data)
+inline opcode operation::nominal_opcode_from_data(data_slice data)
 {
     return opcode_from_size(data.size());
 }
 
-inline opcode operation::opcode_from_data(const data_chunk& data,
-    bool minimal)
+inline opcode operation::opcode_from_data(data_slice data, bool minimal)
 {
     return minimal ? minimal_opcode_from_data(data) :
         nominal_opcode_from_data(data);
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
@@ -30,6 +31,7 @@
 #include <bitcoin/bitcoin/machine/script_version.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/small_chunk.hpp>
 
 namespace libbitcoin {
 namespace machine {
@@ -171,10 +173,10 @@ inline void program::push_copy(const value_type& item)
 //-----------------------------------------------------------------------------
 
 // This must be guarded.
-inline data_chunk program::pop()
+inline program::value_type program::pop()
 {
     BITCOIN_ASSERT(!empty());
-    const auto value = primary_.back();
+    auto value = std::move(primary_.back());
     primary_.pop_back();
     return value;
 }
@@ -228,7 +230,7 @@ inline bool program::pop_position(stack_iterator& out_position)
 }
 
 // pop1/pop2/.../pop[count]
-inline bool program::pop(data_stack& section, size_t count)
+inline bool program::pop(small_stack& section, size_t count)
 {
     if (size() < count)
         return false;
@@ -253,8 +255,8 @@ inline void program::swap(size_t index_left, size_t index_right)
 {
     // TODO: refactor to allow DRY without const_cast here.
     std::swap(
-        const_cast<data_stack::value_type&>(item(index_left)),
-        const_cast<data_stack::value_type&>(item(index_right)));
+        const_cast<value_type&>(item(index_left)),
+        const_cast<value_type&>(item(index_right)));
 }
 
 // pop1/pop2/.../pop[pos-1]/pop[pos]/push[pos-1]/.../push2/push1
@@ -320,7 +322,7 @@ inline bool program::if_(const operation& op) const
     return op.is_conditional() || succeeded();
 }
 
-inline const data_stack::value_type& program::item(size_t index) /*const*/
+inline const program::value_type& program::item(size_t index) /*const*/
 {
     return *position(index);
 }
@@ -370,7 +372,7 @@ inline void program::push_alternate(value_type&& value)
 inline program::value_type program::pop_alternate()
 {
     BITCOIN_ASSERT(!alternate_.empty());
-    const auto value = alternate_.back();
+    auto value = std::move(alternate_.back());
     alternate_.pop_back();
     return value;
 }
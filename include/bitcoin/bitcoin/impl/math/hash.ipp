@@ -21,7 +21,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 
 namespace libbitcoin {
 
@@ -33,6 +35,38 @@ byte_array<Size> scrypt(data_slice data, data_slice salt, uint64_t N,
     return to_array<Size>({ out });
 }
 
+// The murmur3 64 bit finalizer, applied to the salted value so that the salt
+// changes bucket selection (an xor of the salt alone would preserve it).
+inline size_t salted_mix(uint64_t value)
+{
+    value += hash_salt();
+    value = (value ^ (value >> 33)) * 0xff51afd7ed558ccd;
+    value = (value ^ (value >> 33)) * 0xc4ceb9fe1a85ec53;
+    return static_cast<size_t>(value ^ (value >> 33));
+}
+
+template <size_t Size>
+size_t salted_hash(const byte_array<Size>& hash)
+{
+    static_assert(Size >= sizeof(uint64_t), "digest too small");
+
+    // Use the middle of the digest, as block hashes are zero at one end.
+    static BC_CONSTEXPR size_t offset = (Size - sizeof(uint64_t)) / 2;
+    return salted_mix(from_little_endian_unsafe<uint64_t>(
+        hash.begin() + offset));
+}
+
+inline size_t salted_hash(const hash_digest& hash, uint32_t index)
+{
+    // Spread the index over the word so that adjacent indexes differ widely.
+    static BC_CONSTEXPR uint64_t golden = 0x9e3779b97f4a7c15;
+    static BC_CONSTEXPR size_t offset = (hash_size - sizeof(uint64_t)) / 2;
+    const auto word = from_little_endian_unsafe<uint64_t>(
+        hash.begin() + offset);
+
+    return salted_mix(word ^ (index * golden));
+}
+
 } // namespace libbitcoin
 
 #endif
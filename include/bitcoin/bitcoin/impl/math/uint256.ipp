@@ -0,0 +1,320 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_UINT256_IPP
+#define LIBBITCOIN_UINT256_IPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+BC_CONSTFUNC uint256_t::uint256_t(uint64_t value)
+  : words_{ value, 0, 0, 0 }
+{
+}
+
+BC_CONSTFUNC uint256_t::uint256_t(uint64_t word0, uint64_t word1,
+    uint64_t word2, uint64_t word3)
+  : words_{ word0, word1, word2, word3 }
+{
+}
+
+inline uint256_t::uint256_t(const hash_type& hash)
+  : words_
+    {
+        from_little_endian_unsafe<uint64_t>(hash.begin()),
+        from_little_endian_unsafe<uint64_t>(hash.begin() + 8),
+        from_little_endian_unsafe<uint64_t>(hash.begin() + 16),
+        from_little_endian_unsafe<uint64_t>(hash.begin() + 24)
+    }
+{
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+BC_CONSTFUNC uint64_t uint256_t::operator[](size_t index) const
+{
+    return words_[index];
+}
+
+inline uint256_t::operator uint64_t() const
+{
+    return words_[0];
+}
+
+inline int uint256_t::compare(const uint256_t& other) const
+{
+    // Most significant word first, the common case resolves on the first.
+    for (auto index = words; index > 0; --index)
+        if (words_[index - 1] != other.words_[index - 1])
+            return words_[index - 1] < other.words_[index - 1] ? -1 : 1;
+
+    return 0;
+}
+
+// Unary operators.
+//-----------------------------------------------------------------------------
+
+inline uint256_t uint256_t::operator~() const
+{
+    return { ~words_[0], ~words_[1], ~words_[2], ~words_[3] };
+}
+
+inline uint256_t uint256_t::operator-() const
+{
+    auto out = ~(*this);
+    return ++out;
+}
+
+inline uint256_t& uint256_t::operator++()
+{
+    for (size_t index = 0; index < words; ++index)
+        if (++words_[index] != 0)
+            break;
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator--()
+{
+    for (size_t index = 0; index < words; ++index)
+        if (words_[index]-- != 0)
+            break;
+
+    return *this;
+}
+
+// Assignment operators.
+//-----------------------------------------------------------------------------
+
+inline uint256_t& uint256_t::operator>>=(uint32_t shift)
+{
+    const size_t offset = shift / 64;
+    const auto bits = shift % 64;
+
+    for (size_t index = 0; index < words; ++index)
+    {
+        const auto low = index + offset;
+        const auto high = low + 1;
+        const auto word = low < words ? words_[low] : 0;
+        const auto next = high < words ? words_[high] : 0;
+        words_[index] = bits == 0 ? word :
+            (word >> bits) | (next << (64 - bits));
+    }
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator<<=(uint32_t shift)
+{
+    const size_t offset = shift / 64;
+    const auto bits = shift % 64;
+
+    for (auto index = words; index > 0; --index)
+    {
+        const auto high = index - 1;
+        const auto word = high >= offset ? words_[high - offset] : 0;
+        const auto next = high > offset ? words_[high - offset - 1] : 0;
+        words_[high] = bits == 0 ? word :
+            (word << bits) | (next >> (64 - bits));
+    }
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator&=(const uint256_t& other)
+{
+    for (size_t index = 0; index < words; ++index)
+        words_[index] &= other.words_[index];
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator|=(const uint256_t& other)
+{
+    for (size_t index = 0; index < words; ++index)
+        words_[index] |= other.words_[index];
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator^=(const uint256_t& other)
+{
+    for (size_t index = 0; index < words; ++index)
+        words_[index] ^= other.words_[index];
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator+=(const uint256_t& other)
+{
+    uint64_t carry = 0;
+
+    for (size_t index = 0; index < words; ++index)
+    {
+        const auto left = words_[index];
+        const auto sum = left + other.words_[index];
+        const auto total = sum + carry;
+        carry = (sum < left ? 1 : 0) + (total < sum ? 1 : 0);
+        words_[index] = total;
+    }
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator-=(const uint256_t& other)
+{
+    uint64_t borrow = 0;
+
+    for (size_t index = 0; index < words; ++index)
+    {
+        const auto left = words_[index];
+        const auto right = other.words_[index];
+        const auto difference = left - right;
+        const auto total = difference - borrow;
+        borrow = (left < right ? 1 : 0) + (difference < borrow ? 1 : 0);
+        words_[index] = total;
+    }
+
+    return *this;
+}
+
+inline uint256_t& uint256_t::operator*=(uint32_t value)
+{
+    static BC_CONSTEXPR uint64_t mask = 0xffffffff;
+    uint64_t carry = 0;
+
+    // Multiply by 32 bit halves so that no product exceeds 64 bits.
+    for (size_t index = 0; index < words; ++index)
+    {
+        const auto word = words_[index];
+        const auto low = (word & mask) * value + carry;
+        const auto high = (word >> 32) * value + (low >> 32);
+        words_[index] = (high << 32) | (low & mask);
+        carry = high >> 32;
+    }
+
+    return *this;
+}
+
+// Comparison operators.
+//-----------------------------------------------------------------------------
+
+inline bool operator==(const uint256_t& left, const uint256_t& right)
+{
+    return left[0] == right[0] && left[1] == right[1] &&
+        left[2] == right[2] && left[3] == right[3];
+}
+
+inline bool operator!=(const uint256_t& left, const uint256_t& right)
+{
+    return !(left == right);
+}
+
+inline bool operator<(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) < 0;
+}
+
+inline bool operator>(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) > 0;
+}
+
+inline bool operator<=(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) <= 0;
+}
+
+inline bool operator>=(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) >= 0;
+}
+
+// Binary operators.
+//-----------------------------------------------------------------------------
+
+inline uint256_t operator>>(const uint256_t& left, uint32_t shift)
+{
+    auto out = left;
+    return out >>= shift;
+}
+
+inline uint256_t operator<<(const uint256_t& left, uint32_t shift)
+{
+    auto out = left;
+    return out <<= shift;
+}
+
+inline uint256_t operator&(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out &= right;
+}
+
+inline uint256_t operator|(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out |= right;
+}
+
+inline uint256_t operator^(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out ^= right;
+}
+
+inline uint256_t operator+(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out += right;
+}
+
+inline uint256_t operator-(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out -= right;
+}
+
+inline uint256_t operator*(const uint256_t& left, uint32_t right)
+{
+    auto out = left;
+    return out *= right;
+}
+
+inline uint256_t operator/(const uint256_t& left, uint32_t right)
+{
+    auto out = left;
+    return out /= right;
+}
+
+inline uint256_t operator/(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out /= right;
+}
+
+} // namespace libbitcoin
+
+#endif
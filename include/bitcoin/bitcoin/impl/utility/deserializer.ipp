@@ -73,6 +73,12 @@ void deserializer<Iterator, CheckSafe>::invalidate()
     valid_ = false;
 }
 
+template <typename Iterator, bool CheckSafe>
+const uint8_t* deserializer<Iterator, CheckSafe>::position() const
+{
+    return valid_ ? address(iterator_) : nullptr;
+}
+
 // Objects.
 //-----------------------------------------------------------------------------
 
@@ -396,6 +402,26 @@ size_t deserializer<Iterator, CheckSafe>::remaining() const
     return std::distance(iterator_, end_);
 }
 
+template <typename Iterator, bool CheckSafe>
+const uint8_t* deserializer<Iterator, CheckSafe>::address(
+    const uint8_t* iterator)
+{
+    return iterator;
+}
+
+template <typename Iterator, bool CheckSafe>
+const uint8_t* deserializer<Iterator, CheckSafe>::address(uint8_t* iterator)
+{
+    return iterator;
+}
+
+template <typename Iterator, bool CheckSafe>
+template <typename Other>
+const uint8_t* deserializer<Iterator, CheckSafe>::address(const Other&)
+{
+    return nullptr;
+}
+
 // Factories.
 //-----------------------------------------------------------------------------
 
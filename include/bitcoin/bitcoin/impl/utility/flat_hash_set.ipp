@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_FLAT_HASH_SET_IPP
+#define LIBBITCOIN_FLAT_HASH_SET_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libbitcoin {
+
+// The table is at most half full, so probe sequences remain short.
+template <typename Key, typename Hasher>
+flat_hash_set<Key, Hasher>::flat_hash_set(size_t capacity, Hasher hasher)
+  : hasher_(hasher),
+    capacity_(capacity),
+    mask_((size_t(1) << slot_bits(capacity)) - 1),
+    shift_(64 - slot_bits(capacity)),
+    size_(0),
+    slots_(mask_ + 1, slot{ 0, nullptr })
+{
+}
+
+template <typename Key, typename Hasher>
+size_t flat_hash_set<Key, Hasher>::size() const
+{
+    return size_;
+}
+
+template <typename Key, typename Hasher>
+bool flat_hash_set<Key, Hasher>::contains(const Key& key) const
+{
+    return slots_[find(key, hasher_(key))].key != nullptr;
+}
+
+template <typename Key, typename Hasher>
+bool flat_hash_set<Key, Hasher>::insert(const Key& key)
+{
+    const uint64_t hash = hasher_(key);
+    auto position = find(key, hash);
+
+    if (slots_[position].key != nullptr)
+        return false;
+
+    // Without growth a full table would leave no empty slot to end a probe.
+    if (size_ == capacity_)
+    {
+        grow();
+        position = find(key, hash);
+    }
+
+    slots_[position] = { hash, &key };
+    ++size_;
+    return true;
+}
+
+template <typename Key, typename Hasher>
+void flat_hash_set<Key, Hasher>::clear()
+{
+    std::fill(slots_.begin(), slots_.end(), slot{ 0, nullptr });
+    size_ = 0;
+}
+
+// private
+//-----------------------------------------------------------------------------
+
+// The smallest power of two (at least two) of no less than twice capacity.
+template <typename Key, typename Hasher>
+uint8_t flat_hash_set<Key, Hasher>::slot_bits(size_t capacity)
+{
+    uint8_t bits = 1;
+
+    while ((size_t(1) << bits) < 2 * capacity)
+        ++bits;
+
+    return bits;
+}
+
+// Returns the position of the equal key or of the empty slot ending its probe.
+template <typename Key, typename Hasher>
+size_t flat_hash_set<Key, Hasher>::find(const Key& key, uint64_t hash) const
+{
+    // Fibonacci hashing takes the high bits, as a checksum may vary only in
+    // its low bits (the point index) or only in its high bits (the tx hash).
+    static const uint64_t golden = 0x9e3779b97f4a7c15;
+    auto position = static_cast<size_t>((hash * golden) >> shift_);
+
+    while (slots_[position].key != nullptr)
+    {
+        const auto& slot = slots_[position];
+
+        if (slot.hash == hash && *slot.key == key)
+            break;
+
+        position = (position + 1) & mask_;
+    }
+
+    return position;
+}
+
+// Doubles the capacity, reinserting each key by its retained hash.
+template <typename Key, typename Hasher>
+void flat_hash_set<Key, Hasher>::grow()
+{
+    capacity_ = std::max(size_t(1), 2 * capacity_);
+    mask_ = (size_t(1) << slot_bits(capacity_)) - 1;
+    shift_ = 64 - slot_bits(capacity_);
+
+    std::vector<slot> slots(mask_ + 1, slot{ 0, nullptr });
+    slots_.swap(slots);
+
+    for (const auto& slot: slots)
+        if (slot.key != nullptr)
+            slots_[find(*slot.key, slot.hash)] = slot;
+}
+
+} // namespace libbitcoin
+
+#endif
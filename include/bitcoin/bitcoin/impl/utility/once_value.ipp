@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_ONCE_VALUE_IPP
+#define LIBBITCOIN_ONCE_VALUE_IPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace libbitcoin {
+
+template <typename Type>
+once_value<Type>::once_value()
+  : state_(empty_), value_{}
+{
+}
+
+template <typename Type>
+once_value<Type>::once_value(const Type& value)
+  : state_(ready_), value_(value)
+{
+}
+
+template <typename Type>
+once_value<Type>::once_value(Type&& value)
+  : state_(ready_), value_(std::move(value))
+{
+}
+
+template <typename Type>
+once_value<Type>::once_value(const once_value& other)
+  : state_(empty_), value_{}
+{
+    *this = other;
+}
+
+template <typename Type>
+once_value<Type>::once_value(once_value&& other)
+  : state_(empty_), value_{}
+{
+    *this = std::move(other);
+}
+
+template <typename Type>
+once_value<Type>& once_value<Type>::operator=(const once_value& other)
+{
+    if (this == &other)
+        return *this;
+
+    if (other.empty())
+        reset();
+    else
+        set(other.value_);
+
+    return *this;
+}
+
+template <typename Type>
+once_value<Type>& once_value<Type>::operator=(once_value&& other)
+{
+    if (this == &other)
+        return *this;
+
+    if (other.empty())
+        reset();
+    else
+        set(std::move(other.value_));
+
+    other.reset();
+    return *this;
+}
+
+template <typename Type>
+bool once_value<Type>::empty() const
+{
+    return state_.load(std::memory_order_acquire) != ready_;
+}
+
+template <typename Type>
+template <typename Factory>
+const Type& once_value<Type>::get(Factory factory) const
+{
+    if (state_.load(std::memory_order_acquire) == ready_)
+        return value_;
+
+    auto state = empty_;
+
+    // The winner computes and publishes the value.
+    if (state_.compare_exchange_strong(state, busy_,
+        std::memory_order_acquire))
+    {
+        try
+        {
+            value_ = factory();
+        }
+        catch (...)
+        {
+            state_.store(empty_, std::memory_order_release);
+            throw;
+        }
+
+        state_.store(ready_, std::memory_order_release);
+        return value_;
+    }
+
+    // Others wait for publication, or retry if the winner threw.
+    while ((state = state_.load(std::memory_order_acquire)) != ready_)
+    {
+        if (state == empty_)
+            return get(factory);
+
+        std::this_thread::yield();
+    }
+
+    return value_;
+}
+
+template <typename Type>
+void once_value<Type>::set(const Type& value)
+{
+    value_ = value;
+    state_.store(ready_, std::memory_order_release);
+}
+
+template <typename Type>
+void once_value<Type>::set(Type&& value)
+{
+    value_ = std::move(value);
+    state_.store(ready_, std::memory_order_release);
+}
+
+template <typename Type>
+void once_value<Type>::reset()
+{
+    state_.store(empty_, std::memory_order_release);
+    value_ = Type{};
+}
+
+} // namespace libbitcoin
+
+#endif
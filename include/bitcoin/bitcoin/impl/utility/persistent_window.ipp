@@ -0,0 +1,385 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PERSISTENT_WINDOW_IPP
+#define LIBBITCOIN_PERSISTENT_WINDOW_IPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+
+namespace libbitcoin {
+
+template <typename Type>
+const size_t persistent_window<Type>::growth_factor = 4;
+
+template <typename Type>
+const size_t persistent_window<Type>::minimum_capacity = 16;
+
+template <typename Type>
+persistent_window<Type>::buffer::buffer(size_t capacity)
+  : capacity(capacity), values(new Type[capacity]), claimed(0)
+{
+}
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+template <typename Type>
+persistent_window<Type>::persistent_window()
+  : begin_(0), end_(0)
+{
+}
+
+template <typename Type>
+persistent_window<Type>::persistent_window(std::initializer_list<Type> values)
+  : persistent_window(values.begin(), values.end())
+{
+}
+
+template <typename Type>
+persistent_window<Type>::persistent_window(size_t size, const Type& value)
+  : persistent_window()
+{
+    resize(size, value);
+}
+
+template <typename Type>
+template <typename Iterator, typename>
+persistent_window<Type>::persistent_window(Iterator begin, Iterator end)
+  : persistent_window()
+{
+    for (auto it = begin; it != end; ++it)
+        push_back(*it);
+}
+
+template <typename Type>
+persistent_window<Type>::persistent_window(const persistent_window& other)
+  : buffer_(other.buffer_), begin_(other.begin_), end_(other.end_)
+{
+}
+
+template <typename Type>
+persistent_window<Type>::persistent_window(persistent_window&& other)
+  : buffer_(std::move(other.buffer_)), begin_(other.begin_), end_(other.end_)
+{
+    other.begin_ = 0;
+    other.end_ = 0;
+}
+
+template <typename Type>
+persistent_window<Type>& persistent_window<Type>::operator=(
+    const persistent_window& other)
+{
+    buffer_ = other.buffer_;
+    begin_ = other.begin_;
+    end_ = other.end_;
+    return *this;
+}
+
+template <typename Type>
+persistent_window<Type>& persistent_window<Type>::operator=(
+    persistent_window&& other)
+{
+    if (this == &other)
+        return *this;
+
+    buffer_ = std::move(other.buffer_);
+    begin_ = other.begin_;
+    end_ = other.end_;
+    other.buffer_.reset();
+    other.begin_ = 0;
+    other.end_ = 0;
+    return *this;
+}
+
+// Element access.
+//-----------------------------------------------------------------------------
+
+template <typename Type>
+Type& persistent_window<Type>::operator[](size_t index)
+{
+    BITCOIN_ASSERT(index < size());
+    return begin()[index];
+}
+
+template <typename Type>
+Type& persistent_window<Type>::front()
+{
+    BITCOIN_ASSERT(!empty());
+    return *begin();
+}
+
+template <typename Type>
+Type& persistent_window<Type>::back()
+{
+    BITCOIN_ASSERT(!empty());
+    return *(end() - 1);
+}
+
+template <typename Type>
+const Type& persistent_window<Type>::operator[](size_t index) const
+{
+    BITCOIN_ASSERT(index < size());
+    return begin()[index];
+}
+
+template <typename Type>
+const Type& persistent_window<Type>::front() const
+{
+    BITCOIN_ASSERT(!empty());
+    return *begin();
+}
+
+template <typename Type>
+const Type& persistent_window<Type>::back() const
+{
+    BITCOIN_ASSERT(!empty());
+    return *(end() - 1);
+}
+
+// Iterators.
+//-----------------------------------------------------------------------------
+
+// Both ends detach as argument evaluation order is unspecified.
+template <typename Type>
+typename persistent_window<Type>::iterator persistent_window<Type>::begin()
+{
+    detach();
+    return buffer_ ? buffer_->values.get() + begin_ : nullptr;
+}
+
+template <typename Type>
+typename persistent_window<Type>::iterator persistent_window<Type>::end()
+{
+    detach();
+    return buffer_ ? buffer_->values.get() + end_ : nullptr;
+}
+
+template <typename Type>
+typename persistent_window<Type>::reverse_iterator
+persistent_window<Type>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename Type>
+typename persistent_window<Type>::reverse_iterator
+persistent_window<Type>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_iterator
+persistent_window<Type>::begin() const
+{
+    return buffer_ ? buffer_->values.get() + begin_ : nullptr;
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_iterator
+persistent_window<Type>::end() const
+{
+    return buffer_ ? buffer_->values.get() + end_ : nullptr;
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_iterator
+persistent_window<Type>::cbegin() const
+{
+    return begin();
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_iterator
+persistent_window<Type>::cend() const
+{
+    return end();
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_reverse_iterator
+persistent_window<Type>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_reverse_iterator
+persistent_window<Type>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_reverse_iterator
+persistent_window<Type>::crbegin() const
+{
+    return rbegin();
+}
+
+template <typename Type>
+typename persistent_window<Type>::const_reverse_iterator
+persistent_window<Type>::crend() const
+{
+    return rend();
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+template <typename Type>
+size_t persistent_window<Type>::size() const
+{
+    return end_ - begin_;
+}
+
+template <typename Type>
+bool persistent_window<Type>::empty() const
+{
+    return end_ == begin_;
+}
+
+template <typename Type>
+bool persistent_window<Type>::is_shared() const
+{
+    return buffer_ && buffer_.use_count() > 1;
+}
+
+// Modifiers.
+//-----------------------------------------------------------------------------
+
+template <typename Type>
+void persistent_window<Type>::push_back(const Type& value)
+{
+    // The value may reference an element of this window, which may move.
+    const Type copy(value);
+
+    if (!claim())
+    {
+        relocate(size() + 1u);
+        buffer_->claimed.store(end_ + 1u);
+    }
+
+    buffer_->values[end_++] = copy;
+}
+
+template <typename Type>
+void persistent_window<Type>::pop_front()
+{
+    BITCOIN_ASSERT(!empty());
+    ++begin_;
+}
+
+template <typename Type>
+void persistent_window<Type>::pop_back()
+{
+    BITCOIN_ASSERT(!empty());
+    --end_;
+}
+
+template <typename Type>
+void persistent_window<Type>::resize(size_t size, const Type& value)
+{
+    if (size <= this->size())
+    {
+        end_ = begin_ + size;
+        return;
+    }
+
+    const Type copy(value);
+
+    while (this->size() < size)
+        push_back(copy);
+}
+
+template <typename Type>
+void persistent_window<Type>::clear()
+{
+    buffer_.reset();
+    begin_ = 0;
+    end_ = 0;
+}
+
+// Utilities.
+//-----------------------------------------------------------------------------
+
+// Claim the slot following this window, false if it must be relocated.
+template <typename Type>
+bool persistent_window<Type>::claim()
+{
+    if (!buffer_ || end_ == buffer_->capacity)
+        return false;
+
+    // A sole owner may reclaim slots abandoned by pop_back or resize.
+    if (!is_shared())
+    {
+        buffer_->claimed.store(end_ + 1u);
+        return true;
+    }
+
+    // Only the first of the windows ending at this slot may extend into it.
+    auto expected = end_;
+    return buffer_->claimed.compare_exchange_strong(expected, end_ + 1u);
+}
+
+template <typename Type>
+void persistent_window<Type>::detach()
+{
+    if (is_shared())
+        relocate(size());
+}
+
+// Move the window to the front of a new buffer with space to advance.
+template <typename Type>
+void persistent_window<Type>::relocate(size_t reserve)
+{
+    const auto count = size();
+    const auto capacity = std::max(growth_factor * reserve, minimum_capacity);
+    const auto replacement = std::make_shared<buffer>(capacity);
+    const auto from = static_cast<const persistent_window&>(*this).begin();
+    std::copy(from, from + count, replacement->values.get());
+    replacement->claimed.store(count);
+    buffer_ = replacement;
+    begin_ = 0;
+    end_ = count;
+}
+
+template <typename Type>
+bool operator==(const persistent_window<Type>& left,
+    const persistent_window<Type>& right)
+{
+    return left.size() == right.size() &&
+        std::equal(left.begin(), left.end(), right.begin());
+}
+
+template <typename Type>
+bool operator!=(const persistent_window<Type>& left,
+    const persistent_window<Type>& right)
+{
+    return !(left == right);
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
@@ -31,7 +32,14 @@ namespace libbitcoin {
 
 template <typename Iterator>
 serializer<Iterator>::serializer(const Iterator begin)
-  : valid_(true), iterator_(begin)
+  : valid_(true), iterator_(begin), remaining_(max_size_t)
+{
+}
+
+template <typename Iterator>
+serializer<Iterator>::serializer(const Iterator begin, const Iterator end)
+  : valid_(true), iterator_(begin),
+    remaining_(static_cast<size_t>(std::distance(begin, end)))
 {
 }
 
@@ -179,13 +187,14 @@ void serializer<Iterator>::write_size_little_endian(size_t value)
     write_variable_little_endian(value);
 }
 
-// Bytes (unchecked).
+// Bytes (bounded only by a safe serializer).
 //-----------------------------------------------------------------------------
 
 template <typename Iterator>
 void serializer<Iterator>::write_byte(uint8_t value)
 {
-    *iterator_++ = value;
+    if (claim(1))
+        *iterator_++ = value;
 }
 
 template <typename Iterator>
@@ -197,7 +206,8 @@ void serializer<Iterator>::write_bytes(const data_slice data)
 template <typename Iterator>
 void serializer<Iterator>::write_bytes(const uint8_t* data, size_t size)
 {
-    iterator_ = std::copy_n(data, size, iterator_);
+    if (claim(size))
+        iterator_ = std::copy_n(data, size, iterator_);
 }
 
 template <typename Iterator>
@@ -219,7 +229,8 @@ void serializer<Iterator>::write_string(const std::string& value, size_t size)
 template <typename Iterator>
 void serializer<Iterator>::skip(size_t size)
 {
-    iterator_ += size;
+    if (claim(size))
+        iterator_ += size;
 }
 
 // non-interface
@@ -231,18 +242,26 @@ void serializer<Iterator>::write_delegated(functor write)
     write(*this);
 }
 
+template <typename Iterator>
+Iterator serializer<Iterator>::position() const
+{
+    return iterator_;
+}
+
 template <typename Iterator>
 template <typename Tuple>
 void serializer<Iterator>::write_forward(const Tuple& data)
 {
-    iterator_ = std::copy(data.begin(), data.end(), iterator_);
+    if (claim(data.size()))
+        iterator_ = std::copy(data.begin(), data.end(), iterator_);
 }
 
 template <typename Iterator>
 template <typename Tuple>
 void serializer<Iterator>::write_reverse(const Tuple& data)
 {
-    iterator_ = std::reverse_copy(data.begin(), data.end(), iterator_);
+    if (claim(data.size()))
+        iterator_ = std::reverse_copy(data.begin(), data.end(), iterator_);
 }
 
 template <typename Iterator>
@@ -259,6 +278,21 @@ void serializer<Iterator>::write_little_endian(Integer value)
     return write_forward(to_little_endian(value));
 }
 
+// The unsafe serializer starts with the maximum size, so it is never exhausted.
+template <typename Iterator>
+bool serializer<Iterator>::claim(size_t size)
+{
+    if (size <= remaining_)
+    {
+        remaining_ -= size;
+        return true;
+    }
+
+    remaining_ = 0;
+    valid_ = false;
+    return false;
+}
+
 template <typename Iterator>
 size_t serializer<Iterator>::read_size_big_endian()
 {
@@ -326,6 +360,12 @@ size_t serializer<Iterator>::read_size_little_endian()
 // Factories.
 //-----------------------------------------------------------------------------
 
+template <typename Iterator>
+serializer<Iterator> make_safe_serializer(Iterator begin, Iterator end)
+{
+    return serializer<Iterator>(begin, end);
+}
+
 template <typename Iterator>
 serializer<Iterator> make_unsafe_serializer(Iterator begin)
 {
@@ -0,0 +1,506 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SMALL_CHUNK_IPP
+#define LIBBITCOIN_SMALL_CHUNK_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <utility>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+inline small_chunk::small_chunk()
+  : begin_(buffer_), size_(0), capacity_(inline_capacity)
+{
+}
+
+inline small_chunk::small_chunk(small_chunk&& other) BC_NOEXCEPT
+  : small_chunk()
+{
+    *this = std::move(other);
+}
+
+inline small_chunk::small_chunk(const small_chunk& other)
+  : small_chunk(other.begin(), other.end())
+{
+}
+
+inline small_chunk::small_chunk(const data_chunk& other)
+  : small_chunk(other.data(), other.data() + other.size())
+{
+}
+
+inline small_chunk::small_chunk(std::initializer_list<uint8_t> values)
+  : small_chunk(values.begin(), values.end())
+{
+}
+
+inline small_chunk::small_chunk(size_t size, uint8_t value)
+  : small_chunk()
+{
+    assign(size, value);
+}
+
+inline small_chunk::small_chunk(const uint8_t* begin, const uint8_t* end)
+  : small_chunk()
+{
+    assign(begin, end);
+}
+
+template <typename Iterator, typename>
+small_chunk::small_chunk(Iterator begin, Iterator end)
+  : small_chunk()
+{
+    assign(begin, end);
+}
+
+inline small_chunk::~small_chunk()
+{
+    release();
+}
+
+// Operators.
+//-----------------------------------------------------------------------------
+
+inline small_chunk& small_chunk::operator=(small_chunk&& other) BC_NOEXCEPT
+{
+    if (this == &other)
+        return *this;
+
+    release();
+
+    if (other.is_inline())
+    {
+        std::memcpy(buffer_, other.buffer_, other.size_);
+        begin_ = buffer_;
+        capacity_ = inline_capacity;
+    }
+    else
+    {
+        // Take the heap allocation, leaving the source empty and inline.
+        begin_ = other.begin_;
+        capacity_ = other.capacity_;
+        other.begin_ = other.buffer_;
+        other.capacity_ = inline_capacity;
+    }
+
+    size_ = other.size_;
+    other.size_ = 0;
+    return *this;
+}
+
+inline small_chunk& small_chunk::operator=(const small_chunk& other)
+{
+    if (this != &other)
+        assign(other.begin(), other.end());
+
+    return *this;
+}
+
+inline small_chunk& small_chunk::operator=(const data_chunk& other)
+{
+    assign(other.data(), other.data() + other.size());
+    return *this;
+}
+
+inline small_chunk& small_chunk::operator=(
+    std::initializer_list<uint8_t> values)
+{
+    assign(values.begin(), values.end());
+    return *this;
+}
+
+inline uint8_t& small_chunk::operator[](size_t index)
+{
+    BITCOIN_ASSERT(index < size_);
+    return begin_[index];
+}
+
+inline const uint8_t& small_chunk::operator[](size_t index) const
+{
+    BITCOIN_ASSERT(index < size_);
+    return begin_[index];
+}
+
+// Iterators.
+//-----------------------------------------------------------------------------
+
+inline small_chunk::iterator small_chunk::begin()
+{
+    return begin_;
+}
+
+inline small_chunk::const_iterator small_chunk::begin() const
+{
+    return begin_;
+}
+
+inline small_chunk::const_iterator small_chunk::cbegin() const
+{
+    return begin_;
+}
+
+inline small_chunk::iterator small_chunk::end()
+{
+    return begin_ + size_;
+}
+
+inline small_chunk::const_iterator small_chunk::end() const
+{
+    return begin_ + size_;
+}
+
+inline small_chunk::const_iterator small_chunk::cend() const
+{
+    return begin_ + size_;
+}
+
+inline small_chunk::reverse_iterator small_chunk::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+inline small_chunk::const_reverse_iterator small_chunk::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+inline small_chunk::reverse_iterator small_chunk::rend()
+{
+    return reverse_iterator(begin());
+}
+
+inline small_chunk::const_reverse_iterator small_chunk::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+inline uint8_t* small_chunk::data()
+{
+    return begin_;
+}
+
+inline const uint8_t* small_chunk::data() const
+{
+    return begin_;
+}
+
+inline uint8_t& small_chunk::front()
+{
+    BITCOIN_ASSERT(size_ != 0);
+    return begin_[0];
+}
+
+inline const uint8_t& small_chunk::front() const
+{
+    BITCOIN_ASSERT(size_ != 0);
+    return begin_[0];
+}
+
+inline uint8_t& small_chunk::back()
+{
+    BITCOIN_ASSERT(size_ != 0);
+    return begin_[size_ - 1];
+}
+
+inline const uint8_t& small_chunk::back() const
+{
+    BITCOIN_ASSERT(size_ != 0);
+    return begin_[size_ - 1];
+}
+
+inline size_t small_chunk::size() const
+{
+    return size_;
+}
+
+inline size_t small_chunk::capacity() const
+{
+    return capacity_;
+}
+
+inline bool small_chunk::empty() const
+{
+    return size_ == 0;
+}
+
+inline bool small_chunk::is_inline() const
+{
+    return begin_ == buffer_;
+}
+
+// Modifiers.
+//-----------------------------------------------------------------------------
+
+inline void small_chunk::reserve(size_t size)
+{
+    if (size > capacity_)
+        grow(size);
+}
+
+inline void small_chunk::resize(size_t size, uint8_t value)
+{
+    reserve(size);
+
+    if (size > size_)
+        std::memset(begin_ + size_, value, size - size_);
+
+    size_ = static_cast<uint32_t>(size);
+}
+
+inline void small_chunk::clear()
+{
+    size_ = 0;
+}
+
+inline void small_chunk::shrink_to_fit()
+{
+    if (is_inline() || size_ > inline_capacity)
+        return;
+
+    const auto heap = begin_;
+    std::memcpy(buffer_, heap, size_);
+    begin_ = buffer_;
+    capacity_ = inline_capacity;
+    delete[] heap;
+}
+
+inline void small_chunk::push_back(uint8_t value)
+{
+    if (size_ == capacity_)
+        grow(size_ + 1u);
+
+    begin_[size_++] = value;
+}
+
+inline void small_chunk::pop_back()
+{
+    BITCOIN_ASSERT(size_ != 0);
+    --size_;
+}
+
+inline void small_chunk::assign(size_t size, uint8_t value)
+{
+    size_ = 0;
+    resize(size, value);
+}
+
+inline void small_chunk::assign(const uint8_t* begin, const uint8_t* end)
+{
+    const auto size = static_cast<size_t>(std::distance(begin, end));
+    size_ = 0;
+    reserve(size);
+
+    // A source within this buffer is not reallocated, as size is not larger.
+    if (size != 0)
+        std::memmove(begin_, begin, size);
+
+    size_ = static_cast<uint32_t>(size);
+}
+
+inline void small_chunk::assign(std::initializer_list<uint8_t> values)
+{
+    assign(values.begin(), values.end());
+}
+
+template <typename Iterator, typename>
+void small_chunk::assign(Iterator begin, Iterator end)
+{
+    const auto size = static_cast<size_t>(std::distance(begin, end));
+    size_ = 0;
+    reserve(size);
+    std::copy(begin, end, begin_);
+    size_ = static_cast<uint32_t>(size);
+}
+
+inline small_chunk::iterator small_chunk::insert(const_iterator position,
+    uint8_t value)
+{
+    return insert(position, &value, &value + 1);
+}
+
+inline small_chunk::iterator small_chunk::insert(const_iterator position,
+    const uint8_t* begin, const uint8_t* end)
+{
+    const auto offset = static_cast<size_t>(position - begin_);
+    const auto count = static_cast<size_t>(std::distance(begin, end));
+    BITCOIN_ASSERT(offset <= size_);
+
+    if (count == 0)
+        return begin_ + offset;
+
+    // A source within this buffer would be invalidated by reallocation.
+    if (begin >= begin_ && begin < begin_ + size_)
+    {
+        const small_chunk copy(begin, end);
+        return insert(position, copy.begin(), copy.end());
+    }
+
+    reserve(size_ + count);
+    const auto target = begin_ + offset;
+    std::memmove(target + count, target, size_ - offset);
+    std::memcpy(target, begin, count);
+    size_ += static_cast<uint32_t>(count);
+    return target;
+}
+
+template <typename Iterator, typename>
+small_chunk::iterator small_chunk::insert(const_iterator position,
+    Iterator begin, Iterator end)
+{
+    const auto offset = static_cast<size_t>(position - begin_);
+    const auto count = static_cast<size_t>(std::distance(begin, end));
+    BITCOIN_ASSERT(offset <= size_);
+
+    reserve(size_ + count);
+    const auto target = begin_ + offset;
+    std::memmove(target + count, target, size_ - offset);
+    std::copy(begin, end, target);
+    size_ += static_cast<uint32_t>(count);
+    return target;
+}
+
+inline small_chunk::iterator small_chunk::erase(const_iterator position)
+{
+    return erase(position, position + 1);
+}
+
+inline small_chunk::iterator small_chunk::erase(const_iterator begin,
+    const_iterator end)
+{
+    const auto first = begin_ + (begin - begin_);
+    const auto count = static_cast<size_t>(end - begin);
+    const auto tail = static_cast<size_t>(this->end() - end);
+    std::memmove(first, end, tail);
+    size_ -= static_cast<uint32_t>(count);
+    return first;
+}
+
+inline void small_chunk::swap(small_chunk& other)
+{
+    auto copy = std::move(other);
+    other = std::move(*this);
+    *this = std::move(copy);
+}
+
+inline data_chunk small_chunk::to_chunk() const
+{
+    return data_chunk(begin(), end());
+}
+
+// private
+inline void small_chunk::grow(size_t minimum)
+{
+    // Grow geometrically as with std::vector.
+    const auto size = std::max(minimum, size_t(capacity_) * 2u);
+    BITCOIN_ASSERT(size <= max_uint32);
+
+    const auto heap = new uint8_t[size];
+    std::memcpy(heap, begin_, size_);
+    release();
+    begin_ = heap;
+    capacity_ = static_cast<uint32_t>(size);
+}
+
+// private
+inline void small_chunk::release()
+{
+    if (!is_inline())
+        delete[] begin_;
+}
+
+// Utilities.
+//-----------------------------------------------------------------------------
+
+inline std::ostream& operator<<(std::ostream& output,
+    const small_chunk& bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    for (const auto byte: bytes)
+        output << digits[byte >> 4] << digits[byte & 0x0f];
+
+    return output;
+}
+
+template <typename Source>
+small_chunk to_small_chunk(const Source& bytes)
+{
+    return small_chunk(std::begin(bytes), std::end(bytes));
+}
+
+// Comparisons.
+//-----------------------------------------------------------------------------
+
+inline bool operator==(const small_chunk& left, const small_chunk& right)
+{
+    return left.size() == right.size() &&
+        std::equal(left.begin(), left.end(), right.begin());
+}
+
+inline bool operator!=(const small_chunk& left, const small_chunk& right)
+{
+    return !(left == right);
+}
+
+inline bool operator<(const small_chunk& left, const small_chunk& right)
+{
+    return std::lexicographical_compare(left.begin(), left.end(),
+        right.begin(), right.end());
+}
+
+inline bool operator==(const small_chunk& left, const data_chunk& right)
+{
+    return left.size() == right.size() &&
+        std::equal(left.begin(), left.end(), right.begin());
+}
+
+inline bool operator!=(const small_chunk& left, const data_chunk& right)
+{
+    return !(left == right);
+}
+
+inline bool operator==(const data_chunk& left, const small_chunk& right)
+{
+    return right == left;
+}
+
+inline bool operator!=(const data_chunk& left, const small_chunk& right)
+{
+    return !(right == left);
+}
+
+} // namespace libbitcoin
+
+#endif
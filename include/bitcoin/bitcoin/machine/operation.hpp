@@ -28,6 +28,7 @@
 #include <bitcoin/bitcoin/machine/script_pattern.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/small_chunk.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -47,8 +48,8 @@ public:
     operation(operation&& other);
     operation(const operation& other);
 
-    operation(data_chunk&& uncoded, bool minimal=true);
-    operation(const data_chunk& uncoded, bool minimal=true);
+    operation(small_chunk&& uncoded, bool minimal=true);
+    operation(const small_chunk& uncoded, bool minimal=true);
 
     operation(opcode code);
 
@@ -94,7 +95,7 @@ public:
     opcode code() const;
 
     /// Get the data, empty if not a push code or if invalid.
-    const data_chunk& data() const;
+    const small_chunk& data() const;
 
     // Utilities.
     //-------------------------------------------------------------------------
@@ -104,11 +105,11 @@ public:
 
     /// Compute the minimal data opcode for a given chunk of data.
     /// Caller should clear data if converting to non-payload opcode.
-    static opcode minimal_opcode_from_data(const data_chunk& data);
+    static opcode minimal_opcode_from_data(data_slice data);
 
     /// Compute the nominal data opcode for a given chunk of data.
     /// Restricted to sized data, avoids conversion to numeric opcodes.
-    static opcode nominal_opcode_from_data(const data_chunk& data);
+    static opcode nominal_opcode_from_data(data_slice data);
 
     /// Convert the [1..16] value to the corresponding opcode (or undefined).
     static opcode opcode_from_positive(uint8_t value);
@@ -141,15 +142,15 @@ public:
     bool is_nominal_push() const;
 
 protected:
-    operation(opcode code, data_chunk&& data, bool valid);
-    operation(opcode code, const data_chunk& data, bool valid);
+    operation(opcode code, small_chunk&& data, bool valid);
+    operation(opcode code, const small_chunk& data, bool valid);
     static uint32_t read_data_size(opcode code, reader& source);
-    opcode opcode_from_data(const data_chunk& data, bool minimal);
+    opcode opcode_from_data(data_slice data, bool minimal);
     void reset();
 
 private:
     opcode code_;
-    data_chunk data_;
+    small_chunk data_;
     bool valid_;
 };
 
@@ -29,6 +29,7 @@
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/small_chunk.hpp>
 
 namespace libbitcoin {
 namespace machine {
@@ -36,14 +37,14 @@ namespace machine {
 class BC_API program
 {
 public:
-    typedef data_stack::value_type value_type;
+    typedef small_stack::value_type value_type;
     typedef operation::iterator op_iterator;
 
     // Older libstdc++ does not allow erase with const iterator.
     // This is a bug that requires we up the minimum compiler version.
     // So presently stack_iterator is a non-const iterator.
-    ////typedef data_stack::const_iterator stack_iterator;
-    typedef data_stack::iterator stack_iterator;
+    ////typedef small_stack::const_iterator stack_iterator;
+    typedef small_stack::iterator stack_iterator;
 
     /// Create an instance that does not expect to verify signatures.
     /// This is useful for script utilities but not with input metadata.
@@ -61,7 +62,7 @@ public:
 
     /// Create an instance with initialized stack (witness run, v0 by default).
     program(const chain::script& script, const chain::transaction& transaction,
-        uint32_t input_index, uint32_t forks, data_stack&& stack,
+        uint32_t input_index, uint32_t forks, small_stack&& stack,
         uint64_t value, script_version version=script_version::zero);
 
     /// Create using copied tx, input, forks, value, stack (prevout run).
@@ -100,13 +101,13 @@ public:
     void push_copy(const value_type& item);
 
     /// Primary pop.
-    data_chunk pop();
+    value_type pop();
     bool pop(int32_t& out_value);
     bool pop(number& out_number, size_t maxiumum_size=max_number_size);
     bool pop_binary(number& first, number& second);
     bool pop_ternary(number& first, number& second, number& third);
     bool pop_position(stack_iterator& out_position);
-    bool pop(data_stack& section, size_t count);
+    bool pop(small_stack& section, size_t count);
 
     /// Primary push/pop optimizations (active).
     void duplicate(size_t index);
@@ -159,8 +160,8 @@ private:
     size_t negative_count_;
     size_t operation_count_;
     op_iterator jump_;
-    data_stack primary_;
-    data_stack alternate_;
+    small_stack primary_;
+    small_stack alternate_;
     bool_stack condition_;
 };
 
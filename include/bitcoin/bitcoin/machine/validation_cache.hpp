@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MACHINE_VALIDATION_CACHE_HPP
+#define LIBBITCOIN_MACHINE_VALIDATION_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <unordered_set>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+/// A bounded, thread safe set of successful validation results.
+/// Keys are salted so that entries cannot be targeted by a peer, and the set
+/// is sharded by key so that concurrent validation does not contend.
+/// The oldest entry of a shard is evicted to make room for a new entry.
+class BC_API validation_cache
+  : noncopyable
+{
+public:
+    /// A zero capacity disables the cache.
+    validation_cache(size_t capacity=0);
+
+    /// Generate the salted key of the concatenated slices.
+    hash_digest key(loaf slices) const;
+
+    /// True if the key is cached, counts a hit or miss when enabled.
+    bool contains(const hash_digest& key) const;
+
+    /// Cache the key, if enabled.
+    void insert(const hash_digest& key);
+
+    /// Clear entries and counters and set the capacity (zero disables).
+    void resize(size_t capacity);
+
+    /// Clear entries and counters.
+    void clear();
+
+    /// Properties.
+    bool enabled() const;
+    size_t capacity() const;
+    size_t size() const;
+    size_t hits() const;
+    size_t misses() const;
+
+private:
+    static BC_CONSTEXPR size_t shard_count = 16;
+
+    struct shard
+    {
+        std::unordered_set<hash_digest> keys;
+        std::deque<hash_digest> order;
+        mutable shared_mutex mutex;
+    };
+
+    shard& find(const hash_digest& key) const;
+
+    const hash_digest salt_;
+    std::atomic<size_t> capacity_;
+    mutable std::atomic<size_t> hits_;
+    mutable std::atomic<size_t> misses_;
+    mutable std::array<shard, shard_count> shards_;
+};
+
+} // namespace machine
+} // namespace libbitcoin
+
+#endif
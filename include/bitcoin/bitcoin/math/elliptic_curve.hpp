@@ -20,6 +20,7 @@
 #define LIBBITCOIN_ELLIPTIC_CURVE_HPP
 
 #include <cstddef>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
@@ -27,6 +28,8 @@
 
 namespace libbitcoin {
 
+class threadpool;
+
 /// The sign byte value for an even (y-valued) key.
 static BC_CONSTEXPR uint8_t ec_even_sign = 2;
 
@@ -89,6 +92,11 @@ BC_API bool ec_add(ec_compressed& point, const ec_secret& scalar);
 /// Compute the sum a += G*b, where G is the curve's generator point.
 BC_API bool ec_add(ec_uncompressed& point, const ec_secret& scalar);
 
+/// Compute the sum a + G*b for each scalar b, parsing the point a once.
+/// The sums are written to out in order, false if any sum is invalid.
+BC_API bool ec_add(point_list& out, const ec_compressed& point,
+    const secret_list& scalars);
+
 /// Compute the sum a = (a + b) % n, where n is the curve order.
 BC_API bool ec_add(ec_secret& left, const ec_secret& right);
 
@@ -153,14 +161,14 @@ bool is_uncompressed_key(data_slice point);
 bool is_public_key(data_slice point);
 
 /// Fast detection of endorsement structure (DER with signature hash type).
-bool is_endorsement(const endorsement& endorsement);
+bool is_endorsement(data_slice endorsement);
 
 // DER parse/encode
 // ----------------------------------------------------------------------------
 
 /// Parse an endorsement into signature hash type and DER signature.
 BC_API bool parse_endorsement(uint8_t& sighash_type,
-    der_signature& der_signature, const endorsement& endorsement);
+    der_signature& der_signature, data_slice endorsement);
 
 /// Parse a DER encoded signature with optional strict DER enforcement.
 /// Treat an empty DER signature as invalid, in accordance with BIP66.
@@ -189,6 +197,29 @@ BC_API bool verify_signature(const ec_uncompressed& point,
 BC_API bool verify_signature(data_slice point, const hash_digest& hash,
     const ec_signature& signature);
 
+// EC batch verify
+// ----------------------------------------------------------------------------
+
+/// An EC signature verification, with a caller tag (e.g. an input ordinal).
+/// The point is not copied, so its bytes must outlive the job.
+struct BC_API verify_job
+{
+    typedef std::vector<verify_job> list;
+
+    data_slice point;
+    hash_digest hash;
+    ec_signature signature;
+    size_t tag;
+    bool valid;
+};
+
+/// Verify each job against the precomputed verification context, parsing
+/// each distinct point once. Sets each result, true if all are valid.
+BC_API bool verify_signatures(verify_job::list& jobs);
+
+/// Verify jobs concurrently in contiguous partitions, as above.
+BC_API bool verify_signatures(verify_job::list& jobs, threadpool& pool);
+
 // Recoverable sign/recover
 // ----------------------------------------------------------------------------
 
@@ -23,9 +23,9 @@
 #include <string>
 #include <vector>
 #include <boost/functional/hash_fwd.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/uint256.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 
@@ -55,9 +55,6 @@ typedef std::vector<long_hash> long_hash_list;
 typedef std::vector<short_hash> short_hash_list;
 typedef std::vector<mini_hash> mini_hash_list;
 
-// Alias for boost big integer type.
-typedef boost::multiprecision::uint256_t uint256_t;
-
 // Null-valued common bitcoin hashes.
 
 BC_CONSTEXPR hash_digest null_hash
@@ -109,7 +106,7 @@ BC_CONSTEXPR mini_hash null_mini_hash
 
 inline uint256_t to_uint256(const hash_digest& hash)
 {
-    return from_little_endian<uint256_t>(hash.begin(), hash.end());
+    return uint256_t(hash);
 }
 
 /// Generate a scrypt hash to fill a byte array.
@@ -124,9 +121,32 @@ BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
 /// Generate a bitcoin hash.
 BC_API hash_digest bitcoin_hash(data_slice data);
 
-/// Generate a scrypt hash.
+/// Generate a bitcoin hash of each 64 byte block, batched across simd lanes.
+/// The data size should be a multiple of 64, a partial block is not hashed.
+BC_API hash_list bitcoin_hash_blocks(data_slice blocks);
+
+/// Names of the sha256 engines selected for this cpu at startup.
+BC_API std::string sha256_engines();
+
+// THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
+/// Generate a bitcoin hash of each 64 byte block with the named sha256 engine
+/// (generic, sha-ni, sse4.1 or avx2), whether or not it is selected at
+/// startup. False if the engine is unknown or not supported by this cpu.
+BC_API bool bitcoin_hash_blocks(hash_list& out, data_slice blocks,
+    const std::string& engine);
+
+/// Generate a scrypt hash (N=1024, r=1, p=1), as used for proof of work.
+/// Scratch memory is leased from a pool of released buffers, shared by all
+/// threads, and is only allocated when no released buffer is available.
 BC_API hash_digest scrypt_hash(data_slice data);
 
+/// Generate a scrypt hash of each block_size block (such as a serialized
+/// header), batched across simd lanes. A partial block is not hashed.
+BC_API hash_list scrypt_hash_blocks(data_slice blocks, size_t block_size);
+
+/// Names of the scrypt engines selected for this cpu at startup.
+BC_API std::string scrypt_engines();
+
 /// Generate a bitcoin short hash.
 BC_API short_hash bitcoin_short_hash(data_slice data);
 
@@ -159,6 +179,24 @@ BC_API long_hash hmac_sha512_hash(data_slice data, data_slice key);
 BC_API long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations);
 
+/// Generate a pkcs5 pbkdf2 hmac sha512 hash of each passphrase and salt pair.
+/// Independent derivations are computed together across sha512 lanes.
+/// Throws std::invalid_argument if the stacks differ in size.
+BC_API long_hash_list pkcs5_pbkdf2_hmac_sha512(const data_stack& passphrases,
+    const data_stack& salts, size_t iterations);
+
+/// A random salt, fixed for the life of the process, mixed into the hashes of
+/// unordered container keys so that bucket collisions cannot be precomputed.
+BC_API uint64_t hash_salt();
+
+/// Salted hash of a digest for unordered containers. Digests are uniformly
+/// distributed, so one word of the digest is sufficient (see point::checksum).
+template <size_t Size>
+size_t salted_hash(const byte_array<Size>& hash);
+
+/// Salted hash of a digest and index, such as an output point.
+size_t salted_hash(const hash_digest& hash, uint32_t index);
+
 } // namespace libbitcoin
 
 // Extend std and boost namespaces with our hash wrappers.
@@ -174,6 +212,24 @@ struct hash<bc::byte_array<Size>>
         return boost::hash_range(hash.begin(), hash.end());
     }
 };
+
+template <>
+struct hash<bc::hash_digest>
+{
+    size_t operator()(const bc::hash_digest& hash) const
+    {
+        return bc::salted_hash(hash);
+    }
+};
+
+template <>
+struct hash<bc::short_hash>
+{
+    size_t operator()(const bc::short_hash& hash) const
+    {
+        return bc::salted_hash(hash);
+    }
+};
 } // namespace std
 
 namespace boost
@@ -186,6 +242,24 @@ struct hash<bc::byte_array<Size>>
         return boost::hash_range(hash.begin(), hash.end());
     }
 };
+
+template <>
+struct hash<bc::hash_digest>
+{
+    size_t operator()(const bc::hash_digest& hash) const
+    {
+        return bc::salted_hash(hash);
+    }
+};
+
+template <>
+struct hash<bc::short_hash>
+{
+    size_t operator()(const bc::short_hash& hash) const
+    {
+        return bc::salted_hash(hash);
+    }
+};
 } // namespace boost
 
 #include <bitcoin/bitcoin/impl/math/hash.ipp>
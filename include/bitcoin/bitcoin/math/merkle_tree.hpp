@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MERKLE_TREE_HPP
+#define LIBBITCOIN_MERKLE_TREE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// A bitcoin merkle tree, in which an odd level duplicates its last hash.
+/// Each level is hashed in place as one batch of 64 byte pairs. The levels
+/// are retained so that branches and partial trees (bip37) can be produced
+/// without rehashing. This class is not thread safe for mutation.
+class BC_API merkle_tree
+{
+public:
+    typedef std::vector<hash_list> levels;
+
+    /// Compute the merkle root of the leaves, consuming the list.
+    static hash_digest reduce(hash_list&& leaves);
+
+    /// Compute the merkle root implied by a leaf and its branch.
+    static hash_digest branch_root(const hash_digest& leaf,
+        const hash_list& branch, size_t index);
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    merkle_tree();
+    merkle_tree(merkle_tree&& other);
+    merkle_tree(const merkle_tree& other);
+    merkle_tree(hash_list&& leaves);
+    merkle_tree(const hash_list& leaves);
+
+    // Operators.
+    //-------------------------------------------------------------------------
+
+    merkle_tree& operator=(merkle_tree&& other);
+    merkle_tree& operator=(const merkle_tree& other);
+
+    bool operator==(const merkle_tree& other) const;
+    bool operator!=(const merkle_tree& other) const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    /// The tree has no leaves.
+    bool empty() const;
+
+    /// The number of leaves.
+    size_t size() const;
+
+    /// The number of levels, including leaves and root.
+    size_t height() const;
+
+    /// The leaves (depth zero) through the root (depth height - 1).
+    const levels& tree() const;
+
+    /// The root hash, or null_hash for an empty tree.
+    hash_digest root() const;
+
+    // Proofs.
+    //-------------------------------------------------------------------------
+
+    /// The sibling hashes of the leaf at index, ordered from leaf to root.
+    /// Returns an empty branch if the index is out of range.
+    hash_list branch(size_t index) const;
+
+    /// Produce the bip37 partial merkle tree hashes and flags for the
+    /// matches, which must have one element for each leaf.
+    bool partial(hash_list& out_hashes, data_chunk& out_flags,
+        const std::vector<bool>& matches) const;
+
+private:
+    static void reduce_level(hash_list& level);
+
+    void build();
+    void traverse(hash_list& out_hashes, std::vector<bool>& out_bits,
+        const std::vector<bool>& matches, size_t depth, size_t position) const;
+
+    levels tree_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIPHASH_HPP
+#define LIBBITCOIN_SIPHASH_HPP
+
+#include <cstdint>
+#include <tuple>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+typedef std::tuple<uint64_t, uint64_t> siphash_key;
+
+/// Read a siphash key (k0, k1) from a little-endian byte sequence.
+BC_API siphash_key to_siphash_key(const half_hash& hash);
+
+/// Generate a SipHash-2-4 of the data, keyed by the sixteen bytes of hash.
+BC_API uint64_t siphash(const half_hash& hash, data_slice message);
+
+/// Generate a SipHash-2-4 of the key and data.
+BC_API uint64_t siphash(const siphash_key& key, data_slice message);
+
+/// Generate a SipHash-2-4 of the key and a hash digest.
+/// This is unrolled for the fixed size, as used for short transaction ids.
+BC_API uint64_t siphash(const siphash_key& key, const hash_digest& hash);
+
+} // namespace libbitcoin
+
+#endif
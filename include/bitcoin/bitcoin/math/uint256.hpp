@@ -16,13 +16,109 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#ifndef LIBBBITCOIN_UINT256_HPP
-#define LIBBBITCOIN_UINT256_HPP
+#ifndef LIBBITCOIN_UINT256_HPP
+#define LIBBITCOIN_UINT256_HPP
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
 
+/// Unsigned 256 bit integer of four native 64 bit words, arithmetic is modulo
+/// 2^256. This replaces the boost multiprecision type for proof of work, as
+/// fixed width avoids the allocation and normalization of arbitrary precision.
+class BC_API uint256_t
+{
+public:
+    typedef byte_array<32> hash_type;
+
+    /// Constructors.
+    BC_CONSTFUNC uint256_t(uint64_t value=0);
+    BC_CONSTFUNC uint256_t(uint64_t word0, uint64_t word1, uint64_t word2,
+        uint64_t word3);
+
+    /// The hash is interpreted as a little-endian number (bitcoin hash order).
+    explicit uint256_t(const hash_type& hash);
+
+    /// The little-endian (bitcoin hash order) serialization of the value.
+    hash_type hash() const;
+
+    /// The number of bits required to represent the value (zero for zero).
+    size_t bit_length() const;
+
+    /// The number of bytes required to represent the value (zero for zero).
+    size_t byte_length() const;
+
+    /// The word at the index, zero being the least significant.
+    BC_CONSTFUNC uint64_t operator[](size_t index) const;
+
+    /// Truncation to the least significant word.
+    explicit operator uint64_t() const;
+
+    /// Unary operators.
+    uint256_t operator~() const;
+    uint256_t operator-() const;
+    uint256_t& operator++();
+    uint256_t& operator--();
+
+    /// Assignment operators.
+    uint256_t& operator>>=(uint32_t shift);
+    uint256_t& operator<<=(uint32_t shift);
+    uint256_t& operator&=(const uint256_t& other);
+    uint256_t& operator|=(const uint256_t& other);
+    uint256_t& operator^=(const uint256_t& other);
+    uint256_t& operator+=(const uint256_t& other);
+    uint256_t& operator-=(const uint256_t& other);
+    uint256_t& operator*=(uint32_t value);
+
+    /// Division throws std::overflow_error on a zero divisor.
+    uint256_t& operator/=(uint32_t value);
+    uint256_t& operator/=(const uint256_t& value);
+
+    /// Three-way comparison, negative if less, zero if equal.
+    int compare(const uint256_t& other) const;
+
+private:
+    friend std::ostream& operator<<(std::ostream& output,
+        const uint256_t& value);
+
+    static BC_CONSTEXPR size_t words = 4;
+
+    // Divide in place by a nonzero 32 bit divisor, returning the remainder.
+    uint32_t divide(uint32_t divisor);
+
+    uint64_t words_[words];
+};
+
+/// Comparison operators.
+bool operator==(const uint256_t& left, const uint256_t& right);
+bool operator!=(const uint256_t& left, const uint256_t& right);
+bool operator<(const uint256_t& left, const uint256_t& right);
+bool operator>(const uint256_t& left, const uint256_t& right);
+bool operator<=(const uint256_t& left, const uint256_t& right);
+bool operator>=(const uint256_t& left, const uint256_t& right);
+
+/// Binary operators.
+uint256_t operator>>(const uint256_t& left, uint32_t shift);
+uint256_t operator<<(const uint256_t& left, uint32_t shift);
+uint256_t operator&(const uint256_t& left, const uint256_t& right);
+uint256_t operator|(const uint256_t& left, const uint256_t& right);
+uint256_t operator^(const uint256_t& left, const uint256_t& right);
+uint256_t operator+(const uint256_t& left, const uint256_t& right);
+uint256_t operator-(const uint256_t& left, const uint256_t& right);
+uint256_t operator*(const uint256_t& left, uint32_t right);
+uint256_t operator/(const uint256_t& left, uint32_t right);
+uint256_t operator/(const uint256_t& left, const uint256_t& right);
+
+/// Writes the value in decimal.
+BC_API std::ostream& operator<<(std::ostream& output, const uint256_t& value);
+
 } // namespace libbitcoin
 
+#include <bitcoin/bitcoin/impl/math/uint256.ipp>
+
 #endif
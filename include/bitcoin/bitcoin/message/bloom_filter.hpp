@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+#define LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/message/merkle_block.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// This class is not thread safe.
+/// A bip37 connection bloom filter, loaded from a peer's filter_load.
+/// Matching a transaction may insert its outpoints, according to the update
+/// flags, so that spends of matched outputs are also matched.
+class BC_API bloom_filter
+{
+public:
+    /// The filter update behavior on a matched output (low two flag bits).
+    enum class update : uint8_t
+    {
+        none = 0,
+        all = 1,
+        pay_public_key_only = 2,
+        mask = 3
+    };
+
+    /// Consensus-independent (bip37) limits on a loaded filter.
+    static const size_t max_filter_size;
+    static const uint32_t max_hash_functions;
+
+    bloom_filter();
+    bloom_filter(const filter_load& message);
+    bloom_filter(const data_chunk& filter, uint32_t hash_functions,
+        uint32_t tweak, uint8_t flags);
+
+    /// False if the filter exceeds the bip37 limits (peer misbehavior).
+    bool is_valid() const;
+
+    /// The filter bytes, as they would be reloaded.
+    const data_chunk& filter() const;
+
+    // Elements.
+    //-------------------------------------------------------------------------
+
+    /// Insert an element, such as the data of a filter_add message.
+    void insert(data_slice element);
+    void insert(const chain::point& outpoint);
+
+    /// True if the element is (probably) in the filter.
+    bool contains(data_slice element) const;
+    bool contains(const chain::point& outpoint) const;
+
+    // Matching.
+    //-------------------------------------------------------------------------
+
+    /// True if the transaction is relevant to the filter. Matched outputs
+    /// are inserted as outpoints, subject to the update flags.
+    bool match(const chain::transaction& tx);
+
+    /// Match each transaction of the block, in order, and produce the
+    /// partial merkle block of the matches.
+    merkle_block to_merkle_block(const chain::block& block);
+
+    /// As above, also returning the match of each transaction, for relay
+    /// of the matched transactions following the merkle block.
+    merkle_block to_merkle_block(const chain::block& block,
+        std::vector<bool>& out_matches);
+
+private:
+    typedef byte_array<hash_size + sizeof(uint32_t)> point_bytes;
+
+    static point_bytes to_bytes(const chain::point& outpoint);
+
+    size_t bit_index(data_slice element, uint32_t function) const;
+    bool match_outputs(const chain::transaction& tx);
+    bool match_inputs(const chain::transaction& tx) const;
+    void set_state();
+
+    data_chunk filter_;
+    uint32_t hash_functions_;
+    uint32_t tweak_;
+    uint8_t flags_;
+    size_t bits_;
+    bool empty_;
+    bool full_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_COMPACT_BLOCK_RECONSTRUCTOR_HPP
+#define LIBBITCOIN_MESSAGE_COMPACT_BLOCK_RECONSTRUCTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// This class is not thread safe.
+/// Reconstructs a block from a compact block (BIP152) and a set of candidate
+/// transactions, such as the memory pool. Short ids are indexed on
+/// construction, so matching is constant time for each candidate.
+class BC_API compact_block_reconstructor
+  : noncopyable
+{
+public:
+    /// Short ids are of txids, or of wtxids if witness (compact version 2).
+    compact_block_reconstructor(const compact_block& block,
+        bool witness=false);
+
+    /// False if the prefilled indexes are invalid or short ids collide.
+    /// In either case the full block must be requested.
+    bool is_valid() const;
+
+    /// True if every transaction of the block has been placed.
+    bool is_complete() const;
+
+    /// The short id (low 48 bits of siphash) of a hash under the block key.
+    uint64_t short_id(const hash_digest& hash) const;
+
+    /// Place the candidate if it matches an unfilled short id.
+    /// Distinct candidates matching the same short id are both discarded.
+    bool match(const chain::transaction& candidate);
+
+    /// Place the matching candidates, returns the number placed.
+    /// Stops once complete, so later conflicting candidates are not seen.
+    size_t match(const chain::transaction::list& candidates);
+
+    /// Place the transactions of a response to the request.
+    /// False if the response is not for this block or the missing indexes.
+    bool fill(const block_transactions& response);
+
+    /// The absolute indexes of the transactions not yet placed.
+    std::vector<uint64_t> missing() const;
+
+    /// The request for the transactions not yet placed.
+    /// Indexes are differentially encoded, as they are serialized as is.
+    get_block_transactions to_request() const;
+
+    /// The reconstructed block, or a default block if not complete.
+    /// The merkle root is not verified here, a mismatch (due to a short id
+    /// collision with a candidate) is found by block check, at which point
+    /// the full block must be requested.
+    chain::block to_block() const;
+
+private:
+    enum class slot : uint8_t
+    {
+        empty,
+        filled,
+        conflicted
+    };
+
+    static siphash_key to_key(const compact_block& block);
+    static uint64_t to_short_id(const compact_block::short_id& id);
+
+    bool initialize(const compact_block& block);
+
+    const chain::header header_;
+    const siphash_key key_;
+    const bool witness_;
+    std::vector<chain::transaction> transactions_;
+    std::vector<slot> slots_;
+    std::unordered_map<uint64_t, size_t> index_;
+    size_t remaining_;
+    bool valid_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_FRAME_HPP
+#define LIBBITCOIN_MESSAGE_FRAME_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// This class is thread safe.
+/// A wire message as its heading and a shared serialized payload, for
+/// scatter/gather output. A payload serialized once (such as a block relayed
+/// to many peers) is sent with only the heading written for each frame.
+class BC_API frame
+{
+public:
+    /// A serialized payload and its checksum, which is computed once for
+    /// the frames of all peers.
+    struct BC_API shared_payload
+    {
+        explicit shared_payload(data_chunk&& payload);
+
+        const data_chunk data;
+        const uint32_t checksum;
+    };
+
+    typedef std::shared_ptr<const shared_payload> payload_ptr;
+    typedef std::array<asio::const_buffer, 2> buffers;
+
+    /// The serialized heading (heading::satoshi_fixed_size).
+    typedef byte_array<24> heading_data;
+
+    /// Frame the payload. The payload is not copied or hashed.
+    frame(uint32_t magic, const std::string& command, payload_ptr payload);
+
+    /// The serialized heading.
+    const heading_data& heading() const;
+
+    /// The serialized payload.
+    const data_chunk& payload() const;
+
+    /// The size of the wire message (heading and payload).
+    size_t size() const;
+
+    /// The heading and payload buffers, for a gathering socket write.
+    /// The buffers are valid for the lifetime of this frame.
+    buffers to_buffers() const;
+
+    /// The wire message as one buffer, which copies the payload.
+    data_chunk to_data() const;
+
+private:
+    const payload_ptr payload_;
+    const heading_data heading_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
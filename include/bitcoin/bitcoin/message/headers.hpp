@@ -19,21 +19,28 @@
 #ifndef LIBBITCOIN_MESSAGE_HEADERS_HPP
 #define LIBBITCOIN_MESSAGE_HEADERS_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
 #include <memory>
 #include <string>
+#include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/message/header.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
+
+class settings;
+
 namespace message {
 
 class BC_API headers
@@ -63,6 +70,23 @@ public:
     void to_inventory(inventory_vector::list& out,
         inventory::type_id type) const;
 
+    /// Context free header checks (proof of work and timestamp), partitioned
+    /// across the threadpool. Failed is set to the index of the first failed
+    /// header, or to the number of headers if all pass.
+    code check(size_t& failed, uint32_t timestamp_limit_seconds,
+        uint32_t proof_of_work_limit, threadpool& pool,
+        bool scrypt=false) const;
+
+    /// Sequential linkage and contextual header checks upon the state of the
+    /// parent of the first header, populating the chain state of each header.
+    /// Failed is set as for check.
+    code accept(size_t& failed, const chain::chain_state& parent,
+        const settings& settings) const;
+
+    /// Check and then accept the headers, failed is the lowest failed index.
+    code validate(size_t& failed, const chain::chain_state& parent,
+        const settings& settings, threadpool& pool, bool scrypt=false) const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -85,6 +109,9 @@ public:
     static const uint32_t version_maximum;
 
 private:
+    code accept(size_t& failed, const chain::chain_state& parent,
+        const settings& settings, size_t count) const;
+
     header::list elements_;
 };
 
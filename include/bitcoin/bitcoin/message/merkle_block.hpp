@@ -22,9 +22,11 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/merkle_tree.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
@@ -49,6 +51,10 @@ public:
     merkle_block(chain::header&& header, size_t total_transactions,
         hash_list&& hashes, data_chunk&& flags);
     merkle_block(const chain::block& block);
+
+    /// Partial merkle tree (bip37) of the matched transactions of the tree.
+    merkle_block(const chain::header& header, const merkle_tree& tree,
+        const std::vector<bool>& matches);
     merkle_block(const merkle_block& other);
     merkle_block(merkle_block&& other);
 
@@ -54,8 +54,10 @@
 #include <bitcoin/bitcoin/message/transaction.hpp>
 #include <bitcoin/bitcoin/message/verack.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 
 // Minimum current libbitcoin protocol version:     31402
 // Minimum current satoshi client protocol version: 31800
@@ -147,48 +149,70 @@ DECLARE_MESSAGE_POINTER_LIST_POINTER_TYPES(transaction);
 
 namespace message {
 
+/// False if a presized write did not exactly fill its buffer, which is a
+/// serialized_size defect. The safe serializer does not write past the end.
+template <typename Iterator>
+bool verify_serialized(const serializer<Iterator>& sink, Iterator end)
+{
+    const auto valid = sink && sink.position() == end;
+    BITCOIN_ASSERT_MSG(valid, "serialized size mismatch");
+    return valid;
+}
+
 /// Serialize a message object to the Bitcoin wire protocol encoding.
+/// Returns empty on a serialized size mismatch, which fails the send.
 template <typename Message>
 data_chunk serialize(uint32_t version, const Message& packet,
     uint32_t magic)
 {
     const auto heading_size = heading::satoshi_fixed_size();
     const auto payload_size = packet.serialized_size(version);
-    const auto message_size = heading_size + payload_size;
-
-    // Unfortunately data_sink doesn't support seek, so this is a little ugly.
-    // The header requires payload size and checksum but prepends the payload.
-    // Use a stream to prevent unnecessary copying of the payload.
-    data_chunk data;
 
-    // Reserve memory for the full message.
-    data.reserve(message_size);
+    // The message is allocated once and the payload is written in place,
+    // following space for the heading, without a stream.
+    data_chunk data(heading_size + payload_size);
+    auto payload = make_safe_serializer(data.begin() + heading_size,
+        data.end());
+    packet.to_data(version, payload);
 
-    // Size the vector for the heading so that payload insertion will follow.
-    data.resize(heading_size);
+    if (!verify_serialized(payload, data.end()))
+        return {};
 
-    // Insert the payload after the heading and into the reservation.
-    data_sink ostream(data);
-    packet.to_data(version, ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == message_size);
-
-    // Create the payload checksum without copying the buffer.
-    data_slice slice(data.data() + heading_size, data.data() + message_size);
+    // The heading requires the payload size and checksum, so it follows.
+    const data_slice slice(data.data() + heading_size,
+        data.data() + data.size());
     const auto check = bitcoin_checksum(slice);
     const auto payload_size32 = safe_unsigned<uint32_t>(payload_size);
+    auto head = make_safe_serializer(data.begin(), data.begin() + heading_size);
+    heading(magic, Message::command, payload_size32, check).to_data(head);
 
-    // Create and serialize the heading to a temporary variable (12 bytes).
-    heading head(magic, Message::command, payload_size32, check);
-    auto heading = head.to_data();
+    if (!verify_serialized(head, data.begin() + heading_size))
+        return {};
+
+    return data;
+}
+
+/// Serialize only the payload of a message object, such as for a block
+/// that is cached and framed for each peer (see frame).
+/// Returns empty on a serialized size mismatch.
+template <typename Message>
+data_chunk serialize_payload(uint32_t version, const Message& packet)
+{
+    data_chunk data(packet.serialized_size(version));
+    auto payload = make_safe_serializer(data.begin(), data.end());
+    packet.to_data(version, payload);
+
+    if (!verify_serialized(payload, data.end()))
+        return {};
 
-    // Move the heading into the allocated beginning of the message buffer.
-    std::move(heading.begin(), heading.end(), data.begin());
     return data;
 }
 
 BC_API size_t variable_uint_size(uint64_t value);
 
+/// The encoded size of a variable integer, from its first (prefix) byte.
+BC_API size_t variable_prefix_size(uint8_t prefix);
+
 } // namespace message
 } // namespace libbitcoin
 
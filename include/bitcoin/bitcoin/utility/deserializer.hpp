@@ -63,6 +63,7 @@ public:
     bool operator!() const;
     bool is_exhausted() const;
     void invalidate();
+    const uint8_t* position() const;
 
     /// Read hashes.
     hash_digest read_hash();
@@ -110,6 +111,12 @@ private:
     // The number of bytes remaining in the buffer.
     size_t remaining() const;
 
+    // Only pointer iterators are known to address a contiguous buffer.
+    static const uint8_t* address(const uint8_t* iterator);
+    static const uint8_t* address(uint8_t* iterator);
+    template <typename Other>
+    static const uint8_t* address(const Other& iterator);
+
     bool valid_;
     Iterator iterator_;
     const Iterator end_;
@@ -58,6 +58,7 @@ class BC_API dispatcher
 {
 public:
     typedef std::function<void(const code&)> delay_handler;
+    typedef std::function<void(size_t)> partition_handler;
 
     dispatcher(threadpool& pool, const std::string& name);
 
@@ -246,6 +247,12 @@ public:
     ////        sequence(BIND_ELEMENT(args, element, call));
     ////}
 
+    /// Invokes the handler once for each bucket, concurrently on the pool and
+    /// the calling thread, returning once all buckets have completed. Buckets
+    /// not taken by the pool are run on the calling thread, so this completes
+    /// if the pool is stopped or if called from a thread of the pool.
+    void partition(size_t buckets, const partition_handler& handler);
+
     /// The size of the dispatcher's threadpool at the time of calling.
     inline size_t size() const
     {
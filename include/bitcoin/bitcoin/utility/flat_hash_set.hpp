@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_FLAT_HASH_SET_HPP
+#define LIBBITCOIN_FLAT_HASH_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace libbitcoin {
+
+/// An open addressing set for duplicate detection, with storage for the
+/// constructed capacity allocated on construction. Keys are probed by hash and
+/// compared exactly, so the hasher may collide (such as point::checksum). The
+/// set references its keys, which must outlive it and must not be modified.
+/// Inserting more keys than the capacity doubles the capacity.
+template <typename Key, typename Hasher=std::hash<Key>>
+class flat_hash_set
+{
+public:
+    flat_hash_set(size_t capacity, Hasher hasher=Hasher());
+
+    /// The number of keys in the set.
+    size_t size() const;
+
+    /// True if an equal key is in the set.
+    bool contains(const Key& key) const;
+
+    /// Insert the key by reference, false if an equal key is in the set.
+    bool insert(const Key& key);
+
+    /// Remove all keys, retaining the allocation.
+    void clear();
+
+private:
+    struct slot
+    {
+        uint64_t hash;
+        const Key* key;
+    };
+
+    static uint8_t slot_bits(size_t capacity);
+    size_t find(const Key& key, uint64_t hash) const;
+    void grow();
+
+    const Hasher hasher_;
+    size_t capacity_;
+    size_t mask_;
+    uint8_t shift_;
+    size_t size_;
+    std::vector<slot> slots_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/flat_hash_set.ipp>
+
+#endif
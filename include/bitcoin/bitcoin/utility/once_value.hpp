@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_ONCE_VALUE_HPP
+#define LIBBITCOIN_ONCE_VALUE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace libbitcoin {
+
+/// An inline value computed at most once and published without a lock.
+/// Readers of a published value do not block, a reader only waits (yields)
+/// while another thread computes the value. The factory must be pure.
+/// Concurrent read/write (set, reset, assignment) is not supported.
+template <typename Type>
+class once_value
+{
+public:
+    once_value();
+    once_value(const Type& value);
+    once_value(Type&& value);
+
+    /// Only a published value is copied or moved, a moved source is reset.
+    once_value(const once_value& other);
+    once_value(once_value&& other);
+    once_value& operator=(const once_value& other);
+    once_value& operator=(once_value&& other);
+
+    /// True if a value has been published.
+    bool empty() const;
+
+    /// The published value, computed and published by factory if empty.
+    template <typename Factory>
+    const Type& get(Factory factory) const;
+
+    /// Publish the value, replacing any existing value.
+    void set(const Type& value);
+    void set(Type&& value);
+
+    /// Discard and release the published value.
+    void reset();
+
+private:
+    static const uint8_t empty_ = 0;
+    static const uint8_t busy_ = 1;
+    static const uint8_t ready_ = 2;
+
+    mutable std::atomic<uint8_t> state_;
+    mutable Type value_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/once_value.ipp>
+
+#endif
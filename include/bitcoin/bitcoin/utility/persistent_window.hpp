@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PERSISTENT_WINDOW_HPP
+#define LIBBITCOIN_PERSISTENT_WINDOW_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace libbitcoin {
+
+/**
+ * A sliding window of values that shares storage with the window it was
+ * copied from, for states that each advance their predecessor by one value.
+ *
+ * Windows are ranges over an append-only buffer. A copy shares the buffer,
+ * pop_front advances the start of the range and push_back claims the next
+ * slot of the buffer if no other window has claimed it. Otherwise (a fork)
+ * or once the buffer is full the window moves to a new buffer of a multiple
+ * of its size, so that copy and advance are constant time and allocation is
+ * amortized over many advances. Mutable element access detaches a window
+ * from shared storage. The interface follows the subset of std::deque used
+ * for ordered chain samples.
+ *
+ * Distinct instances are thread safe, including those that share storage.
+ */
+template <typename Type>
+class persistent_window
+{
+private:
+    // Disambiguates iterator pairs from (size, value).
+    template <typename Iterator>
+    using iterator_only = typename std::enable_if<
+        !std::is_integral<Iterator>::value>::type;
+
+public:
+    typedef Type value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef Type& reference;
+    typedef const Type& const_reference;
+    typedef Type* iterator;
+    typedef const Type* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    persistent_window();
+    persistent_window(std::initializer_list<Type> values);
+    explicit persistent_window(size_t size, const Type& value=Type{});
+
+    template <typename Iterator, typename = iterator_only<Iterator>>
+    persistent_window(Iterator begin, Iterator end);
+
+    /// Copies share storage, a moved source is left empty.
+    persistent_window(const persistent_window& other);
+    persistent_window(persistent_window&& other);
+    persistent_window& operator=(const persistent_window& other);
+    persistent_window& operator=(persistent_window&& other);
+
+    // Element access.
+    //-------------------------------------------------------------------------
+
+    /// Mutable access detaches the window from shared storage.
+    Type& operator[](size_t index);
+    Type& front();
+    Type& back();
+
+    const Type& operator[](size_t index) const;
+    const Type& front() const;
+    const Type& back() const;
+
+    // Iterators.
+    //-------------------------------------------------------------------------
+
+    /// Mutable iteration detaches the window from shared storage.
+    iterator begin();
+    iterator end();
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    size_t size() const;
+    bool empty() const;
+
+    /// True if the storage of this window may be referenced by another.
+    bool is_shared() const;
+
+    // Modifiers.
+    //-------------------------------------------------------------------------
+
+    void push_back(const Type& value);
+    void pop_front();
+    void pop_back();
+    void resize(size_t size, const Type& value=Type{});
+    void clear();
+
+private:
+    // Storage is reserved as a multiple of the window size when moved.
+    static const size_t growth_factor;
+    static const size_t minimum_capacity;
+
+    struct buffer
+    {
+        explicit buffer(size_t capacity);
+
+        const size_t capacity;
+        const std::unique_ptr<Type[]> values;
+
+        // The number of slots claimed by windows.
+        std::atomic<size_t> claimed;
+    };
+
+    bool claim();
+    void detach();
+    void relocate(size_t reserve);
+
+    std::shared_ptr<buffer> buffer_;
+    size_t begin_;
+    size_t end_;
+};
+
+template <typename Type>
+bool operator==(const persistent_window<Type>& left,
+    const persistent_window<Type>& right);
+
+template <typename Type>
+bool operator!=(const persistent_window<Type>& left,
+    const persistent_window<Type>& right);
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/persistent_window.ipp>
+
+#endif
@@ -38,6 +38,14 @@ public:
     virtual bool is_exhausted() const = 0;
     virtual void invalidate() = 0;
 
+    /// The address of the next byte in a contiguous source buffer, or null
+    /// if the source is not addressable (or invalid). This allows callers to
+    /// hash consumed bytes in place rather than reserializing them.
+    virtual const uint8_t* position() const
+    {
+        return nullptr;
+    }
+
     /// Read hashes.
     virtual hash_digest read_hash() = 0;
     virtual short_hash read_short_hash() = 0;
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SCRIPT_ARENA_HPP
+#define LIBBITCOIN_SCRIPT_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/intrusive_ptr.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+
+namespace libbitcoin {
+
+/// A monotonic memory region for the script bytes of objects that are
+/// deserialized together, such as a block. Other block containers remain on
+/// the heap. Chunks are released together when the last script referencing
+/// the arena is destroyed, and a copied script owns its bytes, so a copy
+/// does not retain the arena. Allocation is not thread safe, as it occurs
+/// during (sequential) deserialization, and deallocation is a no-op.
+/// The reference count is intrusive, so a reference is one pointer wide.
+class BC_API script_arena
+  : noncopyable
+{
+public:
+    typedef boost::intrusive_ptr<script_arena> ptr;
+
+    static const size_t default_chunk_size;
+
+    script_arena(size_t chunk_size=default_chunk_size);
+
+    /// Allocate size bytes at the alignment (a power of two).
+    void* allocate(size_t size, size_t alignment);
+
+    /// The number of bytes allocated from the arena.
+    size_t allocated() const;
+
+    /// The number of bytes obtained from the heap by the arena.
+    size_t reserved() const;
+
+private:
+    typedef std::unique_ptr<uint8_t[]> chunk;
+
+    friend BC_API void intrusive_ptr_add_ref(script_arena* memory);
+    friend BC_API void intrusive_ptr_release(script_arena* memory);
+
+    const size_t chunk_size_;
+    std::atomic<size_t> references_;
+
+    std::vector<chunk> chunks_;
+    uint8_t* position_;
+    uint8_t* end_;
+    size_t allocated_;
+    size_t reserved_;
+};
+
+BC_API void intrusive_ptr_add_ref(script_arena* memory);
+BC_API void intrusive_ptr_release(script_arena* memory);
+
+} // namespace libbitcoin
+
+#endif
@@ -40,6 +40,7 @@ public:
     typedef std::function<void(serializer<Iterator>&)> functor;
 
     serializer(const Iterator begin);
+    serializer(const Iterator begin, const Iterator end);
 
     template <typename Tuple>
     void write_forward(const Tuple& data);
@@ -101,6 +102,9 @@ public:
     /// Delegate write to a write function.
     void write_delegated(functor write);
 
+    /// The current write position, for verifying a presized write.
+    Iterator position() const;
+
     /// Utility for variable skipping of writer.
     size_t read_size_big_endian();
 
@@ -108,13 +112,20 @@ public:
     size_t read_size_little_endian();
 
 private:
+    bool claim(size_t size);
+
     bool valid_;
     Iterator iterator_;
+    size_t remaining_;
 };
 
 // Factories.
 //-----------------------------------------------------------------------------
 
+/// A serializer that is invalidated, without writing, by a write past end.
+template <typename Iterator>
+serializer<Iterator> make_safe_serializer(Iterator begin, Iterator end);
+
 template <typename Iterator>
 serializer<Iterator> make_unsafe_serializer(Iterator begin);
 
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SMALL_CHUNK_HPP
+#define LIBBITCOIN_SMALL_CHUNK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A byte vector that stores up to inline_capacity bytes within the object.
+ *
+ * Script pushes, stack items and witness elements are almost always keys,
+ * hashes or signatures (20, 32, 33, 65 or 72 bytes), so these are held
+ * without a heap allocation. Larger values spill to the heap. The interface
+ * follows data_chunk (std::vector<uint8_t>) and converts to data_slice.
+ */
+class BC_API small_chunk
+{
+private:
+    // Disambiguates iterator pairs from (size, value) and byte pointers.
+    template <typename Iterator>
+    using iterator_only = typename std::enable_if<
+        !std::is_integral<Iterator>::value &&
+        !std::is_convertible<Iterator, const uint8_t*>::value>::type;
+
+public:
+    static const size_t inline_capacity = 80;
+
+    typedef uint8_t value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef uint8_t& reference;
+    typedef const uint8_t& const_reference;
+    typedef uint8_t* pointer;
+    typedef const uint8_t* const_pointer;
+    typedef uint8_t* iterator;
+    typedef const uint8_t* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    small_chunk();
+    small_chunk(small_chunk&& other) BC_NOEXCEPT;
+    small_chunk(const small_chunk& other);
+    small_chunk(const data_chunk& other);
+    small_chunk(std::initializer_list<uint8_t> values);
+    explicit small_chunk(size_t size, uint8_t value=0);
+    small_chunk(const uint8_t* begin, const uint8_t* end);
+
+    template <typename Iterator, typename = iterator_only<Iterator>>
+    small_chunk(Iterator begin, Iterator end);
+
+    ~small_chunk();
+
+    // Operators.
+    //-------------------------------------------------------------------------
+
+    small_chunk& operator=(small_chunk&& other) BC_NOEXCEPT;
+    small_chunk& operator=(const small_chunk& other);
+    small_chunk& operator=(const data_chunk& other);
+    small_chunk& operator=(std::initializer_list<uint8_t> values);
+
+    uint8_t& operator[](size_t index);
+    const uint8_t& operator[](size_t index) const;
+
+    // Iterators.
+    //-------------------------------------------------------------------------
+
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    uint8_t* data();
+    const uint8_t* data() const;
+    uint8_t& front();
+    const uint8_t& front() const;
+    uint8_t& back();
+    const uint8_t& back() const;
+    size_t size() const;
+    size_t capacity() const;
+    bool empty() const;
+
+    /// True if the bytes are held within the object.
+    bool is_inline() const;
+
+    // Modifiers.
+    //-------------------------------------------------------------------------
+
+    void reserve(size_t size);
+    void resize(size_t size, uint8_t value=0);
+    void clear();
+    void shrink_to_fit();
+    void push_back(uint8_t value);
+    void pop_back();
+    void assign(size_t size, uint8_t value);
+    void assign(const uint8_t* begin, const uint8_t* end);
+    void assign(std::initializer_list<uint8_t> values);
+
+    template <typename Iterator, typename = iterator_only<Iterator>>
+    void assign(Iterator begin, Iterator end);
+
+    iterator insert(const_iterator position, uint8_t value);
+    iterator insert(const_iterator position, const uint8_t* begin,
+        const uint8_t* end);
+
+    template <typename Iterator, typename = iterator_only<Iterator>>
+    iterator insert(const_iterator position, Iterator begin, Iterator end);
+
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator begin, const_iterator end);
+    void swap(small_chunk& other);
+
+    /// Copy the bytes to a data_chunk.
+    data_chunk to_chunk() const;
+
+private:
+    void grow(size_t minimum);
+    void release();
+
+    uint8_t* begin_;
+    uint32_t size_;
+    uint32_t capacity_;
+    uint8_t buffer_[inline_capacity];
+};
+
+/// A stack of small chunks, as used by script evaluation and witnesses.
+typedef std::vector<small_chunk> small_stack;
+
+bool operator==(const small_chunk& left, const small_chunk& right);
+bool operator!=(const small_chunk& left, const small_chunk& right);
+bool operator<(const small_chunk& left, const small_chunk& right);
+bool operator==(const small_chunk& left, const data_chunk& right);
+bool operator!=(const small_chunk& left, const data_chunk& right);
+bool operator==(const data_chunk& left, const small_chunk& right);
+bool operator!=(const data_chunk& left, const small_chunk& right);
+
+/// Write the bytes as base16, for diagnostics.
+std::ostream& operator<<(std::ostream& output, const small_chunk& bytes);
+
+/// Create a small chunk from an iterable object.
+template <typename Source>
+small_chunk to_small_chunk(const Source& bytes);
+
+/// Copy a stack of small chunks to a data_stack.
+data_stack to_data_stack(const small_stack& stack);
+
+/// Copy a data_stack to a stack of small chunks.
+small_stack to_small_stack(const data_stack& stack);
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/small_chunk.ipp>
+
+#endif
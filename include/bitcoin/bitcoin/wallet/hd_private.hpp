@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -89,6 +90,12 @@ public:
     hd_private derive_private(uint32_t index) const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the secrets of count children, starting at first, without
+    /// their chain codes. The chain code key pads are hashed once for all.
+    /// False if the range spans the hardened boundary or a child is invalid.
+    bool derive_private_range(secret_list& out, uint32_t first,
+        size_t count) const;
+
 private:
     /// Factories.
     static hd_private from_seed(data_slice seed, uint64_t prefixes);
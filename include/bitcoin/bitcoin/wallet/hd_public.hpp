@@ -19,13 +19,16 @@
 #ifndef LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
 
 namespace libbitcoin {
 namespace wallet {
@@ -100,6 +103,21 @@ public:
     hd_key to_hd_key() const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the points of count non-hardened children, starting at first,
+    /// without their chain codes (e.g. for address gap scanning). The parent
+    /// point is parsed and the chain code key pads hashed once for all.
+    /// False if the range includes a hardened index or an invalid child.
+    bool derive_public_range(point_list& out, uint32_t first,
+        size_t count) const;
+
+    /// Derive the points concurrently in contiguous partitions, as above.
+    bool derive_public_range(point_list& out, uint32_t first, size_t count,
+        threadpool& pool) const;
+
+    /// Derive the payment addresses of the children, as above.
+    bool derive_public_range(payment_address::list& out, uint32_t first,
+        size_t count, uint8_t version=payment_address::mainnet_p2kh) const;
+
 protected:
     /// Factories.
     static hd_public from_secret(const ec_secret& secret,
@@ -108,6 +126,11 @@ protected:
     /// Helpers.
     uint32_t fingerprint() const;
 
+    /// The left half of the child hmac for count indexes from first, where
+    /// the prefix is the serialized parent key that precedes each index.
+    static void derive_tweaks(secret_list& out, data_slice prefix,
+        const hd_chain_code& chain_code, uint32_t first, size_t count);
+
     /// Members.
     /// These should be const, apart from the need to implement assignment.
     bool valid_;
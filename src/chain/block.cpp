@@ -19,6 +19,8 @@
 #include <bitcoin/bitcoin/chain/block.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <limits>
 #include <cfenv>
@@ -29,6 +31,7 @@
 #include <type_traits>
 #include <utility>
 #include <unordered_map>
+#include <vector>
 #include <boost/range/adaptor/reversed.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/compact.hpp>
@@ -38,6 +41,7 @@
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/formats/base_16.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/machine/number.hpp>
@@ -48,9 +52,12 @@
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/flat_hash_set.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -164,10 +171,36 @@ block block::factory(reader& source, bool witness)
     return instance;
 }
 
+// static
+block block::factory(const data_chunk& data,
+    const script_arena::ptr& memory, bool witness)
+{
+    block instance;
+    instance.from_data(data, memory, witness);
+    return instance;
+}
+
+// static
+block block::factory(reader& source, const script_arena::ptr& memory,
+    bool witness)
+{
+    block instance;
+    instance.from_data(source, memory, witness);
+    return instance;
+}
+
 bool block::from_data(const data_chunk& data, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, witness);
+    return from_data(data, nullptr, witness);
+}
+
+bool block::from_data(const data_chunk& data,
+    const script_arena::ptr& memory, bool witness)
+{
+    // Pointer iterators allow transaction hashes to be computed from source.
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, memory, witness);
 }
 
 bool block::from_data(std::istream& stream, bool witness)
@@ -176,8 +209,14 @@ bool block::from_data(std::istream& stream, bool witness)
     return from_data(source, witness);
 }
 
-// Full block deserialization is always canonical encoding.
 bool block::from_data(reader& source, bool witness)
+{
+    return from_data(source, nullptr, witness);
+}
+
+// Full block deserialization is always canonical encoding.
+bool block::from_data(reader& source, const script_arena::ptr& memory,
+    bool witness)
 {
     metadata.start_deserialize = asio::steady_clock::now();
     reset();
@@ -195,7 +234,7 @@ bool block::from_data(reader& source, bool witness)
 
     // Order is required, explicit loop allows early termination.
     for (auto& tx: transactions_)
-        if (!tx.from_data(source, true, witness))
+        if (!tx.from_data(source, memory, true, witness))
             break;
 
     // TODO: optimize by having reader skip witness data.
@@ -575,44 +614,39 @@ bool block::is_final(size_t height, uint32_t block_time) const
     return std::all_of(txs.begin(), txs.end(), value);
 }
 
-// Distinctness is defined by transaction hash.
 bool block::is_distinct_transaction_set() const
 {
-    const auto hasher = [](const transaction& tx) { return tx.hash(); };
-    const auto& txs = transactions_;
-    hash_list hashes(txs.size());
-    std::transform(txs.begin(), txs.end(), hashes.begin(), hasher);
-    std::sort(hashes.begin(), hashes.end());
-    const auto distinct_end = std::unique(hashes.begin(), hashes.end());
-    return distinct_end == hashes.end();
+    size_t transaction;
+    return is_distinct_transaction_set(transaction);
 }
 
-hash_digest block::generate_merkle_root(bool witness) const
+// Distinctness is defined by transaction hash.
+bool block::is_distinct_transaction_set(size_t& out_transaction) const
 {
-    if (transactions_.empty())
-        return null_hash;
-
-    hash_list update;
-    auto merkle = to_hashes(witness);
+    const auto hashes = to_hashes();
+    flat_hash_set<hash_digest> distinct(hashes.size());
 
-    // Initial capacity is half of the original list (clear doesn't reset).
-    update.reserve((merkle.size() + 1) / 2);
-
-    while (merkle.size() > 1)
+    for (size_t tx = 0; tx < hashes.size(); ++tx)
     {
-        // If number of hashes is odd, duplicate last hash in the list.
-        if (merkle.size() % 2 != 0)
-            merkle.push_back(merkle.back());
+        if (!distinct.insert(hashes[tx]))
+        {
+            out_transaction = tx;
+            return false;
+        }
+    }
 
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-            update.push_back(bitcoin_hash(build_chunk({ it[0], it[1] })));
+    return true;
+}
 
-        std::swap(merkle, update);
-        update.clear();
-    }
+hash_digest block::generate_merkle_root(bool witness) const
+{
+    // The tree is not retained, so each level is reduced in place.
+    return merkle_tree::reduce(to_hashes(witness));
+}
 
-    // There is now only one item in the list.
-    return merkle.front();
+merkle_tree block::generate_merkle_tree(bool witness) const
+{
+    return { to_hashes(witness) };
 }
 
 //****************************************************************************
@@ -638,27 +672,41 @@ bool block::is_forward_reference() const
     return false;
 }
 
-// This is an early check that is redundant with block pool accept checks.
 bool block::is_internal_double_spend() const
+{
+    size_t transaction;
+    size_t input;
+    return is_internal_double_spend(transaction, input);
+}
+
+// This is an early check that is redundant with block pool accept checks.
+// Prevouts are referenced in place, so the set is the only allocation.
+bool block::is_internal_double_spend(size_t& out_transaction,
+    size_t& out_input) const
 {
     if (transactions_.empty())
         return false;
 
-    point::list outs;
-    outs.reserve(total_non_coinbase_inputs());
+    point_set prevouts(total_non_coinbase_inputs());
     const auto& txs = transactions_;
 
     // Merge the prevouts of all non-coinbase transactions into one set.
-    for (auto tx = txs.begin() + 1; tx != txs.end(); ++tx)
+    for (size_t tx = 1; tx < txs.size(); ++tx)
     {
-        auto out = tx->previous_outputs();
-        std::move(out.begin(), out.end(), std::inserter(outs, outs.end()));
+        const auto& inputs = txs[tx].inputs();
+
+        for (size_t input = 0; input < inputs.size(); ++input)
+        {
+            if (!prevouts.insert(inputs[input].previous_output()))
+            {
+                out_transaction = tx;
+                out_input = input;
+                return true;
+            }
+        }
     }
 
-    std::sort(outs.begin(), outs.end());
-    const auto distinct_end = std::unique(outs.begin(), outs.end());
-    const auto distinct = (distinct_end == outs.end());
-    return !distinct;
+    return false;
 }
 
 bool block::is_valid_merkle_root() const
@@ -795,6 +843,126 @@ code block::connect_transactions(const chain_state& state) const
     return error::success;
 }
 
+// Standard key hash spends are prepared for batch signature verification.
+static bool prepare_signature(verify_job& out, const transaction& tx,
+    size_t input_index, uint32_t forks)
+{
+    const auto& prevout = tx.inputs()[input_index].previous_output().metadata;
+    const auto index32 = static_cast<uint32_t>(input_index);
+
+    // A missing previous output is left to connect_input.
+    return prevout.cache.is_valid() && script::prepare_signature(out, tx,
+        index32, forks, prevout.cache.script(), prevout.cache.value());
+}
+
+// Inputs are verified concurrently but the result is that of the first input
+// (in block order) to fail, so this is equivalent to the serial connect.
+code block::connect_transactions(const chain_state& state,
+    threadpool& pool) const
+{
+    // A single bucket would run on the calling thread.
+    if (pool.size() < 2)
+        return connect_transactions(state);
+
+    typedef std::pair<const transaction*, size_t> input_job;
+    std::vector<input_job> inputs;
+    inputs.reserve(total_inputs());
+
+    // Coinbase inputs are not verified (connect_input returns success).
+    for (const auto& tx: transactions_)
+        if (!tx.is_coinbase())
+            for (size_t index = 0; index < tx.inputs().size(); ++index)
+                inputs.emplace_back(&tx, index);
+
+    const auto size = inputs.size();
+    const auto forks = state.enabled_forks();
+    dispatcher dispatch(pool, "connect");
+
+    // Signatures are prepared in contiguous partitions, tagged by ordinal.
+    auto buckets = std::min(pool.size(), size);
+    std::vector<verify_job::list> prepared(buckets);
+
+    const auto prepare = [&](size_t bucket)
+    {
+        const auto first = bucket * size / buckets;
+        const auto last = (bucket + 1) * size / buckets;
+
+        for (auto ordinal = first; ordinal < last; ++ordinal)
+        {
+            const auto& input = inputs[ordinal];
+            verify_job job{ { nullptr, nullptr }, null_hash, {}, ordinal,
+                false };
+
+            if (prepare_signature(job, *input.first, input.second, forks))
+                prepared[bucket].push_back(job);
+        }
+    };
+
+    dispatch.partition(buckets, prepare);
+
+    verify_job::list signatures;
+    for (const auto& jobs: prepared)
+        signatures.insert(signatures.end(), jobs.begin(), jobs.end());
+
+    script::check_signatures(signatures, pool);
+
+    // Failed signatures are mapped back to their inputs by tag. These and all
+    // other inputs are interpreted, which determines the error of a failure.
+    std::vector<bool> verified(size, false);
+    for (const auto& job: signatures)
+        verified[job.tag] = job.valid;
+
+    std::vector<input_job> jobs;
+    jobs.reserve(size);
+
+    for (size_t ordinal = 0; ordinal < size; ++ordinal)
+        if (!verified[ordinal])
+            jobs.push_back(inputs[ordinal]);
+
+    buckets = std::min(pool.size(), jobs.size());
+
+    if (buckets == 0)
+    {
+        release_signature_hashes();
+        return error::success;
+    }
+
+    // Each bucket records its first failure, which is its lowest ordinal.
+    std::vector<code> codes(buckets, error::success);
+    std::vector<size_t> failures(buckets, jobs.size());
+
+    // Jobs are claimed in block order, stopping at the lowest known failure.
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> lowest(jobs.size());
+
+    const auto verify = [&](size_t bucket)
+    {
+        for (auto ordinal = next++; ordinal < lowest; ordinal = next++)
+        {
+            const auto& job = jobs[ordinal];
+            const auto ec = job.first->connect_input(state, job.second);
+
+            if (ec)
+            {
+                codes[bucket] = ec;
+                failures[bucket] = ordinal;
+                auto current = lowest.load();
+
+                while (ordinal < current &&
+                    !lowest.compare_exchange_weak(current, ordinal));
+
+                break;
+            }
+        }
+    };
+
+    dispatch.partition(buckets, verify);
+    release_signature_hashes();
+
+    const auto first = std::min_element(failures.begin(), failures.end());
+    return codes[std::distance(failures.begin(), first)];
+}
+
 // Validation.
 //-----------------------------------------------------------------------------
 
@@ -926,8 +1094,51 @@ code block::connect(const chain_state& state) const
     if (state.is_under_checkpoint())
         return error::success;
 
-    else
-        return connect_transactions(state);
+    const auto ec = connect_transactions(state);
+
+    if (!ec)
+        set_connect_rate();
+
+    return ec;
+}
+
+code block::connect(threadpool& pool) const
+{
+    const auto state = header_.metadata.state;
+    return state ? connect(*state, pool) : error::operation_failed;
+}
+
+code block::connect(const chain_state& state, threadpool& pool) const
+{
+    metadata.start_connect = asio::steady_clock::now();
+
+    if (state.is_under_checkpoint())
+        return error::success;
+
+    const auto ec = connect_transactions(state, pool);
+
+    if (!ec)
+        set_connect_rate();
+
+    return ec;
+}
+
+// private
+// Signature hash contexts are not retained with the block once verified.
+void block::release_signature_hashes() const
+{
+    for (const auto& tx: transactions_)
+        tx.release_signature_hashes();
+}
+
+// private
+void block::set_connect_rate() const
+{
+    typedef std::chrono::duration<float> seconds;
+    metadata.end_connect = asio::steady_clock::now();
+    const auto span = metadata.end_connect - metadata.start_connect;
+    const auto elapsed = std::chrono::duration_cast<seconds>(span).count();
+    metadata.connect_rate = elapsed > 0 ? total_inputs() / elapsed : 0;
 }
 
 } // namespace chain
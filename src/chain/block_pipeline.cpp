@@ -0,0 +1,280 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/block_pipeline.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/settings.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+const size_t block_pipeline::default_capacity = 8;
+
+block_pipeline::block_pipeline(threadpool& pool, const bc::settings& settings,
+    size_t capacity, bool scrypt)
+  : settings_(settings),
+    capacity_(std::max(capacity, size_t(1))),
+    scrypt_(scrypt),
+    stopped_(false),
+    failed_(max_size_t),
+    check_(),
+    accept_(),
+    connect_(),
+    check_dispatch_(pool, "check"),
+    accept_dispatch_(pool, "accept"),
+    connect_dispatch_(pool, "connect"),
+    next_(0),
+    in_flight_(0)
+{
+}
+
+block_pipeline::~block_pipeline()
+{
+    stop();
+    wait();
+}
+
+void block_pipeline::set_populator(populate_handler populator)
+{
+    populator_ = std::move(populator);
+}
+
+// Submission.
+//-----------------------------------------------------------------------------
+
+bool block_pipeline::push(block_const_ptr block, result_handler handler)
+{
+    auto job = std::make_shared<block_pipeline::job>();
+    job->block = block;
+    job->handler = std::move(handler);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Bound the memory held by the pipeline by applying back pressure.
+    completed_.wait(lock, [this]()
+    {
+        return stopped_ || in_flight_ < capacity_;
+    });
+
+    if (stopped_)
+        return false;
+
+    job->sequence = next_++;
+    ++in_flight_;
+
+    // Post under the lock so that strand order matches sequence order.
+    // The job is posted (not dispatched), so it cannot run on this thread.
+    enter(check_);
+    check_dispatch_.ordered(&block_pipeline::do_check, this, job);
+    lock.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void block_pipeline::stop()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopped_ = true;
+    lock.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Release any callers waiting on capacity.
+    completed_.notify_all();
+}
+
+void block_pipeline::wait() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    completed_.wait(lock, [this]()
+    {
+        return in_flight_ == 0;
+    });
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+size_t block_pipeline::in_flight() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+block_pipeline::statistics block_pipeline::stage_statistics(stage value) const
+{
+    const auto& counters = value == stage::check ? check_ :
+        (value == stage::accept ? accept_ : connect_);
+
+    return
+    {
+        counters.depth,
+        counters.completed,
+        asio::microseconds(counters.last.load()),
+        asio::microseconds(counters.total.load())
+    };
+}
+
+// Stages.
+//-----------------------------------------------------------------------------
+// Each stage is ordered on its own strand, so stages overlap across blocks
+// but each stage processes blocks one at a time and in submission order.
+
+void block_pipeline::do_check(job_ptr job)
+{
+    const auto start = asio::steady_clock::now();
+
+    if (!skip(*job))
+    {
+        job->ec = job->block->check(settings_.max_money(),
+            settings_.timestamp_limit_seconds, settings_.proof_of_work_limit,
+            scrypt_);
+
+        if (job->ec)
+            fail(*job);
+    }
+
+    leave(check_, start);
+    enter(accept_);
+    accept_dispatch_.ordered(&block_pipeline::do_accept, this, job);
+}
+
+void block_pipeline::do_accept(job_ptr job)
+{
+    const auto start = asio::steady_clock::now();
+
+    if (!skip(*job))
+    {
+        const auto& block = *job->block;
+
+        if (populator_)
+        {
+            block.metadata.start_populate = asio::steady_clock::now();
+            job->ec = populator_(block);
+        }
+
+        if (!job->ec)
+            job->ec = block.accept(settings_);
+
+        if (job->ec)
+            fail(*job);
+    }
+
+    leave(accept_, start);
+    enter(connect_);
+    connect_dispatch_.ordered(&block_pipeline::do_connect, this, job);
+}
+
+void block_pipeline::do_connect(job_ptr job)
+{
+    const auto start = asio::steady_clock::now();
+
+    if (!skip(*job))
+    {
+        job->ec = job->block->connect();
+
+        if (job->ec)
+            fail(*job);
+    }
+
+    leave(connect_, start);
+    job->handler(job->ec, job->block);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    // Notify under the lock, as a waiting destructor may then free this.
+    std::lock_guard<std::mutex> lock(mutex_);
+    --in_flight_;
+    completed_.notify_all();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Utilities.
+//-----------------------------------------------------------------------------
+
+// A block that has failed, or that follows a failed block, is not validated.
+bool block_pipeline::skip(job& job) const
+{
+    if (job.ec)
+        return true;
+
+    if (job.sequence > failed_)
+    {
+        job.ec = error::operation_failed;
+        return true;
+    }
+
+    if (stopped_)
+    {
+        job.ec = error::service_stopped;
+        return true;
+    }
+
+    return false;
+}
+
+// Record the lowest failed sequence, as later stages may fail out of order.
+void block_pipeline::fail(const job& job)
+{
+    auto current = failed_.load();
+
+    while (job.sequence < current &&
+        !failed_.compare_exchange_weak(current, job.sequence));
+}
+
+void block_pipeline::enter(counters& stage)
+{
+    ++stage.depth;
+}
+
+void block_pipeline::leave(counters& stage, const asio::time_point& start)
+{
+    const auto span = asio::steady_clock::now() - start;
+    const auto elapsed = std::chrono::duration_cast<asio::microseconds>(span);
+    stage.last = elapsed.count();
+    stage.total += elapsed.count();
+    ++stage.completed;
+    --stage.depth;
+}
+
+} // namespace chain
+} // namespace libbitcoin
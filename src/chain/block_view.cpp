@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/block_view.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/merkle_tree.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+static const size_t header_size = 80;
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+block_view::block_view()
+  : data_(nullptr, nullptr)
+{
+}
+
+// Deserialization.
+//-----------------------------------------------------------------------------
+
+bool block_view::from_data(data_slice data)
+{
+    reset();
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    source.skip(header_size);
+
+    auto offset = header_size + message::variable_prefix_size(
+        source.peek_byte());
+    const auto count = source.read_size_little_endian();
+
+    // Guard against potential for arbitary memory allocation.
+    if (!source || count > max_block_size)
+        return false;
+
+    transactions_.resize(count);
+
+    // Order is required, explicit loop allows early termination.
+    for (auto& tx: transactions_)
+    {
+        if (!tx.from_data({ data.begin() + offset, data.end() }))
+        {
+            reset();
+            return false;
+        }
+
+        offset += tx.serialized_size();
+    }
+
+    data_ = { data.begin(), data.begin() + offset };
+    return true;
+}
+
+bool block_view::is_valid() const
+{
+    return !data_.empty();
+}
+
+// private
+void block_view::reset()
+{
+    data_ = { nullptr, nullptr };
+    transactions_.clear();
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+data_slice block_view::data() const
+{
+    return data_;
+}
+
+size_t block_view::serialized_size() const
+{
+    return data_.size();
+}
+
+chain::header block_view::header() const
+{
+    BITCOIN_ASSERT(is_valid());
+    auto source = make_unsafe_deserializer(data_.begin());
+    chain::header header;
+    header.from_data(source, true);
+    return header;
+}
+
+hash_digest block_view::hash() const
+{
+    BITCOIN_ASSERT(is_valid());
+    return bitcoin_hash({ data_.begin(), data_.begin() + header_size });
+}
+
+const transaction_view::list& block_view::transactions() const
+{
+    return transactions_;
+}
+
+// Validation.
+//-----------------------------------------------------------------------------
+
+hash_list block_view::to_hashes(bool witness) const
+{
+    hash_list out;
+    out.reserve(transactions_.size());
+
+    for (const auto& tx: transactions_)
+        out.push_back(tx.hash(witness));
+
+    return out;
+}
+
+hash_digest block_view::generate_merkle_root(bool witness) const
+{
+    return merkle_tree::reduce(to_hashes(witness));
+}
+
+// Points are decoded from the buffer, scripts are not decoded.
+bool block_view::is_internal_double_spend() const
+{
+    if (transactions_.empty())
+        return false;
+
+    const auto& txs = transactions_;
+    const auto sum = [](size_t total, const transaction_view& tx)
+    {
+        return total + tx.inputs();
+    };
+
+    // The decoded prevouts are held in place, as the set references them.
+    point::list outs;
+    outs.reserve(std::accumulate(txs.begin() + 1, txs.end(), size_t(0), sum));
+    point_set prevouts(outs.capacity());
+
+    // Merge the prevouts of all non-coinbase transactions into one set.
+    for (auto tx = txs.begin() + 1; tx != txs.end(); ++tx)
+    {
+        for (size_t input = 0; input < tx->inputs(); ++input)
+        {
+            outs.push_back(tx->previous_output(input));
+
+            if (!prevouts.insert(outs.back()))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+block block_view::to_block(bool witness) const
+{
+    block instance;
+    auto source = make_safe_deserializer(data_.begin(), data_.end());
+    instance.from_data(source, witness);
+    return instance;
+}
+
+} // namespace chain
+} // namespace libbitcoin
@@ -19,10 +19,10 @@
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
-#include <boost/multiprecision/integer.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
@@ -75,42 +75,70 @@ inline uint32_t bits_high(const chain_state::data& values)
     return values.bits.ordered.back();
 }
 
+//*****************************************************************************
+// CONSENSUS: Though unspecified in bip34, the satoshi implementation
+// performed this comparison using the signed integer version value.
+//*****************************************************************************
+inline size_t signals(uint32_t value, uint32_t version)
+{
+    return static_cast<int32_t>(value) >= static_cast<int32_t>(version) ?
+        1 : 0;
+}
+
+// Returns the number of sorted times, or zero if the sample does not fit.
+inline size_t sort_times(std::array<uint32_t, median_time_past_interval>& times,
+    const chain_state::timestamps& ordered)
+{
+    if (ordered.size() > times.size())
+        return 0;
+
+    std::copy(ordered.begin(), ordered.end(), times.begin());
+    std::sort(times.begin(), times.begin() + ordered.size());
+    return ordered.size();
+}
+
 // activation
 //-----------------------------------------------------------------------------
 
+chain_state::samples chain_state::summarize(const data& values,
+    const bc::settings& settings)
+{
+    samples sample;
+    sample.count_2 = 0;
+    sample.count_3 = 0;
+    sample.count_4 = 0;
+
+    // Compute bip34-based activation version summaries.
+    for (const auto version: values.version.ordered)
+    {
+        sample.count_2 += signals(version, settings.bip34_version);
+        sample.count_3 += signals(version, settings.bip66_version);
+        sample.count_4 += signals(version, settings.bip65_version);
+    }
+
+    sample.times_count = sort_times(sample.times, values.timestamp.ordered);
+    return sample;
+}
+
 chain_state::activations chain_state::activation(const data& values,
     uint32_t forks, const bc::settings& settings)
+{
+    return activation(values, summarize(values, settings), forks, settings);
+}
+
+chain_state::activations chain_state::activation(const data& values,
+    const samples& sample, uint32_t forks, const bc::settings& settings)
 {
     const auto height = values.height;
     const auto version = values.version.self;
-    const auto& history = values.version.ordered;
+    const auto count_2 = sample.count_2;
+    const auto count_3 = sample.count_3;
+    const auto count_4 = sample.count_4;
     const auto frozen = script::is_enabled(forks, rule_fork::bip90_rule);
     const auto difficult = script::is_enabled(forks, rule_fork::difficult);
     const auto retarget = script::is_enabled(forks, rule_fork::retarget);
     const auto mainnet = retarget && difficult;
 
-    //*************************************************************************
-    // CONSENSUS: Though unspecified in bip34, the satoshi implementation
-    // performed this comparison using the signed integer version value.
-    //*************************************************************************
-    const auto ge = [](uint32_t value, uint32_t version)
-    {
-        return static_cast<int32_t>(value) >= static_cast<int32_t>(version);
-    };
-
-    // Declare bip34-based version predicates.
-    const auto ge_2 = [=](uint32_t value) { return ge(value,
-        settings.bip34_version); };
-    const auto ge_3 = [=](uint32_t value) { return ge(value,
-        settings.bip66_version); };
-    const auto ge_4 = [=](uint32_t value) { return ge(value,
-        settings.bip65_version); };
-
-    // Compute bip34-based activation version summaries.
-    const auto count_2 = std::count_if(history.begin(), history.end(), ge_2);
-    const auto count_3 = std::count_if(history.begin(), history.end(), ge_3);
-    const auto count_4 = std::count_if(history.begin(), history.end(), ge_4);
-
     // Frozen activations (require version and enforce above freeze height).
     const auto bip34_ice = frozen && height >= settings.bip34_freeze;
     const auto bip66_ice = frozen && height >= settings.bip66_freeze;
@@ -288,6 +316,18 @@ uint32_t chain_state::median_time_past(const data& values, uint32_t)
     return times.empty() ? 0 : times[times.size() / 2];
 }
 
+uint32_t chain_state::median_time_past(const data& values,
+    const samples& sample)
+{
+    const auto count = values.timestamp.ordered.size();
+
+    // Fall back to sorting if the sample exceeds the median interval.
+    if (sample.times_count != count)
+        return median_time_past(values, 0);
+
+    return count == 0 ? 0 : sample.times[count / 2];
+}
+
 // work_required
 //-----------------------------------------------------------------------------
 
@@ -330,9 +370,8 @@ uint32_t chain_state::work_required_retarget(const data& values, uint32_t forks,
     uint256_t target(bits);
     const auto retarget_overflow = script::is_enabled(forks,
         rule_fork::retarget_overflow_patch);
-    using namespace boost::multiprecision;
-    const auto shift = retarget_overflow && (msb(target) + 1 > msb(pow_limit)) ?
-        1u : 0u;
+    const auto shift = retarget_overflow &&
+        (target.bit_length() + 1 > pow_limit.bit_length()) ? 1u : 0u;
     target >>= shift;
     target *= retarget_timespan(values, minimum_timespan, maximum_timespan);
     target /= retargeting_interval_seconds;
@@ -527,6 +566,7 @@ chain_state::data chain_state::to_pool(const chain_state& top,
     const auto retarget = script::is_enabled(forks, rule_fork::retarget);
 
     // Copy data from presumed previous-height block state.
+    // The ordered collections share storage, so this does not copy values.
     auto data = top.data_;
 
     // If this overflows height is zero and result is handled as invalid.
@@ -571,6 +611,72 @@ chain_state::data chain_state::to_pool(const chain_state& top,
     return data;
 }
 
+// Promote summaries in step with the values promoted by to_pool, which
+// enqueues the previous self value and dequeues at most the oldest value.
+chain_state::samples chain_state::to_samples(const chain_state& parent,
+    const data& values, const bc::settings& settings)
+{
+    auto sample = parent.samples_;
+    const auto& prior = parent.data_;
+
+    const auto& prior_versions = prior.version.ordered;
+    const auto version_dequeued = values.version.ordered.size() <=
+        prior_versions.size();
+
+    // The enqueued value is dequeued when the collection was empty.
+    const auto version_in = prior.version.self;
+    const auto version_out = version_dequeued && !prior_versions.empty() ?
+        prior_versions.front() : version_in;
+
+    sample.count_2 += signals(version_in, settings.bip34_version);
+    sample.count_3 += signals(version_in, settings.bip66_version);
+    sample.count_4 += signals(version_in, settings.bip65_version);
+
+    if (version_dequeued)
+    {
+        sample.count_2 -= signals(version_out, settings.bip34_version);
+        sample.count_3 -= signals(version_out, settings.bip66_version);
+        sample.count_4 -= signals(version_out, settings.bip65_version);
+    }
+
+    const auto& prior_times = prior.timestamp.ordered;
+    const auto& times = values.timestamp.ordered;
+
+    // Sort the full sample if the parent sample is not maintained.
+    if (sample.times_count != prior_times.size() ||
+        times.size() > sample.times.size())
+    {
+        sample.times_count = sort_times(sample.times, times);
+        return sample;
+    }
+
+    const auto first = sample.times.begin();
+    const auto time_dequeued = times.size() <= prior_times.size();
+
+    // Remove the dequeued time, one of any equal times suffices.
+    if (time_dequeued && !prior_times.empty())
+    {
+        const auto last = first + sample.times_count;
+        const auto it = std::lower_bound(first, last, prior_times.front());
+        BITCOIN_ASSERT(it != last);
+        std::copy(it + 1, last, it);
+        --sample.times_count;
+    }
+
+    // Insert the enqueued time in order.
+    if (!time_dequeued || !prior_times.empty())
+    {
+        const auto time_in = prior.timestamp.self;
+        const auto last = first + sample.times_count;
+        const auto it = std::upper_bound(first, last, time_in);
+        std::copy_backward(it, last, last + 1);
+        *it = time_in;
+        ++sample.times_count;
+    }
+
+    return sample;
+}
+
 // Constructor (top to pool).
 // This generates a state for the pool above the presumed top block state.
 chain_state::chain_state(const chain_state& top, const bc::settings& settings)
@@ -578,9 +684,10 @@ chain_state::chain_state(const chain_state& top, const bc::settings& settings)
     forks_(top.forks_),
     stale_seconds_(top.stale_seconds_),
     checkpoints_(top.checkpoints_),
-    active_(activation(data_, forks_, settings)),
+    samples_(to_samples(top, data_, settings)),
+    active_(activation(data_, samples_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_time_past_(median_time_past(data_, samples_))
 {
 }
 
@@ -619,9 +726,10 @@ chain_state::chain_state(const chain_state& pool, const block& block,
     forks_(pool.forks_),
     stale_seconds_(pool.stale_seconds_),
     checkpoints_(pool.checkpoints_),
-    active_(activation(data_, forks_, settings)),
+    samples_(pool.samples_),
+    active_(activation(data_, samples_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_time_past_(median_time_past(data_, samples_))
 {
 }
 
@@ -659,9 +767,10 @@ chain_state::chain_state(const chain_state& parent, const header& header,
     forks_(parent.forks_),
     stale_seconds_(parent.stale_seconds_),
     checkpoints_(parent.checkpoints_),
-    active_(activation(data_, forks_, settings)),
+    samples_(to_samples(parent, data_, settings)),
+    active_(activation(data_, samples_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_time_past_(median_time_past(data_, samples_))
 {
 }
 
@@ -672,9 +781,10 @@ chain_state::chain_state(data&& values, const checkpoints& checkpoints,
     forks_(forks),
     stale_seconds_(stale_seconds),
     checkpoints_(checkpoints),
-    active_(activation(data_, forks_, settings)),
+    samples_(summarize(data_, settings)),
+    active_(activation(data_, samples_, forks_, settings)),
     work_required_(work_required(data_, forks_, settings)),
-    median_time_past_(median_time_past(data_, forks_))
+    median_time_past_(median_time_past(data_, samples_))
 {
 }
 
@@ -27,7 +27,7 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -46,7 +46,7 @@ header::header()
 }
 
 header::header(header&& other)
-  : hash_(other.hash_cache()),
+  : hash_(std::move(other.hash_)),
     version_(other.version_),
     previous_block_hash_(std::move(other.previous_block_hash_)),
     merkle_(std::move(other.merkle_)),
@@ -58,7 +58,7 @@ header::header(header&& other)
 }
 
 header::header(const header& other)
-  : hash_(other.hash_cache()),
+  : hash_(other.hash_),
     version_(other.version_),
     previous_block_hash_(other.previous_block_hash_),
     merkle_(other.merkle_),
@@ -94,19 +94,12 @@ header::header(uint32_t version, const hash_digest& previous_block_hash,
 {
 }
 
-// Private cache access for copy/move construction.
-header::hash_ptr header::hash_cache() const
-{
-    shared_lock lock(mutex_);
-    return hash_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 header& header::operator=(header&& other)
 {
-    hash_ = other.hash_cache();
+    hash_ = std::move(other.hash_);
     version_ = other.version_;
     previous_block_hash_ = std::move(other.previous_block_hash_);
     merkle_ = std::move(other.merkle_);
@@ -119,7 +112,7 @@ header& header::operator=(header&& other)
 
 header& header::operator=(const header& other)
 {
-    hash_ = other.hash_cache();
+    hash_ = other.hash_;
     version_ = other.version_;
     previous_block_hash_ = other.previous_block_hash_;
     merkle_ = other.merkle_;
@@ -190,8 +183,8 @@ header header::factory(reader& source, const hash_digest& hash, bool wire)
 
 bool header::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source, wire);
 }
 
 bool header::from_data(std::istream& stream, bool wire)
@@ -222,7 +215,7 @@ bool header::from_data(reader& source, hash_digest&& hash, bool wire)
     if (!from_data(source, wire))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(std::move(hash));
+    hash_.set(std::move(hash));
     return true;
 }
 
@@ -231,7 +224,7 @@ bool header::from_data(reader& source, const hash_digest& hash, bool wire)
     if (!from_data(source, wire))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.set(hash);
     return true;
 }
 
@@ -394,43 +387,15 @@ void header::set_nonce(uint32_t value)
 // protected
 void header::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (hash_)
-    {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    hash_.reset();
 }
 
 hash_digest header::hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (!hash_)
+    return hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-        hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_data()));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    const auto hash = *hash_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        return bitcoin_hash(to_data());
+    });
 }
 
 // Validation helpers.
@@ -24,7 +24,7 @@
 #include <bitcoin/bitcoin/chain/witness.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
@@ -46,7 +46,7 @@ input::input()
 }
 
 input::input(input&& other)
-  : addresses_(other.addresses_cache()),
+  : addresses_(std::move(other.addresses_)),
     previous_output_(std::move(other.previous_output_)),
     script_(std::move(other.script_)),
     witness_(std::move(other.witness_)),
@@ -55,7 +55,7 @@ input::input(input&& other)
 }
 
 input::input(const input& other)
-  : addresses_(other.addresses_cache()),
+  : addresses_(other.addresses_),
     previous_output_(other.previous_output_),
     script_(std::move(other.script_)),
     witness_(other.witness_),
@@ -79,13 +79,6 @@ input::input(const output_point& previous_output, const chain::script& script,
 {
 }
 
-// Private cache access for copy/move construction.
-input::addresses_ptr input::addresses_cache() const
-{
-    shared_lock lock(mutex_);
-    return addresses_;
-}
-
 input::input(output_point&& previous_output, chain::script&& script,
     chain::witness&& witness, uint32_t sequence)
   : previous_output_(std::move(previous_output)), script_(std::move(script)),
@@ -105,7 +98,7 @@ input::input(const output_point& previous_output, const chain::script& script,
 
 input& input::operator=(input&& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = std::move(other.addresses_);
     previous_output_ = std::move(other.previous_output_);
     script_ = std::move(other.script_);
     witness_ = std::move(other.witness_);
@@ -115,7 +108,7 @@ input& input::operator=(input&& other)
 
 input& input::operator=(const input& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = other.addresses_;
     previous_output_ = other.previous_output_;
     script_ = other.script_;
     witness_ = other.witness_;
@@ -162,8 +155,8 @@ input input::factory(reader& source, bool wire, bool witness)
 
 bool input::from_data(const data_chunk& data, bool wire, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, wire, witness);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source, wire, witness);
 }
 
 bool input::from_data(std::istream& stream, bool wire, bool witness)
@@ -173,6 +166,12 @@ bool input::from_data(std::istream& stream, bool wire, bool witness)
 }
 
 bool input::from_data(reader& source, bool wire, bool witness)
+{
+    return from_data(source, nullptr, wire, witness);
+}
+
+bool input::from_data(reader& source, const script_arena::ptr& memory,
+    bool wire, bool witness)
 {
     // Always write witness to store so that we know how to read it.
     witness |= !wire;
@@ -182,7 +181,7 @@ bool input::from_data(reader& source, bool wire, bool witness)
     if (!previous_output_.from_data(source, wire))
         return false;
 
-    script_.from_data(source, true);
+    script_.from_data(source, memory, true);
 
     // Transaction from_data handles the discontiguous wire witness decoding.
     if (witness && !wire)
@@ -333,21 +332,7 @@ void input::set_sequence(uint32_t value)
 // protected
 void input::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (addresses_)
-    {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        addresses_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    addresses_.reset();
 }
 
 payment_address input::address() const
@@ -358,27 +343,11 @@ payment_address input::address() const
 
 payment_address::list input::addresses() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (!addresses_)
+    return addresses_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-
         // TODO: expand to include segregated witness address extraction.
-        addresses_ = std::make_shared<payment_address::list>(
-            payment_address::extract_input(script_));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    const auto addresses = *addresses_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return addresses;
+        return payment_address::extract_input(script_);
+    });
 }
 
 // Utilities.
@@ -480,7 +449,7 @@ bool input::extract_embedded_script(chain::script& out) const
 
     // Parse the embedded script from the last input script item (data).
     // This cannot fail because there is no prefix to invalidate the length.
-    return out.from_data(ops.back().data(), false);
+    return out.from_data(ops.back().data().to_chunk(), false);
 }
 
 bool input::extract_reserved_hash(hash_digest& out) const
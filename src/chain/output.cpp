@@ -24,7 +24,7 @@
 #include <sstream>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
@@ -54,7 +54,7 @@ output::output()
 
 output::output(output&& other)
   : metadata(other.metadata),
-    addresses_(other.addresses_cache()),
+    addresses_(std::move(other.addresses_)),
     value_(other.value_),
     script_(std::move(other.script_))
 {
@@ -62,7 +62,7 @@ output::output(output&& other)
 
 output::output(const output& other)
   : metadata(other.metadata),
-    addresses_(other.addresses_cache()),
+    addresses_(other.addresses_),
     value_(other.value_),
     script_(other.script_)
 {
@@ -82,19 +82,13 @@ output::output(uint64_t value, const chain::script& script)
 {
 }
 
-// Private cache access for copy/move construction.
-output::addresses_ptr output::addresses_cache() const
-{
-    shared_lock lock(mutex_);
-    return addresses_;
-}
 
 // Operators.
 //-----------------------------------------------------------------------------
 
 output& output::operator=(output&& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = std::move(other.addresses_);
     value_ = other.value_;
     script_ = std::move(other.script_);
     metadata = std::move(other.metadata);
@@ -103,7 +97,7 @@ output& output::operator=(output&& other)
 
 output& output::operator=(const output& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = other.addresses_;
     value_ = other.value_;
     script_ = other.script_;
     metadata = other.metadata;
@@ -146,8 +140,8 @@ output output::factory(reader& source, bool wire)
 
 bool output::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source, wire);
 }
 
 bool output::from_data(std::istream& stream, bool wire)
@@ -156,7 +150,13 @@ bool output::from_data(std::istream& stream, bool wire)
     return from_data(source, wire);
 }
 
-bool output::from_data(reader& source, bool wire, bool)
+bool output::from_data(reader& source, bool wire, bool unused)
+{
+    return from_data(source, nullptr, wire, unused);
+}
+
+bool output::from_data(reader& source, const script_arena::ptr& memory,
+    bool wire, bool)
 {
     reset();
 
@@ -172,7 +172,7 @@ bool output::from_data(reader& source, bool wire, bool)
     }
 
     value_ = source.read_8_bytes_little_endian();
-    script_.from_data(source, true);
+    script_.from_data(source, memory, true);
 
     if (!source)
         reset();
@@ -274,21 +274,7 @@ void output::set_script(chain::script&& value)
 // protected
 void output::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (addresses_)
-    {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        addresses_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    addresses_.reset();
 }
 
 payment_address output::address(uint8_t p2kh_version,
@@ -301,26 +287,11 @@ payment_address output::address(uint8_t p2kh_version,
 payment_address::list output::addresses(uint8_t p2kh_version,
     uint8_t p2sh_version) const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (!addresses_)
+    return addresses_.get([&]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-        addresses_ = std::make_shared<payment_address::list>(
-            payment_address::extract_output(script_, p2kh_version,
-                p2sh_version));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    const auto addresses = *addresses_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return addresses;
+        return payment_address::extract_output(script_, p2kh_version,
+            p2sh_version);
+    });
 }
 
 // Validation helpers.
@@ -26,6 +26,7 @@
 #include <numeric>
 #include <sstream>
 #include <utility>
+#include <vector>
 #include <boost/range/adaptor/reversed.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
@@ -35,6 +36,7 @@
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/machine/interpreter.hpp>
+#include <bitcoin/bitcoin/machine/number.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/program.hpp>
@@ -42,11 +44,13 @@
 #include <bitcoin/bitcoin/machine/script_pattern.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
 #include <bitcoin/bitcoin/machine/sighash_algorithm.hpp>
+#include <bitcoin/bitcoin/machine/validation_cache.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
@@ -61,43 +65,45 @@ using namespace boost::adaptors;
 static const auto one_hash = hash_literal(
     "0000000000000000000000000000000000000000000000000000000000000001");
 
+// The default number of cached signature verifications (about 8MB).
+static BC_CONSTEXPR size_t signature_cache_capacity = 65536;
+
 // Constructors.
 //-----------------------------------------------------------------------------
 
 // A default instance is invalid (until modified).
 script::script()
-  : cached_(false),
-    valid_(false)
+  : arena_(false), valid_(false)
 {
+    new (&bytes_) data_chunk;
 }
 
 script::script(script&& other)
-  : operations_(std::move(other.operations_move())),
-    cached_(!operations_.empty()),
-    bytes_(std::move(other.bytes_)),
-    valid_(other.valid_)
+  : script()
 {
+    *this = std::move(other);
 }
 
 script::script(const script& other)
-  : operations_(other.operations_copy()),
-    cached_(!operations_.empty()),
-    bytes_(other.bytes_),
-    valid_(other.valid_)
+  : script()
 {
+    *this = other;
 }
 
 script::script(const operation::list& ops)
+  : script()
 {
     from_operations(ops);
 }
 
 script::script(operation::list&& ops)
+  : script()
 {
     from_operations(std::move(ops));
 }
 
 script::script(data_chunk&& encoded, bool prefix)
+  : script()
 {
     if (prefix)
     {
@@ -106,56 +112,68 @@ script::script(data_chunk&& encoded, bool prefix)
     }
 
     // This is an optimization that avoids streaming the encoded bytes.
-    bytes_ = std::move(encoded);
-    cached_ = false;
+    set_bytes(std::move(encoded));
     valid_ = true;
 }
 
 script::script(const data_chunk& encoded, bool prefix)
+  : script()
 {
     valid_ = from_data(encoded, prefix);
 }
 
-// Private cache access for move construction.
-script::operation::list& script::operations_move()
-{
-    shared_lock lock(mutex_);
-    return operations_;
-}
-
-// Private cache access for copy construction.
-const script::operation::list& script::operations_copy() const
+script::~script()
 {
-    shared_lock lock(mutex_);
-    return operations_;
+    destroy_bytes();
 }
 
 // Operators.
 //-----------------------------------------------------------------------------
 
 // Concurrent read/write is not supported, so no critical section.
+// Arena bytes move with the arena reference, owned bytes move with the heap.
 script& script::operator=(script&& other)
 {
-    operations_ = other.operations_move();
-    cached_ = !operations_.empty();
-    bytes_ = std::move(other.bytes_);
+    if (this == &other)
+        return *this;
+
+    if (other.arena_)
+    {
+        const auto& view = *reinterpret_cast<const arena_bytes*>(
+            &other.bytes_);
+        set_bytes(view.memory, view.data, view.size);
+        other.set_bytes(data_chunk{});
+    }
+    else
+    {
+        set_bytes(std::move(other.owned_bytes()));
+    }
+
+    operations_ = std::move(other.operations_);
     valid_ = other.valid_;
     return *this;
 }
 
 // Concurrent read/write is not supported, so no critical section.
+// The copy is owned, so it neither retains nor allocates from an arena.
 script& script::operator=(const script& other)
 {
-    operations_ = other.operations_copy();
-    cached_ = !operations_.empty();
-    bytes_ = other.bytes_;
+    if (this == &other)
+        return *this;
+
+    const auto data = other.bytes();
+    set_bytes(data_chunk(data.begin(), data.end()));
+    operations_ = other.operations_;
     valid_ = other.valid_;
     return *this;
 }
 
 bool script::operator==(const script& other) const
 {
-    return bytes_ == other.bytes_;
+    const auto left = bytes();
+    const auto right = other.bytes();
+    return left.size() == right.size() &&
+        std::equal(left.begin(), left.end(), right.begin());
 }
 
 bool script::operator!=(const script& other) const
@@ -192,8 +210,10 @@ script script::factory(reader& source, bool prefix)
 
 bool script::from_data(const data_chunk& encoded, bool prefix)
 {
-    data_source istream(encoded);
-    return from_data(istream, prefix);
+    // Pointer iterators allow the script to be copied from the source.
+    const auto begin = encoded.data();
+    auto source = make_safe_deserializer(begin, begin + encoded.size());
+    return from_data(source, prefix);
 }
 
 bool script::from_data(std::istream& stream, bool prefix)
@@ -202,8 +222,14 @@ bool script::from_data(std::istream& stream, bool prefix)
     return from_data(source, prefix);
 }
 
-// Concurrent read/write is not supported, so no critical section.
 bool script::from_data(reader& source, bool prefix)
+{
+    return from_data(source, nullptr, prefix);
+}
+
+// Concurrent read/write is not supported, so no critical section.
+bool script::from_data(reader& source, const script_arena::ptr& memory,
+    bool prefix)
 {
     reset();
     valid_ = true;
@@ -211,17 +237,35 @@ bool script::from_data(reader& source, bool prefix)
     if (prefix)
     {
         const auto size = source.read_size_little_endian();
+        const auto begin = source.position();
 
         // The max_script_size constant limits evaluation, but not all scripts
         // evaluate, so use max_block_size to guard memory allocation here.
         if (size > max_block_size)
+        {
             source.invalidate();
+        }
+        else if (!memory || begin == nullptr)
+        {
+            set_bytes(source.read_bytes(size));
+        }
         else
-            bytes_ = source.read_bytes(size);
+        {
+            // Copy from an addressable source, avoiding an interim buffer.
+            source.skip(size);
+
+            if (source)
+            {
+                const auto data = static_cast<uint8_t*>(
+                    memory->allocate(size, 1));
+                std::copy(begin, begin + size, data);
+                set_bytes(memory, data, size);
+            }
+        }
     }
     else
     {
-        bytes_ = source.read_bytes();
+        set_bytes(source.read_bytes());
     }
 
     if (!source)
@@ -253,9 +297,8 @@ bool script::from_string(const std::string& mnemonic)
 void script::from_operations(operation::list&& ops)
 {
     ////reset();
-    bytes_ = operations_to_data(ops);
-    operations_ = std::move(ops);
-    cached_ = true;
+    set_bytes(operations_to_data(ops));
+    operations_.set(std::move(ops));
     valid_ = true;
 }
 
@@ -263,9 +306,8 @@ void script::from_operations(operation::list&& ops)
 void script::from_operations(const operation::list& ops)
 {
     ////reset();
-    bytes_ = operations_to_data(ops);
-    operations_ = ops;
-    cached_ = true;
+    set_bytes(operations_to_data(ops));
+    operations_.set(ops);
     valid_ = true;
 }
 
@@ -301,12 +343,62 @@ size_t script::serialized_size(const operation::list& ops)
 // Concurrent read/write is not supported, so no critical section.
 void script::reset()
 {
-    bytes_.clear();
-    bytes_.shrink_to_fit();
+    set_bytes(data_chunk{});
     valid_ = false;
-    cached_ = false;
-    operations_.clear();
-    operations_.shrink_to_fit();
+    operations_.reset();
+}
+
+// private
+data_slice script::bytes() const
+{
+    if (!arena_)
+        return *reinterpret_cast<const data_chunk*>(&bytes_);
+
+    const auto& view = *reinterpret_cast<const arena_bytes*>(&bytes_);
+    return { view.data, view.data + view.size };
+}
+
+// private
+// Arena bytes are not modified in place, they are first copied to the heap.
+data_chunk& script::owned_bytes()
+{
+    if (arena_)
+    {
+        const auto data = bytes();
+        set_bytes(data_chunk(data.begin(), data.end()));
+    }
+
+    return *reinterpret_cast<data_chunk*>(&bytes_);
+}
+
+// private
+void script::set_bytes(data_chunk&& bytes)
+{
+    // The bytes may be owned by this script, so move them out first.
+    data_chunk owned(std::move(bytes));
+    destroy_bytes();
+    new (&bytes_) data_chunk(std::move(owned));
+    arena_ = false;
+}
+
+// private
+void script::set_bytes(const script_arena::ptr& memory, const uint8_t* data,
+    size_t size)
+{
+    // The memory may be retained by this script, so reference it first.
+    arena_bytes view{ data, size, memory };
+    destroy_bytes();
+    new (&bytes_) arena_bytes(std::move(view));
+    arena_ = true;
+}
+
+// private
+void script::destroy_bytes()
+{
+    if (arena_)
+        reinterpret_cast<arena_bytes*>(&bytes_)->~arena_bytes();
+    else
+        reinterpret_cast<data_chunk*>(&bytes_)->~data_chunk();
 }
 
 bool script::is_valid() const
@@ -320,7 +412,8 @@ bool script::is_valid_operations() const
 {
     // Script validity is independent of individual operation validity.
     // There is a trailing invalid/default op if a push op had a size mismatch.
-    return operations().empty() || operations_.back().is_valid();
+    const auto& ops = operations();
+    return ops.empty() || ops.back().is_valid();
 }
 
 // Serialization.
@@ -350,7 +443,7 @@ void script::to_data(writer& sink, bool prefix) const
     if (prefix)
         sink.write_variable_little_endian(serialized_size(false));
 
-    sink.write_bytes(bytes_);
+    sink.write_bytes(bytes());
 }
 
 std::string script::to_string(uint32_t active_forks) const
@@ -421,7 +514,7 @@ operation::iterator script::end() const
 
 size_t script::serialized_size(bool prefix) const
 {
-    auto size = bytes_.size();
+    auto size = bytes().size();
 
     if (prefix)
         size += message::variable_uint_size(size);
@@ -432,66 +525,41 @@ size_t script::serialized_size(bool prefix) const
 // protected
 const operation::list& script::operations() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (cached_)
+    return operations_.get([this]()
     {
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return operations_;
-    }
-
-    operation op;
-    data_source istream(bytes_);
-    istream_reader source(istream);
-    const auto size = bytes_.size();
-
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    mutex_.unlock_upgrade_and_lock();
-
-    // One operation per byte is the upper limit of operations.
-    operations_.reserve(size);
-
-    // ************************************************************************
-    // CONSENSUS: In the case of a coinbase script we must parse the entire
-    // script, beyond just the BIP34 requirements, so that sigops can be
-    // calculated from the script. These are counted despite being irrelevant.
-    // In this case an invalid script is parsed to the extent possible.
-    // ************************************************************************
-
-    // If an op fails it is pushed to operations and the loop terminates.
-    // To validate the ops the caller must test the last op.is_valid(), or may
-    // text script.is_valid_operations(), which is done in script metadata.
-    while (!source.is_exhausted())
-    {
-        op.from_data(source);
-        operations_.push_back(std::move(op));
-    }
-
-    operations_.shrink_to_fit();
-    cached_ = true;
-
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
+        operation op;
+        operation::list ops;
+        const auto data = bytes();
+        auto source = make_safe_deserializer(data.begin(), data.end());
+
+        // One operation per byte is the upper limit of operations.
+        ops.reserve(data.size());
+
+        // ********************************************************************
+        // CONSENSUS: In the case of a coinbase script we must parse the entire
+        // script, beyond just the BIP34 requirements, so that sigops can be
+        // calculated from the script. These are counted despite being
+        // irrelevant. In this case an invalid script is parsed to the extent
+        // possible.
+        // ********************************************************************
+
+        // If an op fails it is pushed to operations and the loop terminates.
+        // To validate the ops the caller must test the last op.is_valid(), or
+        // may text script.is_valid_operations(), which is done in metadata.
+        while (!source.is_exhausted())
+        {
+            op.from_data(source);
+            ops.push_back(std::move(op));
+        }
 
-    return operations_;
+        ops.shrink_to_fit();
+        return ops;
+    });
 }
 
 // Signing (unversioned).
 //-----------------------------------------------------------------------------
 
-inline hash_digest signature_hash(const transaction& tx, uint32_t sighash_type)
-{
-    // There is no rational interpretation of a signature hash for a coinbase.
-    BITCOIN_ASSERT(!tx.is_coinbase());
-
-    auto serialized = tx.to_data(true, false);
-    extend_data(serialized, to_little_endian(sighash_type));
-    return bitcoin_hash(serialized);
-}
-
 //*****************************************************************************
 // CONSENSUS: Due to masking of bits 6/7 (8 is the anyone_can_pay flag),
 // there are 4 possible 7 bit values that can set "single" and 4 others that
@@ -515,111 +583,6 @@ inline uint8_t is_sighash_enum(uint8_t sighash_type, sighash_algorithm value)
     return to_sighash_enum(sighash_type) == value;
 }
 
-static hash_digest sign_none(const transaction& tx, uint32_t input_index,
-    const script& script_code, uint8_t sighash_type)
-{
-    input::list ins;
-    const auto& inputs = tx.inputs();
-    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
-
-    BITCOIN_ASSERT(input_index < inputs.size());
-    const auto& self = inputs[input_index];
-
-    if (any)
-    {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    }
-    else
-    {
-        // Erase all input scripts and sequences.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{}, 0);
-
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
-    }
-
-    // Move new inputs to new transaction and drop outputs.
-    return signature_hash({ tx.version(), tx.locktime(), std::move(ins), {} },
-        sighash_type);
-}
-
-static hash_digest sign_single(const transaction& tx, uint32_t input_index,
-    const script& script_code, uint8_t sighash_type)
-{
-    input::list ins;
-    const auto& inputs = tx.inputs();
-    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
-
-    BITCOIN_ASSERT(input_index < inputs.size());
-    const auto& self = inputs[input_index];
-
-    if (any)
-    {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    }
-    else
-    {
-        // Erase all input scripts and sequences.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{}, 0);
-
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
-    }
-
-    // Trim and clear outputs except that of specified input index.
-    const auto& outputs = tx.outputs();
-    output::list outs(input_index + 1);
-
-    BITCOIN_ASSERT(input_index < outputs.size());
-    outs.back() = outputs[input_index];
-
-    // Move new inputs and new outputs to new transaction.
-    return signature_hash({ tx.version(), tx.locktime(), std::move(ins),
-        std::move(outs) }, sighash_type);
-}
-
-static hash_digest sign_all(const transaction& tx, uint32_t input_index,
-    const script& script_code, uint8_t sighash_type)
-{
-    input::list ins;
-    const auto& inputs = tx.inputs();
-    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
-
-    BITCOIN_ASSERT(input_index < inputs.size());
-    const auto& self = inputs[input_index];
-
-    if (any)
-    {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    }
-    else
-    {
-        // Erase all input scripts.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{},
-                input.sequence());
-
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ////ins[input_index].set_sequence(self.sequence());
-    }
-
-    // Move new inputs and copy outputs to new transaction.
-    transaction out(tx.version(), tx.locktime(), input::list{}, tx.outputs());
-    out.set_inputs(std::move(ins));
-    return signature_hash(out, sighash_type);
-}
-
 static script strip_code_seperators(const script& script_code)
 {
     operation::list ops;
@@ -651,17 +614,9 @@ hash_digest script::generate_unversioned_signature_hash(const transaction& tx,
     //*************************************************************************
     const auto stripped = strip_code_seperators(script_code);
 
-    // The sighash serializations are isolated for clarity and optimization.
-    switch (sighash)
-    {
-        case sighash_algorithm::none:
-            return sign_none(tx, input_index, stripped, sighash_type);
-        case sighash_algorithm::single:
-            return sign_single(tx, input_index, stripped, sighash_type);
-        default:
-        case sighash_algorithm::all:
-            return sign_all(tx, input_index, stripped, sighash_type);
-    }
+    // The sighash serializations are streamed from a per-transaction context.
+    return tx.unversioned_signature_hash(input_index, stripped, sighash,
+        sighash_type);
 }
 
 // Signing (version 0).
@@ -842,7 +797,7 @@ hash_digest script::generate_signature_hash(const transaction& tx,
 
 // static
 bool script::check_signature(const ec_signature& signature,
-    uint8_t sighash_type, const data_chunk& public_key,
+    uint8_t sighash_type, data_slice public_key,
     const script& script_code, const transaction& tx, uint32_t input_index,
     script_version version, uint64_t value)
 {
@@ -853,8 +808,70 @@ bool script::check_signature(const ec_signature& signature,
     const auto sighash = chain::script::generate_signature_hash(tx,
         input_index, script_code, sighash_type, version, value);
 
+    return check_signature(signature, sighash, public_key);
+}
+
+// static
+bool script::check_signature(const ec_signature& signature,
+    const hash_digest& sighash, data_slice public_key)
+{
+    if (public_key.empty())
+        return false;
+
+    auto& cache = signature_cache();
+    if (!cache.enabled())
+        return verify_signature(public_key, sighash, signature);
+
+    // A previously verified signature (e.g. at pool acceptance) is skipped.
+    const auto key = cache.key({ public_key, sighash, signature });
+    if (cache.contains(key))
+        return true;
+
     // Validate the EC signature.
-    return verify_signature(public_key, sighash, signature);
+    if (!verify_signature(public_key, sighash, signature))
+        return false;
+
+    cache.insert(key);
+    return true;
+}
+
+// static
+bool script::check_signatures(verify_job::list& jobs, threadpool& pool)
+{
+    auto& cache = signature_cache();
+    if (!cache.enabled())
+        return verify_signatures(jobs, pool);
+
+    // Previously verified signatures (e.g. at pool acceptance) are skipped.
+    std::vector<size_t> positions;
+    std::vector<hash_digest> keys;
+    verify_job::list uncached;
+
+    for (size_t position = 0; position < jobs.size(); ++position)
+    {
+        auto& job = jobs[position];
+        const auto key = cache.key({ job.point, job.hash, job.signature });
+        job.valid = cache.contains(key);
+
+        if (!job.valid)
+        {
+            positions.push_back(position);
+            keys.push_back(key);
+            uncached.push_back(job);
+        }
+    }
+
+    auto all = verify_signatures(uncached, pool);
+
+    for (size_t index = 0; index < uncached.size(); ++index)
+    {
+        jobs[positions[index]].valid = uncached[index].valid;
+
+        if (uncached[index].valid)
+            cache.insert(keys[index]);
+    }
+
+    return all;
 }
 
 // static
@@ -1179,7 +1196,8 @@ data_chunk script::witness_program() const
 {
     // The first operations access must be method-based to guarantee the cache.
     const auto& ops = operations();
-    return is_witness_program_pattern(ops) ? ops[1].data() : data_chunk{};
+    return is_witness_program_pattern(ops) ? ops[1].data().to_chunk() :
+        data_chunk{};
 }
 
 script_version script::version() const
@@ -1207,20 +1225,21 @@ script_pattern script::pattern() const
 // The bip141 coinbase pattern is not tested here, must test independently.
 script_pattern script::output_pattern() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_pay_key_hash_pattern(operations()))
+    const auto& ops = operations();
+
+    if (is_pay_key_hash_pattern(ops))
         return script_pattern::pay_key_hash;
 
-    if (is_pay_script_hash_pattern(operations_))
+    if (is_pay_script_hash_pattern(ops))
         return script_pattern::pay_script_hash;
 
-    if (is_pay_null_data_pattern(operations_))
+    if (is_pay_null_data_pattern(ops))
         return script_pattern::pay_null_data;
 
-    if (is_pay_public_key_pattern(operations_))
+    if (is_pay_public_key_pattern(ops))
         return script_pattern::pay_public_key;
 
-    if (is_pay_multisig_pattern(operations_))
+    if (is_pay_multisig_pattern(ops))
         return script_pattern::pay_multisig;
 
     return script_pattern::non_standard;
@@ -1230,18 +1249,19 @@ script_pattern script::output_pattern() const
 // The bip34 coinbase pattern is not tested here, must test independently.
 script_pattern script::input_pattern() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_sign_key_hash_pattern(operations()))
+    const auto& ops = operations();
+
+    if (is_sign_key_hash_pattern(ops))
         return script_pattern::sign_key_hash;
 
     // This must follow is_sign_key_hash_pattern for ambiguity comment to hold.
-    if (is_sign_script_hash_pattern(operations_))
+    if (is_sign_script_hash_pattern(ops))
         return script_pattern::sign_script_hash;
 
-    if (is_sign_public_key_pattern(operations_))
+    if (is_sign_public_key_pattern(ops))
         return script_pattern::sign_public_key;
 
-    if (is_sign_multisig_pattern(operations_))
+    if (is_sign_multisig_pattern(ops))
         return script_pattern::sign_multisig;
 
     return script_pattern::non_standard;
@@ -1303,7 +1323,7 @@ size_t script::sigops(bool accurate) const
 // The comparison and erase are not limited to a single operation and so can
 // erase arbitrary upstream data from the script.
 //*****************************************************************************
-void script::find_and_delete_(const data_chunk& endorsement)
+void script::find_and_delete_(const small_chunk& endorsement)
 {
     // If this is empty it would produce an empty script but not operation.
     // So we test it for empty prior to operation reserialization.
@@ -1315,16 +1335,16 @@ void script::find_and_delete_(const data_chunk& endorsement)
     const auto value = operation(endorsement, false).to_data();
 
     operation op;
-    data_source stream(bytes_);
-    istream_reader source(stream);
+    auto& bytes = owned_bytes();
+    auto source = make_safe_deserializer(bytes.begin(), bytes.end());
     std::vector<data_chunk::iterator> found;
 
     // The exhaustion test handles stream end and op deserialization failure.
-    for (auto it = bytes_.begin(); !source.is_exhausted();
+    for (auto it = bytes.begin(); !source.is_exhausted();
         it += source ? op.serialized_size() : 0)
     {
         // Track all found values for later deletion.
-        for (; starts_with(it, bytes_.end(), value); it += value.size())
+        for (; starts_with(it, bytes.end(), value); it += value.size())
         {
             source.skip(value.size());
             found.push_back(it);
@@ -1336,19 +1356,18 @@ void script::find_and_delete_(const data_chunk& endorsement)
 
     // Delete any found values, reversed to prevent iterator invalidation.
     for (const auto it: reverse(found))
-        bytes_.erase(it, it + value.size());
+        bytes.erase(it, it + value.size());
 }
 
 // Concurrent read/write is not supported, so no critical section.
-void script::find_and_delete(const data_stack& endorsements)
+void script::find_and_delete(const small_stack& endorsements)
 {
     for (const auto& endorsement: endorsements)
         find_and_delete_(endorsement);
 
     // Invalidate the cache so that the operations may be regenerated.
-    operations_.clear();
-    cached_ = false;
-    bytes_.shrink_to_fit();
+    operations_.reset();
+    owned_bytes().shrink_to_fit();
 }
 
 ////// This is slightly more efficient because the script does not get parsed,
@@ -1370,9 +1389,9 @@ void script::find_and_delete(const data_stack& endorsements)
 // The criteria below are not be comprehensive but are fast to evaluate.
 bool script::is_unspendable() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    return (!operations().empty() && operations_[0].code() == opcode::return_)
-        || serialized_size(false) > max_script_size;
+    const auto& ops = operations();
+    return (!ops.empty() && ops.front().code() == opcode::return_) ||
+        serialized_size(false) > max_script_size;
 }
 
 // Validation.
@@ -1384,6 +1403,44 @@ code script::verify(const transaction& tx, uint32_t input_index,
     if (input_index >= tx.inputs().size())
         return error::operation_failed;
 
+    auto& cache = script_cache();
+    if (!cache.enabled())
+        return verify_input(tx, input_index, forks, prevout_script, value);
+
+    // The wtxid commits to all input scripts and witnesses, and the previous
+    // output is included as it is provided by the caller.
+    const auto key = cache.key(
+    {
+        tx.hash(true),
+        to_little_endian(input_index),
+        to_little_endian(forks),
+        to_little_endian(value),
+        prevout_script.to_data(false)
+    });
+
+    if (cache.contains(key))
+        return error::success;
+
+    const auto ec = verify_input(tx, input_index, forks, prevout_script,
+        value);
+
+    if (!ec)
+        cache.insert(key);
+
+    return ec;
+}
+
+// private/static
+code script::verify_input(const transaction& tx, uint32_t input_index,
+    uint32_t forks, const script& prevout_script, uint64_t value)
+{
+    // Standard key hash spends are verified without script evaluation.
+    // These only accept, any failure is determined by the interpreter below.
+    verify_job job{ { nullptr, nullptr }, null_hash, {}, input_index, false };
+    if (prepare_signature(job, tx, input_index, forks, prevout_script, value) &&
+        check_signature(job.signature, job.hash, job.point))
+        return error::success;
+
     code ec;
     bool witnessed;
     const auto& in = tx.inputs()[input_index];
@@ -1422,7 +1479,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
             return error::invalid_script_embed;
 
         // Embedded script must be at the top of the stack (bip16).
-        script embedded_script(input.pop(), false);
+        script embedded_script(input.pop().to_chunk(), false);
 
         program embedded(embedded_script, std::move(input), true);
         if ((ec = embedded.evaluate()))
@@ -1453,6 +1510,127 @@ code script::verify(const transaction& tx, uint32_t input_index,
     return error::success;
 }
 
+// Fast paths.
+//-----------------------------------------------------------------------------
+// These reproduce the interpreter result for a successful spend of the two
+// most common output templates, given a valid signature. Each returns false
+// for anything it does not fully recognize, which includes every failure
+// condition except that of the signature, which the caller verifies.
+
+bool script::prepare_signature(verify_job& out, const transaction& tx,
+    uint32_t input_index, uint32_t forks, const script& prevout_script,
+    uint64_t value)
+{
+    return input_index < tx.inputs().size() &&
+        (prepare_pay_key_hash(out, tx, input_index, forks, prevout_script) ||
+        prepare_pay_witness_key_hash(out, tx, input_index, forks,
+            prevout_script, value));
+}
+
+static bool is_key_hash(data_slice public_key, data_slice hash)
+{
+    const auto key_hash = bitcoin_short_hash(public_key);
+    return hash.size() == key_hash.size() &&
+        std::equal(key_hash.begin(), key_hash.end(), hash.begin());
+}
+
+// The interpreter casts the top stack element to bool.
+static bool is_true(data_slice value)
+{
+    for (auto it = value.begin(); it != value.end(); ++it)
+        if (*it != 0)
+            return !(it == value.end() - 1 && *it == number::negative_0);
+
+    return false;
+}
+
+// private/static
+// input: <endorsement> <public key>, witness: empty
+// output: dup hash160 <hash> equalverify checksig
+bool script::prepare_pay_key_hash(verify_job& out, const transaction& tx,
+    uint32_t input_index, uint32_t forks, const script& prevout_script)
+{
+    const auto& in = tx.inputs()[input_index];
+    const auto& prevout_ops = prevout_script.operations();
+    const auto& ops = in.script().operations();
+
+    if (!is_pay_key_hash_pattern(prevout_ops) ||
+        prevout_ops[2].code() != opcode::push_size_20 ||
+        !in.witness().empty() || ops.size() != 2)
+        return false;
+
+    for (const auto& op: ops)
+        if (!op.is_valid() || !operation::is_payload(op.code()) ||
+            op.is_oversized())
+            return false;
+
+    const auto& endorsement = ops[0].data();
+    const auto& public_key = ops[1].data();
+
+    // An endorsement of hash size could be deleted from the script code.
+    if (endorsement.empty() || endorsement.size() == short_hash_size ||
+        !is_key_hash(public_key, prevout_ops[2].data()))
+        return false;
+
+    uint8_t sighash_type;
+    der_signature distinguished;
+    const auto bip66 = is_enabled(forks, rule_fork::bip66_rule);
+
+    if (!parse_endorsement(sighash_type, distinguished, endorsement) ||
+        !parse_signature(out.signature, distinguished, bip66))
+        return false;
+
+    out.point = public_key;
+    out.hash = generate_signature_hash(tx, input_index, prevout_script,
+        sighash_type);
+    return true;
+}
+
+// private/static
+// input: empty, witness: <endorsement> <public key>
+// output: 0 <hash>
+bool script::prepare_pay_witness_key_hash(verify_job& out,
+    const transaction& tx, uint32_t input_index, uint32_t forks,
+    const script& prevout_script, uint64_t value)
+{
+    const auto& in = tx.inputs()[input_index];
+    const auto& stack = in.witness().stack();
+
+    // Without bip143 the witness signature hash is unversioned.
+    if (!is_enabled(forks, rule_fork::bip143_rule) ||
+        !prevout_script.is_pay_to_witness(forks) ||
+        prevout_script.version() != script_version::zero ||
+        !in.script().empty() || stack.size() != 2)
+        return false;
+
+    const auto program = prevout_script.witness_program();
+    const auto& endorsement = stack[0];
+    const auto& public_key = stack[1];
+
+    if (program.size() != short_hash_size || !is_true(program) ||
+        endorsement.empty() || endorsement.size() > max_push_data_size ||
+        public_key.size() > max_push_data_size ||
+        !is_key_hash(public_key, program))
+        return false;
+
+    uint8_t sighash_type;
+    der_signature distinguished;
+    const auto bip66 = is_enabled(forks, rule_fork::bip66_rule);
+
+    if (!parse_endorsement(sighash_type, distinguished, endorsement) ||
+        !parse_signature(out.signature, distinguished, bip66))
+        return false;
+
+    short_hash hash;
+    std::copy(program.begin(), program.end(), hash.begin());
+    const script script_code(to_pay_key_hash_pattern(hash));
+
+    out.point = public_key;
+    out.hash = generate_signature_hash(tx, input_index, script_code,
+        sighash_type, script_version::zero, value);
+    return true;
+}
+
 code script::verify(const transaction& tx, uint32_t input_index,
     uint32_t forks)
 {
@@ -1464,5 +1642,19 @@ code script::verify(const transaction& tx, uint32_t input_index,
     return verify(tx, input_index, forks, prevout.script(), prevout.value());
 }
 
+// static
+machine::validation_cache& script::signature_cache()
+{
+    static machine::validation_cache cache(signature_cache_capacity);
+    return cache;
+}
+
+// static
+machine::validation_cache& script::script_cache()
+{
+    static machine::validation_cache cache;
+    return cache;
+}
+
 } // namespace chain
 } // namespace libbitcoin
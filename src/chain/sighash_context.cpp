@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sighash_context.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/input.hpp>
+#include <bitcoin/bitcoin/chain/output.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/machine/sighash_algorithm.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+namespace chain {
+
+using namespace bc::machine;
+
+// Each stripped input is its point, an empty script and its sequence.
+static constexpr size_t point_size = hash_size + sizeof(uint32_t);
+static constexpr size_t stripped_size = point_size + 1 + sizeof(uint32_t);
+
+// A cleared output is a sighash null value and an empty script.
+static const byte_array<sizeof(uint64_t) + 1> null_output
+{
+    {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00
+    }
+};
+
+// A cleared input has an empty script and a zero sequence.
+static const byte_array<1 + sizeof(uint32_t)> null_script_and_sequence
+{
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00
+    }
+};
+
+static void write(SHA256CTX& context, const uint8_t* data, size_t size)
+{
+    SHA256Update(&context, data, size);
+}
+
+static void write_4_bytes(SHA256CTX& context, uint32_t value)
+{
+    const auto buffer = to_little_endian(value);
+    write(context, buffer.data(), buffer.size());
+}
+
+static void write_variable(SHA256CTX& context, uint64_t value)
+{
+    byte_array<sizeof(uint8_t) + sizeof(uint64_t)> buffer;
+    auto sink = make_unsafe_serializer(buffer.begin());
+    sink.write_variable_little_endian(value);
+    write(context, buffer.data(), message::variable_uint_size(value));
+}
+
+sighash_context::sighash_context(const transaction& tx)
+  : version_(tx.version()),
+    locktime_(tx.locktime()),
+    inputs_(tx.inputs().size()),
+    outputs_(tx.outputs().size())
+{
+    // There is no rational interpretation of a signature hash for a coinbase.
+    BITCOIN_ASSERT(!tx.is_coinbase());
+
+    stripped_.resize(inputs_ * stripped_size);
+    auto inputs = make_unsafe_serializer(stripped_.begin());
+
+    for (const auto& input: tx.inputs())
+    {
+        input.previous_output().to_data(inputs, true);
+        inputs.write_byte(0x00);
+        inputs.write_4_bytes_little_endian(input.sequence());
+    }
+
+    outputs_offsets_.reserve(outputs_ + 1);
+    outputs_offsets_.push_back(0);
+
+    for (const auto& output: tx.outputs())
+        outputs_offsets_.push_back(outputs_offsets_.back() +
+            output.serialized_size(true));
+
+    outputs_data_.resize(outputs_offsets_.back());
+    auto outputs = make_unsafe_serializer(outputs_data_.begin());
+
+    for (const auto& output: tx.outputs())
+        output.to_data(outputs, true);
+
+    // Retain the sighash_all state preceding each input.
+    SHA256CTX context;
+    SHA256Init(&context);
+    write_4_bytes(context, version_);
+    write_variable(context, inputs_);
+    all_.reserve(inputs_);
+
+    for (size_t index = 0; index < inputs_; ++index)
+    {
+        all_.push_back(context);
+        write(context, &stripped_[index * stripped_size], stripped_size);
+    }
+}
+
+bool sighash_context::is_sized(const transaction& tx) const
+{
+    return tx.inputs().size() == inputs_ && tx.outputs().size() == outputs_;
+}
+
+// The signed input retains its point and sequence, with the script code.
+void sighash_context::write_self(SHA256CTX& context, uint32_t input_index,
+    const script& script_code) const
+{
+    const auto input = &stripped_[input_index * stripped_size];
+    write(context, input, point_size);
+
+    const auto code = script_code.to_data(true);
+    write(context, code.data(), code.size());
+    write(context, input + point_size + 1, sizeof(uint32_t));
+}
+
+// Other inputs retain only their point for sighash_none and sighash_single.
+void sighash_context::write_cleared(SHA256CTX& context,
+    uint32_t input_index) const
+{
+    write(context, &stripped_[input_index * stripped_size], point_size);
+    write(context, null_script_and_sequence.data(),
+        null_script_and_sequence.size());
+}
+
+void sighash_context::write_outputs(SHA256CTX& context, uint32_t input_index,
+    sighash_algorithm algorithm) const
+{
+    switch (algorithm)
+    {
+        case sighash_algorithm::none:
+        {
+            write_variable(context, 0);
+            break;
+        }
+        case sighash_algorithm::single:
+        {
+            // Outputs preceding that of the input index are cleared.
+            BITCOIN_ASSERT(input_index < outputs_);
+            write_variable(context, input_index + 1u);
+
+            for (uint32_t index = 0; index < input_index; ++index)
+                write(context, null_output.data(), null_output.size());
+
+            const auto begin = outputs_offsets_[input_index];
+            const auto end = outputs_offsets_[input_index + 1u];
+            write(context, &outputs_data_[begin], end - begin);
+            break;
+        }
+        default:
+        case sighash_algorithm::all:
+        {
+            write_variable(context, outputs_);
+            write(context, outputs_data_.data(), outputs_data_.size());
+            break;
+        }
+    }
+}
+
+hash_digest sighash_context::hash(uint32_t input_index,
+    const script& script_code, sighash_algorithm algorithm,
+    uint8_t sighash_type) const
+{
+    BITCOIN_ASSERT(input_index < inputs_);
+    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
+    const auto all = (algorithm == sighash_algorithm::all);
+
+    SHA256CTX context;
+
+    if (any)
+    {
+        // Retain only self.
+        SHA256Init(&context);
+        write_4_bytes(context, version_);
+        write_variable(context, 1);
+        write_self(context, input_index, script_code);
+    }
+    else if (all)
+    {
+        // Resume from the retained state and stream the stripped remainder.
+        context = all_[input_index];
+        write_self(context, input_index, script_code);
+        const auto next = (input_index + 1u) * stripped_size;
+        write(context, stripped_.data() + next, stripped_.size() - next);
+    }
+    else
+    {
+        // Clear all other input scripts and sequences.
+        SHA256Init(&context);
+        write_4_bytes(context, version_);
+        write_variable(context, inputs_);
+
+        for (uint32_t index = 0; index < inputs_; ++index)
+            if (index == input_index)
+                write_self(context, input_index, script_code);
+            else
+                write_cleared(context, index);
+    }
+
+    write_outputs(context, input_index, algorithm);
+
+    write_4_bytes(context, locktime_);
+    write_4_bytes(context, sighash_type);
+
+    hash_digest hash;
+    SHA256Final(&context, hash.data());
+    return sha256_hash(hash);
+}
+
+} // namespace chain
+} // namespace libbitcoin
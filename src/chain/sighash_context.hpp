@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_SIGHASH_CONTEXT_HPP
+#define LIBBITCOIN_CHAIN_SIGHASH_CONTEXT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/machine/sighash_algorithm.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+namespace chain {
+
+class transaction;
+
+/**
+ * Unversioned (legacy) signature hashing context for a transaction.
+ * The portions of the sighash serialization that do not depend upon the
+ * signed input are serialized once, and the sha256 state following each
+ * input of the sighash_all prefix is retained. Each signature hash then
+ * streams only the signed input's script code and the remaining suffix.
+ * Preconditions are those of the unversioned signature hash algorithm.
+ */
+class sighash_context
+{
+public:
+    sighash_context(const transaction& tx);
+
+    /// True if the input and output counts match those of the transaction.
+    bool is_sized(const transaction& tx) const;
+
+    /// The script code must be stripped of code separators by the caller.
+    hash_digest hash(uint32_t input_index, const script& script_code,
+        machine::sighash_algorithm algorithm, uint8_t sighash_type) const;
+
+private:
+    typedef std::vector<SHA256CTX> midstates;
+
+    void write_self(SHA256CTX& context, uint32_t input_index,
+        const script& script_code) const;
+    void write_cleared(SHA256CTX& context, uint32_t input_index) const;
+    void write_outputs(SHA256CTX& context, uint32_t input_index,
+        machine::sighash_algorithm algorithm) const;
+
+    const uint32_t version_;
+    const uint32_t locktime_;
+    const size_t inputs_;
+    const size_t outputs_;
+    data_chunk stripped_;
+    data_chunk outputs_data_;
+    std::vector<size_t> outputs_offsets_;
+    midstates all_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
@@ -27,7 +27,6 @@
 #include <sstream>
 #include <utility>
 #include <vector>
-#include <boost/optional.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/chain/input.hpp>
@@ -40,13 +39,17 @@
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/machine/sighash_algorithm.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/flat_hash_set.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include "../math/external/sha256.h"
+#include "sighash_context.hpp"
 
 namespace libbitcoin {
 namespace chain {
@@ -58,7 +61,8 @@ const uint64_t transaction::validation::unlinked = max_int64;
 
 // Read a length-prefixed collection of inputs or outputs from the source.
 template<class Source, class Put>
-bool read(Source& source, std::vector<Put>& puts, bool wire, bool witness)
+bool read(Source& source, std::vector<Put>& puts,
+    const script_arena::ptr& memory, bool wire, bool witness)
 {
     auto result = true;
     const auto count = source.read_size_little_endian();
@@ -71,7 +75,7 @@ bool read(Source& source, std::vector<Put>& puts, bool wire, bool witness)
 
     const auto deserialize = [&](Put& put)
     {
-        result = result && put.from_data(source, wire, witness);
+        result = result && put.from_data(source, memory, wire, witness);
 #ifndef NDEBUG
         put.script().operations();
 #endif
@@ -135,9 +139,9 @@ transaction::transaction(transaction&& other)
     locktime_(other.locktime_),
     inputs_(std::move(other.inputs_)),
     outputs_(std::move(other.outputs_)),
-    hash_(other.hash_cache()),
-    total_input_value_(other.total_input_value_cache()),
-    total_output_value_(other.total_output_value_cache())
+    hash_(std::move(other.hash_)),
+    total_input_value_(std::move(other.total_input_value_)),
+    total_output_value_(std::move(other.total_output_value_))
 {
 }
 
@@ -147,9 +151,9 @@ transaction::transaction(const transaction& other)
     locktime_(other.locktime_),
     inputs_(other.inputs_),
     outputs_(other.outputs_),
-    hash_(other.hash_cache()),
-    total_input_value_(other.total_input_value_cache()),
-    total_output_value_(other.total_output_value_cache())
+    hash_(other.hash_),
+    total_input_value_(other.total_input_value_),
+    total_output_value_(other.total_output_value_)
 {
 }
 
@@ -173,54 +177,35 @@ transaction::transaction(uint32_t version, uint32_t locktime,
 {
 }
 
-// Private cache access for copy/move construction.
-transaction::hash_ptr transaction::hash_cache() const
-{
-    shared_lock lock(mutex_);
-    return hash_;
-}
-
-// Private cache access for copy/move construction.
-transaction::optional_value transaction::total_input_value_cache() const
-{
-    shared_lock lock(mutex_);
-    return total_input_value_;
-}
-
-// Private cache access for copy/move construction.
-transaction::optional_value transaction::total_output_value_cache() const
-{
-    shared_lock lock(mutex_);
-    return total_output_value_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 transaction& transaction::operator=(transaction&& other)
 {
-    hash_ = other.hash_cache();
-    total_input_value_ = other.total_input_value_cache();
-    total_output_value_ = other.total_output_value_cache();
+    hash_ = std::move(other.hash_);
+    total_input_value_ = std::move(other.total_input_value_);
+    total_output_value_ = std::move(other.total_output_value_);
     version_ = other.version_;
     locktime_ = other.locktime_;
     inputs_ = std::move(other.inputs_);
     outputs_ = std::move(other.outputs_);
     metadata = std::move(other.metadata);
+    reset_derived();
     return *this;
 }
 
 // This can be expensive, try to avoid.
 transaction& transaction::operator=(const transaction& other)
 {
-    hash_ = other.hash_cache();
-    total_input_value_ = other.total_input_value_cache();
-    total_output_value_ = other.total_output_value_cache();
+    hash_ = other.hash_;
+    total_input_value_ = other.total_input_value_;
+    total_output_value_ = other.total_output_value_;
     version_ = other.version_;
     locktime_ = other.locktime_;
     inputs_ = other.inputs_;
     outputs_ = other.outputs_;
     metadata = other.metadata;
+    reset_derived();
     return *this;
 }
 
@@ -286,8 +271,10 @@ transaction transaction::factory(reader& source, const hash_digest& hash,
 
 bool transaction::from_data(const data_chunk& data, bool wire, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, wire, witness);
+    // Pointer iterators allow the hashes to be computed from the source.
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, wire, witness);
 }
 
 bool transaction::from_data(std::istream& stream, bool wire, bool witness)
@@ -296,43 +283,63 @@ bool transaction::from_data(std::istream& stream, bool wire, bool witness)
     return from_data(source, wire, witness);
 }
 
-// Witness is not used by outputs, just for template normalization.
 bool transaction::from_data(reader& source, bool wire, bool witness)
+{
+    return from_data(source, nullptr, wire, witness);
+}
+
+// Witness is not used by outputs, just for template normalization.
+bool transaction::from_data(reader& source, const script_arena::ptr& memory,
+    bool wire, bool witness)
 {
     reset();
 
     if (wire)
     {
         // Wire (satoshi protocol) deserialization.
+        // Positions are null unless the source is an addressable buffer.
+        const auto begin = source.position();
         version_ = source.read_4_bytes_little_endian();
-        read(source, inputs_, wire, witness);
+        auto inputs = source.position();
+        read(source, inputs_, memory, wire, witness);
 
         // Detect witness as no inputs (marker) and expected flag (bip144).
         const auto marker = inputs_.size() == witness_marker &&
             source.peek_byte() == witness_flag;
 
+        const uint8_t* outputs_end;
+
         // This is always enabled so caller should validate with is_segregated.
         if (marker)
         {
             // Skip over the peeked witness flag.
             source.skip(1);
-            read(source, inputs_, wire, witness);
-            read(source, outputs_, wire, witness);
+            inputs = source.position();
+            read(source, inputs_, memory, wire, witness);
+            read(source, outputs_, memory, wire, witness);
+            outputs_end = source.position();
             read_witnesses(source, inputs_);
         }
         else
         {
-            read(source, outputs_, wire, witness);
+            read(source, outputs_, memory, wire, witness);
+            outputs_end = source.position();
         }
 
+        const auto locktime = source.position();
         locktime_ = source.read_4_bytes_little_endian();
+        const auto end = source.position();
+
+        if (source && begin != nullptr && end != nullptr)
+            cache_hashes(begin, inputs, outputs_end, locktime, end, marker,
+                witness);
     }
     else
     {
         // Database (outputs forward) serialization.
         // Witness data is managed internal to inputs.
-        read(source, outputs_, wire, witness);
-        read(source, inputs_, wire, witness);
+        read(source, outputs_, memory, wire, witness);
+        read(source, inputs_, memory, wire, witness);
         const auto locktime = source.read_variable_little_endian();
         const auto version = source.read_variable_little_endian();
 
@@ -359,7 +366,7 @@ bool transaction::from_data(reader& source, hash_digest&& hash, bool wire,
     if (!from_data(source, wire, witness))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(std::move(hash));
+    hash_.set(std::move(hash));
     return true;
 }
 
@@ -369,10 +376,47 @@ bool transaction::from_data(reader& source, const hash_digest& hash, bool wire,
     if (!from_data(source, wire, witness))
         return false;
 
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.set(hash);
     return true;
 }
 
+// private
+// Cache the hashes from the consumed wire bytes, avoiding reserialization.
+// A non-canonical encoding (varint) is left to be hashed from its
+// reserialization, since the hash must commit to the canonical form.
+void transaction::cache_hashes(const uint8_t* begin, const uint8_t* inputs,
+    const uint8_t* outputs_end, const uint8_t* locktime, const uint8_t* end,
+    bool marker, bool witness)
+{
+    const auto segregated = marker && is_segregated();
+    const auto size = static_cast<size_t>(end - begin);
+
+    if (size != serialized_size(true, segregated))
+        return;
+
+    if (!segregated)
+    {
+        hash_.set(bitcoin_hash({ begin, end }));
+        return;
+    }
+
+    // The txid excludes the marker, flag and witnesses (bip141).
+    SHA256CTX context;
+    SHA256Init(&context);
+    SHA256Update(&context, begin, sizeof(uint32_t));
+    SHA256Update(&context, inputs, outputs_end - inputs);
+    SHA256Update(&context, locktime, sizeof(uint32_t));
+
+    hash_digest hash;
+    SHA256Final(&context, hash.data());
+    hash_.set(sha256_hash(hash));
+
+    // Witness coinbase tx hash is assumed to be null_hash (bip141).
+    if (witness)
+        witness_hash_.set(is_coinbase() ? null_hash :
+            bitcoin_hash({ begin, end }));
+}
+
 // protected
 void transaction::reset()
 {
@@ -386,9 +430,9 @@ void transaction::reset()
     outputs_hash_.reset();
     inpoints_hash_.reset();
     sequences_hash_.reset();
-    segregated_ = boost::none;
-    total_input_value_ = boost::none;
-    total_output_value_ = boost::none;
+    segregated_.reset();
+    total_input_value_.reset();
+    total_output_value_.reset();
 }
 
 bool transaction::is_valid() const
@@ -538,8 +582,10 @@ void transaction::set_locktime(uint32_t value)
     invalidate_cache();
 }
 
+// The sighash context is discarded as the inputs may be modified.
 input::list& transaction::inputs()
 {
+    sighash_context_.reset();
     return inputs_;
 }
 
@@ -554,20 +600,22 @@ void transaction::set_inputs(const input::list& value)
     invalidate_cache();
     inpoints_hash_.reset();
     sequences_hash_.reset();
-    segregated_ = boost::none;
-    total_input_value_ = boost::none;
+    segregated_.reset();
+    total_input_value_.reset();
 }
 
 void transaction::set_inputs(input::list&& value)
 {
     inputs_ = std::move(value);
     invalidate_cache();
-    segregated_ = boost::none;
-    total_input_value_ = boost::none;
+    segregated_.reset();
+    total_input_value_.reset();
 }
 
+// The sighash context is discarded as the outputs may be modified.
 output::list& transaction::outputs()
 {
+    sighash_context_.reset();
     return outputs_;
 }
 
@@ -581,150 +629,109 @@ void transaction::set_outputs(const output::list& value)
     outputs_ = value;
     invalidate_cache();
     outputs_hash_.reset();
-    total_output_value_ = boost::none;
+    total_output_value_.reset();
 }
 
 void transaction::set_outputs(output::list&& value)
 {
     outputs_ = std::move(value);
     invalidate_cache();
-    total_output_value_ = boost::none;
+    total_output_value_.reset();
 }
 
 // Cache.
 //-----------------------------------------------------------------------------
 
+// private
+// Caches that are not carried over by assignment belong to the prior value.
+void transaction::reset_derived() const
+{
+    witness_hash_.reset();
+    outputs_hash_.reset();
+    inpoints_hash_.reset();
+    sequences_hash_.reset();
+    sighash_context_.reset();
+    segregated_.reset();
+}
+
 // protected
+// The sighash context copies version and locktime, so it is also invalid.
 void transaction::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (hash_ || witness_hash_)
-    {
-        hash_mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        witness_hash_.reset();
-        //---------------------------------------------------------------------
-        hash_mutex_.unlock_and_lock_upgrade();
-    }
-
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    hash_.reset();
+    witness_hash_.reset();
+    sighash_context_.reset();
 }
 
 hash_digest transaction::hash(bool witness) const
 {
     // Witness hashing must be disabled for non-segregated txs.
-    witness &= is_segregated();
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (witness)
+    if (witness && is_segregated())
     {
-        if (!witness_hash_)
+        return witness_hash_.get([this]()
         {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_mutex_.unlock_upgrade_and_lock();
-
             // Witness coinbase tx hash is assumed to be null_hash (bip141).
-            witness_hash_ = std::make_shared<hash_digest>(
-                is_coinbase() ? null_hash : bitcoin_hash(to_data(true, true)));
-
-            hash_mutex_.unlock_and_lock_upgrade();
-            //-----------------------------------------------------------------
-        }
-    }
-    else
-    {
-        if (!hash_)
-        {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_mutex_.unlock_upgrade_and_lock();
-            hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_data(true)));
-            hash_mutex_.unlock_and_lock_upgrade();
-            //-----------------------------------------------------------------
-        }
+            return is_coinbase() ? null_hash : bitcoin_hash(to_data(true,
+                true));
+        });
     }
 
-    const auto hash = witness ? *witness_hash_ : *hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+    return hash_.get([this]()
+    {
+        return bitcoin_hash(to_data(true));
+    });
 }
 
 hash_digest transaction::outputs_hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (!outputs_hash_)
+    return outputs_hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        outputs_hash_ = std::make_shared<hash_digest>(
-            script::to_outputs(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    const auto hash = *outputs_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        return script::to_outputs(*this);
+    });
 }
 
 hash_digest transaction::inpoints_hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (!inpoints_hash_)
+    return inpoints_hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        inpoints_hash_ = std::make_shared<hash_digest>(
-            script::to_inpoints(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    const auto hash = *inpoints_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        return script::to_inpoints(*this);
+    });
 }
 
 hash_digest transaction::sequences_hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
+    return sequences_hash_.get([this]()
+    {
+        return script::to_sequences(*this);
+    });
+}
+
+hash_digest transaction::unversioned_signature_hash(uint32_t input_index,
+    const script& script_code, sighash_algorithm algorithm,
+    uint8_t sighash_type) const
+{
+    // A single input has nothing to share, so its context is not retained.
+    if (inputs_.size() < 2)
+        return sighash_context(*this).hash(input_index, script_code,
+            algorithm, sighash_type);
 
-    if (!sequences_hash_)
+    const auto& context = sighash_context_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        sequences_hash_ = std::make_shared<hash_digest>(
-            script::to_sequences(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
+        return std::make_shared<const sighash_context>(*this);
+    });
+
+    // Inputs or outputs added or removed through a retained reference.
+    if (!context->is_sized(*this))
+        return sighash_context(*this).hash(input_index, script_code,
+            algorithm, sighash_type);
 
-    const auto hash = *sequences_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    return context->hash(input_index, script_code, algorithm, sighash_type);
+}
 
-    return hash;
+// This is not concurrency-safe, call only once script verification is done.
+void transaction::release_signature_hashes() const
+{
+    sighash_context_.reset();
 }
 
 // Utilities.
@@ -738,13 +745,9 @@ void transaction::strip_witness()
         input.strip_witness();
     };
 
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    unique_lock lock(mutex_);
-
-    segregated_ = false;
+    // Concurrent read/write is not supported, so no critical section.
+    segregated_.set(false);
     std::for_each(inputs_.begin(), inputs_.end(), strip);
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 // Validation helpers.
@@ -825,73 +828,37 @@ bool transaction::is_locktime_conflict() const
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_input_value() const
 {
-    uint64_t value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_input_value_ != boost::none)
-    {
-        value = total_input_value_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
     ////static_assert(max_money() < max_uint64, "overflow sentinel invalid");
-    const auto sum = [](uint64_t total, const input& input)
+    return total_input_value_.get([this]()
     {
-        const auto& prevout = input.previous_output().metadata.cache;
-        const auto missing = !prevout.is_valid();
-
-        // Treat missing previous outputs as zero-valued, no math on sentinel.
-        return ceiling_add(total, missing ? 0 : prevout.value());
-    };
+        const auto sum = [](uint64_t total, const input& input)
+        {
+            const auto& prevout = input.previous_output().metadata.cache;
+            const auto missing = !prevout.is_valid();
 
-    value = std::accumulate(inputs_.begin(), inputs_.end(), uint64_t(0), sum);
-    total_input_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
+            // Treat missing previous outputs as zero-valued (no sentinel).
+            return ceiling_add(total, missing ? 0 : prevout.value());
+        };
 
-    return value;
+        return std::accumulate(inputs_.begin(), inputs_.end(), uint64_t(0),
+            sum);
+    });
 }
 
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_output_value() const
 {
-    uint64_t value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_output_value_ != boost::none)
-    {
-        value = total_output_value_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
     ////static_assert(max_money() < max_uint64, "overflow sentinel invalid");
-    const auto sum = [](uint64_t total, const output& output)
+    return total_output_value_.get([this]()
     {
-        return ceiling_add(total, output.value());
-    };
-
-    value = std::accumulate(outputs_.begin(), outputs_.end(), uint64_t(0), sum);
-    total_output_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
+        const auto sum = [](uint64_t total, const output& output)
+        {
+            return ceiling_add(total, output.value());
+        };
 
-    return value;
+        return std::accumulate(outputs_.begin(), outputs_.end(), uint64_t(0),
+            sum);
+    });
 }
 
 uint64_t transaction::fees() const
@@ -1000,11 +967,13 @@ hash_list transaction::missing_previous_transactions() const
 
 bool transaction::is_internal_double_spend() const
 {
-    auto prevouts = previous_outputs();
-    std::sort(prevouts.begin(), prevouts.end());
-    const auto distinct_end = std::unique(prevouts.begin(), prevouts.end());
-    const auto distinct = (distinct_end == prevouts.end());
-    return !distinct;
+    point_set prevouts(inputs_.size());
+    const auto insert = [&prevouts](const input& input)
+    {
+        return prevouts.insert(input.previous_output());
+    };
+
+    return !std::all_of(inputs_.begin(), inputs_.end(), insert);
 }
 
 bool transaction::is_confirmed_double_spend() const
@@ -1039,34 +1008,19 @@ bool transaction::is_mature(size_t height) const
 
 bool transaction::is_segregated() const
 {
-    bool value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (segregated_ != boost::none)
+    const auto segregated = [this]()
     {
-        value = segregated_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        const auto segregated = [](const input& input)
+        {
+            return input.is_segregated();
+        };
 
-    const auto segregated = [](const input& input)
-    {
-        return input.is_segregated();
+        // If no block tx has witness data the commitment is optional (bip141).
+        return std::any_of(inputs_.begin(), inputs_.end(), segregated);
     };
 
-    // If no block tx is has witness data the commitment is optional (bip141).
-    value = std::any_of(inputs_.begin(), inputs_.end(), segregated);
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    // This is only cached when the witness is stripped, as inputs are mutable.
+    return segregated_.empty() ? segregated() : segregated_.get(segregated);
 }
 
 // Coinbase transactions return success, to simplify iteration.
@@ -1206,15 +1160,17 @@ code transaction::connect() const
     return state ? connect(*state) : error::operation_failed;
 }
 
+// The signature hash context is not retained once the inputs are verified.
 code transaction::connect(const chain_state& state) const
 {
     code ec;
 
     for (size_t input = 0; input < inputs_.size(); ++input)
         if ((ec = connect_input(state, input)))
-            return ec;
+            break;
 
-    return error::success;
+    release_signature_hashes();
+    return ec;
 }
 
 } // namespace chain
@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+namespace chain {
+
+static const size_t point_size = hash_size + sizeof(uint32_t);
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+transaction_view::transaction_view()
+  : data_(nullptr, nullptr), segregated_(false), inputs_begin_(0),
+    outputs_end_(0), locktime_(0)
+{
+}
+
+// Deserialization.
+//-----------------------------------------------------------------------------
+
+// Mirrors transaction::from_data (wire), but only indexes offsets.
+bool transaction_view::from_data(data_slice data)
+{
+    reset();
+    size_t offset = 0;
+    auto source = make_safe_deserializer(data.begin(), data.end());
+
+    const auto skip = [&](size_t size)
+    {
+        source.skip(size);
+        offset += size;
+    };
+
+    // Returns zero and invalidates the source if the size exceeds the limit.
+    const auto read_size = [&](size_t limit)
+    {
+        offset += message::variable_prefix_size(source.peek_byte());
+        const auto size = source.read_size_little_endian();
+
+        if (size <= limit)
+            return size;
+
+        source.invalidate();
+        return size_t(0);
+    };
+
+    skip(sizeof(uint32_t));
+    inputs_begin_ = offset;
+    auto count = read_size(max_block_size);
+
+    // Detect witness as no inputs (marker) and expected flag (bip144).
+    if (count == witness_marker && source.peek_byte() == witness_flag)
+    {
+        segregated_ = true;
+        skip(sizeof(witness_flag));
+        inputs_begin_ = offset;
+        count = read_size(max_block_size);
+    }
+
+    inputs_.resize(count);
+
+    for (auto& input: inputs_)
+    {
+        input.point = offset;
+        skip(point_size);
+        input.script_size = read_size(max_block_size);
+        input.script = offset;
+        skip(input.script_size);
+        skip(sizeof(uint32_t));
+    }
+
+    outputs_.resize(read_size(max_block_size));
+
+    for (auto& output: outputs_)
+    {
+        output.value = offset;
+        skip(sizeof(uint64_t));
+        output.script_size = read_size(max_block_size);
+        output.script = offset;
+        skip(output.script_size);
+    }
+
+    outputs_end_ = offset;
+
+    // Witnesses are skipped, they are only hashed as part of the wtxid.
+    if (segregated_)
+        for (size_t input = 0; input < inputs_.size(); ++input)
+            for (auto items = read_size(max_block_weight); items > 0; --items)
+                skip(read_size(max_block_weight));
+
+    locktime_ = offset;
+    skip(sizeof(uint32_t));
+
+    if (!source)
+    {
+        reset();
+        return false;
+    }
+
+    data_ = { data.begin(), data.begin() + offset };
+    return true;
+}
+
+bool transaction_view::is_valid() const
+{
+    return !data_.empty();
+}
+
+// private
+void transaction_view::reset()
+{
+    data_ = { nullptr, nullptr };
+    segregated_ = false;
+    inputs_begin_ = 0;
+    outputs_end_ = 0;
+    locktime_ = 0;
+    inputs_.clear();
+    outputs_.clear();
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+data_slice transaction_view::data() const
+{
+    return data_;
+}
+
+size_t transaction_view::serialized_size() const
+{
+    return data_.size();
+}
+
+bool transaction_view::is_segregated() const
+{
+    return segregated_;
+}
+
+bool transaction_view::is_coinbase() const
+{
+    return inputs_.size() == 1 && previous_output(0).is_null();
+}
+
+uint32_t transaction_view::version() const
+{
+    BITCOIN_ASSERT(is_valid());
+    return from_little_endian_unsafe<uint32_t>(data_.begin());
+}
+
+uint32_t transaction_view::locktime() const
+{
+    BITCOIN_ASSERT(is_valid());
+    return from_little_endian_unsafe<uint32_t>(data_.begin() + locktime_);
+}
+
+size_t transaction_view::inputs() const
+{
+    return inputs_.size();
+}
+
+output_point transaction_view::previous_output(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_.size());
+    const auto begin = data_.begin() + inputs_[index].point;
+    auto source = make_unsafe_deserializer(begin);
+    output_point point;
+    point.from_data(source, true);
+    return point;
+}
+
+script transaction_view::input_script(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_.size());
+    const auto& input = inputs_[index];
+    return to_script(input.script, input.script_size);
+}
+
+uint32_t transaction_view::sequence(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_.size());
+    const auto& input = inputs_[index];
+    const auto offset = input.script + input.script_size;
+    return from_little_endian_unsafe<uint32_t>(data_.begin() + offset);
+}
+
+size_t transaction_view::outputs() const
+{
+    return outputs_.size();
+}
+
+uint64_t transaction_view::value(size_t index) const
+{
+    BITCOIN_ASSERT(index < outputs_.size());
+    const auto offset = outputs_[index].value;
+    return from_little_endian_unsafe<uint64_t>(data_.begin() + offset);
+}
+
+script transaction_view::output_script(size_t index) const
+{
+    BITCOIN_ASSERT(index < outputs_.size());
+    const auto& output = outputs_[index];
+    return to_script(output.script, output.script_size);
+}
+
+// Operations are parsed from the script only when first requested.
+// private
+script transaction_view::to_script(size_t offset, size_t size) const
+{
+    const auto begin = data_.begin() + offset;
+    return { data_chunk(begin, begin + size), false };
+}
+
+// The txid of a segregated transaction is hashed from its three stripped
+// ranges, which avoids both reserialization and copying.
+hash_digest transaction_view::hash(bool witness) const
+{
+    if (!segregated_)
+        return bitcoin_hash(data_);
+
+    // Witness coinbase tx hash is assumed to be null_hash (bip141).
+    if (witness)
+        return is_coinbase() ? null_hash : bitcoin_hash(data_);
+
+    const auto begin = data_.begin();
+    SHA256CTX context;
+    SHA256Init(&context);
+    SHA256Update(&context, begin, sizeof(uint32_t));
+    SHA256Update(&context, begin + inputs_begin_,
+        outputs_end_ - inputs_begin_);
+    SHA256Update(&context, begin + locktime_, sizeof(uint32_t));
+
+    hash_digest hash;
+    SHA256Final(&context, hash.data());
+    return sha256_hash(hash);
+}
+
+transaction transaction_view::to_transaction(bool witness) const
+{
+    transaction tx;
+    auto source = make_safe_deserializer(data_.begin(), data_.end());
+    tx.from_data(source, true, witness);
+    return tx;
+}
+
+} // namespace chain
+} // namespace libbitcoin
@@ -36,8 +36,8 @@
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -65,14 +65,24 @@ witness::witness(const witness& other)
 {
 }
 
-witness::witness(const data_stack& stack)
+witness::witness(small_stack&& stack)
+{
+    stack_ = std::move(stack);
+}
+
+witness::witness(const small_stack& stack)
 {
     stack_ = stack;
 }
 
 witness::witness(data_stack&& stack)
 {
-    stack_ = std::move(stack);
+    stack_ = to_small_stack(stack);
+}
+
+witness::witness(const data_stack& stack)
+{
+    stack_ = to_small_stack(stack);
 }
 
 witness::witness(data_chunk&& encoded, bool prefix)
@@ -142,8 +152,8 @@ witness witness::factory(reader& source, bool prefix)
 
 bool witness::from_data(const data_chunk& encoded, bool prefix)
 {
-    data_source istream(encoded);
-    return from_data(istream, prefix);
+    auto source = make_safe_deserializer(encoded.begin(), encoded.end());
+    return from_data(source, prefix);
 }
 
 bool witness::from_data(std::istream& stream, bool prefix)
@@ -169,10 +179,17 @@ bool witness::from_data(reader& source, bool prefix)
         if (size > max_block_weight)
         {
             source.invalidate();
-            return data_chunk{};
+            return small_chunk{};
         }
 
-        return source.read_bytes(size);
+        // Copy from an addressable source, avoiding an interim buffer.
+        const auto begin = source.position();
+
+        if (begin == nullptr)
+            return small_chunk(source.read_bytes(size));
+
+        source.skip(size);
+        return source ? small_chunk(begin, begin + size) : small_chunk{};
     };
 
     // TODO: optimize store serialization to avoid loop, reading data directly.
@@ -196,9 +213,9 @@ bool witness::from_data(reader& source, bool prefix)
 }
 
 // private/static
-size_t witness::serialized_size(const data_stack& stack)
+size_t witness::serialized_size(const small_stack& stack)
 {
-    const auto sum = [](size_t total, const data_chunk& element)
+    const auto sum = [](size_t total, const small_chunk& element)
     {
         // Tokens encoded as variable integer prefixed byte array (bip144).
         const auto size = element.size();
@@ -249,7 +266,7 @@ void witness::to_data(writer& sink, bool prefix) const
     if (prefix)
         sink.write_variable_little_endian(stack_.size());
 
-    const auto serialize = [&sink](const data_chunk& element)
+    const auto serialize = [&sink](const small_chunk& element)
     {
         // Tokens encoded as variable integer prefixed byte array (bip144).
         sink.write_variable_little_endian(element.size());
@@ -266,7 +283,7 @@ std::string witness::to_string() const
         return "<invalid>";
 
     std::string text;
-    const auto serialize = [&text](const data_chunk& element)
+    const auto serialize = [&text](const small_chunk& element)
     {
         text += "[" + encode_base16(element) + "] ";
     };
@@ -294,19 +311,19 @@ size_t witness::size() const
     return stack_.size();
 }
 
-const data_chunk& witness::front() const
+const small_chunk& witness::front() const
 {
     BITCOIN_ASSERT(!stack_.empty());
     return stack_.front();
 }
 
-const data_chunk& witness::back() const
+const small_chunk& witness::back() const
 {
     BITCOIN_ASSERT(!stack_.empty());
     return stack_.back();
 }
 
-const data_chunk& witness::operator[](size_t index) const
+const small_chunk& witness::operator[](size_t index) const
 {
     BITCOIN_ASSERT(index < stack_.size());
     return stack_[index];
@@ -332,7 +349,7 @@ size_t witness::serialized_size(bool prefix) const
         serialized_size(stack_);
 }
 
-const data_stack& witness::stack() const
+const small_stack& witness::stack() const
 {
     return stack_;
 }
@@ -341,9 +358,9 @@ const data_stack& witness::stack() const
 //-----------------------------------------------------------------------------
 
 // static
-bool witness::is_push_size(const data_stack& stack)
+bool witness::is_push_size(const small_stack& stack)
 {
-    const auto push_size = [](const data_chunk& element)
+    const auto push_size = [](const small_chunk& element)
     {
         return element.size() <= max_push_data_size;
     };
@@ -353,7 +370,7 @@ bool witness::is_push_size(const data_stack& stack)
 
 // static
 // The (only) coinbase witness must be (arbitrary) 32-byte value (bip141).
-bool witness::is_reserved_pattern(const data_stack& stack)
+bool witness::is_reserved_pattern(const small_stack& stack)
 {
     return stack.size() == 1 &&
         stack[0].size() == hash_size;
@@ -394,7 +411,7 @@ bool witness::extract_sigop_script(script& out_script,
 
                 case hash_size:
                     if (!stack_.empty())
-                        out_script.from_data(stack_.back(), false);
+                        out_script.from_data(stack_.back().to_chunk(), false);
 
                     return true;
 
@@ -414,7 +431,7 @@ bool witness::extract_sigop_script(script& out_script,
 
 // Extract P2WPKH or P2WSH script as indicated by program script.
 bool witness::extract_embedded_script(script& out_script,
-    data_stack& out_stack, const script& program_script) const
+    small_stack& out_stack, const script& program_script) const
 {
     switch (program_script.version())
     {
@@ -451,7 +468,7 @@ bool witness::extract_embedded_script(script& out_script,
                     return false;
 
                 // The script is popped off the initial witness stack (bip141).
-                out_script.from_data(pop(out_stack), false);
+                out_script.from_data(pop(out_stack).to_chunk(), false);
 
                 // Stack elements must be within push size limit (bip141).
                 if (!is_push_size(out_stack))
@@ -492,7 +509,7 @@ code witness::verify(const transaction& tx, uint32_t input_index,
         {
             code ec;
             script script;
-            data_stack stack;
+            small_stack stack;
 
             if (!extract_embedded_script(script, stack, program_script))
                 return error::invalid_witness;
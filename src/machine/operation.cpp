@@ -26,7 +26,7 @@
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
@@ -63,8 +63,8 @@ operation operation::factory(reader& source)
 
 bool operation::from_data(const data_chunk& encoded)
 {
-    data_source istream(encoded);
-    return from_data(istream);
+    auto source = make_safe_deserializer(encoded.begin(), encoded.end());
+    return from_data(source);
 }
 
 bool operation::from_data(std::istream& stream)
@@ -85,9 +85,26 @@ bool operation::from_data(reader& source)
     // evaluation, but not all scripts evaluate, so use max_block_size
     // to guard memory allocation here.
     if (size > max_block_size)
+    {
         source.invalidate();
+    }
     else
-        data_ = source.read_bytes(size);
+    {
+        // Copy from an addressable source, avoiding an interim buffer.
+        const auto begin = source.position();
+
+        if (begin == nullptr)
+        {
+            data_ = source.read_bytes(size);
+        }
+        else
+        {
+            source.skip(size);
+
+            if (source)
+                data_.assign(begin, begin + size);
+        }
+    }
 
     if (!source)
         reset();
@@ -124,7 +141,7 @@ inline string_list split_push_token(const std::string& token)
 }
 
 static bool opcode_from_data_prefix(opcode& out_code,
-    const std::string& prefix, const data_chunk& data)
+    const std::string& prefix, const small_chunk& data)
 {
     BC_CONSTEXPR auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
     const auto size = data.size();
@@ -153,7 +170,7 @@ static bool opcode_from_data_prefix(opcode& out_code,
     return false;
 }
 
-static bool data_from_number_token(data_chunk& out_data,
+static bool data_from_number_token(small_chunk& out_data,
     const std::string& token)
 {
     try
@@ -176,12 +193,14 @@ bool operation::from_string(const std::string& mnemonic)
     {
         // Data encoding uses single token (with optional non-minimality).
         const auto parts = split_push_token(mnemonic);
+        data_chunk data;
 
         if (parts.size() == 1)
         {
             // Extract operation using nominal data size encoding.
-            if (decode_base16(data_, parts[0]))
+            if (decode_base16(data, parts[0]))
             {
+                data_ = data;
                 code_ = nominal_opcode_from_data(data_);
                 valid_ = true;
             }
@@ -189,14 +208,15 @@ bool operation::from_string(const std::string& mnemonic)
         else if (parts.size() == 2)
         {
             // Extract operation using explicit data size encoding.
-            valid_ = decode_base16(data_, parts[1]) &&
-                opcode_from_data_prefix(code_, parts[0], data_);
+            valid_ = decode_base16(data, parts[1]);
+            data_ = data;
+            valid_ = valid_ && opcode_from_data_prefix(code_, parts[0], data_);
         }
     }
     else if (is_text_token(mnemonic))
     {
         const auto text = trim_token(mnemonic);
-        data_ = data_chunk{ text.begin(), text.end() };
+        data_.assign(text.begin(), text.end());
         code_ = nominal_opcode_from_data(data_);
         valid_ = true;
     }
@@ -278,7 +298,7 @@ void operation::to_data(writer& sink) const
     sink.write_bytes(data_);
 }
 
-static std::string opcode_to_prefix(opcode code, const data_chunk& data)
+static std::string opcode_to_prefix(opcode code, const small_chunk& data)
 {
     // If opcode is minimal for a size-based encoding, do not set a prefix.
     if (code == operation::opcode_from_size(data.size()))
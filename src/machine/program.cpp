@@ -94,7 +94,7 @@ program::program(const script& script, const chain::transaction& transaction,
 
 // Condition, alternate, jump and operation_count are not copied.
 program::program(const script& script, const chain::transaction& transaction,
-    uint32_t input_index, uint32_t forks, data_stack&& stack, uint64_t value,
+    uint32_t input_index, uint32_t forks, small_stack&& stack, uint64_t value,
     script_version version)
   : script_(script),
     transaction_(transaction),
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/machine/validation_cache.hpp>
+
+#include <cstddef>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/pseudo_random.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+namespace machine {
+
+static hash_digest new_salt()
+{
+    hash_digest salt;
+    pseudo_random::fill(salt);
+    return salt;
+}
+
+validation_cache::validation_cache(size_t capacity)
+  : salt_(new_salt()),
+    capacity_(capacity),
+    hits_(0),
+    misses_(0)
+{
+}
+
+hash_digest validation_cache::key(loaf slices) const
+{
+    SHA256CTX context;
+    SHA256Init(&context);
+    SHA256Update(&context, salt_.data(), salt_.size());
+
+    for (const auto& slice: slices)
+        SHA256Update(&context, slice.data(), slice.size());
+
+    hash_digest key;
+    SHA256Final(&context, key.data());
+    return key;
+}
+
+// The key is salted, so its leading byte uniformly selects the shard.
+validation_cache::shard& validation_cache::find(const hash_digest& key) const
+{
+    return shards_[key.front() % shard_count];
+}
+
+bool validation_cache::contains(const hash_digest& key) const
+{
+    if (!enabled())
+        return false;
+
+    auto& shard = find(key);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(shard.mutex);
+    const auto found = shard.keys.find(key) != shard.keys.end();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (found)
+        ++hits_;
+    else
+        ++misses_;
+
+    return found;
+}
+
+void validation_cache::insert(const hash_digest& key)
+{
+    const auto capacity = capacity_.load();
+    if (capacity == 0)
+        return;
+
+    // Each shard holds at least one entry when enabled.
+    const auto limit = (capacity + shard_count - 1) / shard_count;
+    auto& shard = find(key);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(shard.mutex);
+
+    if (!shard.keys.insert(key).second)
+        return;
+
+    shard.order.push_back(key);
+
+    while (shard.order.size() > limit)
+    {
+        shard.keys.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void validation_cache::resize(size_t capacity)
+{
+    capacity_.store(capacity);
+    clear();
+}
+
+void validation_cache::clear()
+{
+    for (auto& shard: shards_)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(shard.mutex);
+        shard.keys.clear();
+        shard.order.clear();
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    hits_.store(0);
+    misses_.store(0);
+}
+
+bool validation_cache::enabled() const
+{
+    return capacity_.load() != 0;
+}
+
+size_t validation_cache::capacity() const
+{
+    return capacity_.load();
+}
+
+size_t validation_cache::size() const
+{
+    size_t total = 0;
+
+    for (const auto& shard: shards_)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        shared_lock lock(shard.mutex);
+        total += shard.keys.size();
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    return total;
+}
+
+size_t validation_cache::hits() const
+{
+    return hits_.load();
+}
+
+size_t validation_cache::misses() const
+{
+    return misses_.load();
+}
+
+} // namespace machine
+} // namespace libbitcoin
@@ -19,6 +19,9 @@
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <map>
 #include <utility>
 #include <secp256k1.h>
 #include <secp256k1_recovery.h>
@@ -27,6 +30,8 @@
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
 #include "../math/external/lax_der_parsing.h"
 #include "secp256k1_initializer.hpp"
@@ -132,6 +137,50 @@ bool verify_signature(const secp256k1_context* context,
     return secp256k1_ecdsa_verify(context, &normal, hash.data(), &point) == 1;
 }
 
+// Points are compared by value, as a job does not own its point.
+struct point_less
+{
+    bool operator()(const data_slice& left, const data_slice& right) const
+    {
+        return std::lexicographical_compare(left.begin(), left.end(),
+            right.begin(), right.end());
+    }
+};
+
+bool verify_signatures(const secp256k1_context* context,
+    verify_job::list::iterator first, verify_job::list::iterator last)
+{
+    // Points are commonly repeated (e.g. multisig and key reuse).
+    std::map<data_slice, secp256k1_pubkey, point_less> points;
+    auto all = true;
+
+    for (auto job = first; job != last; ++job)
+    {
+        auto point = points.find(job->point);
+
+        if (point == points.end())
+        {
+            secp256k1_pubkey pubkey;
+            const auto& data = job->point;
+
+            if (data.empty() || secp256k1_ec_pubkey_parse(context, &pubkey,
+                data.data(), data.size()) != 1)
+            {
+                job->valid = all = false;
+                continue;
+            }
+
+            point = points.emplace(data, pubkey).first;
+        }
+
+        job->valid = verify_signature(context, point->second, job->hash,
+            job->signature);
+        all &= job->valid;
+    }
+
+    return all;
+}
+
 // Add and multiply EC values
 // ----------------------------------------------------------------------------
 
@@ -147,6 +196,33 @@ bool ec_add(ec_uncompressed& point, const ec_secret& scalar)
     return ec_add(context, point, scalar);
 }
 
+// The point is parsed (decompressed) once. Each G*b uses the precomputed
+// generator table of the signing context, which is several times faster than
+// the generic multiplication of a tweak, and is then combined with the point.
+bool ec_add(point_list& out, const ec_compressed& point,
+    const secret_list& scalars)
+{
+    secp256k1_pubkey parsed;
+    secp256k1_pubkey product;
+    secp256k1_pubkey sum;
+    const secp256k1_pubkey* terms[] = { &parsed, &product };
+    const auto signer = signing.context();
+    const auto context = verification.context();
+    out.resize(scalars.size());
+
+    if (!parse(context, parsed, point))
+        return false;
+
+    for (size_t index = 0; index < scalars.size(); ++index)
+        if (secp256k1_ec_pubkey_create(signer, &product,
+            scalars[index].data()) != 1 ||
+            secp256k1_ec_pubkey_combine(context, &sum, terms, 2) != 1 ||
+            !serialize(context, out[index], sum))
+            return false;
+
+    return true;
+}
+
 bool ec_add(ec_secret& left, const ec_secret& right)
 {
     const auto context = verification.context();
@@ -287,7 +363,7 @@ bool is_even_key(const ec_compressed& point)
     return point.front() == ec_even_sign;
 }
 
-bool is_endorsement(const endorsement& endorsement)
+bool is_endorsement(data_slice endorsement)
 {
     const auto size = endorsement.size();
     return size >= min_endorsement_size && size <= max_endorsement_size;
@@ -297,12 +373,12 @@ bool is_endorsement(const endorsement& endorsement)
 // ----------------------------------------------------------------------------
 
 bool parse_endorsement(uint8_t& sighash_type, der_signature& der_signature,
-    const endorsement& endorsement)
+    data_slice endorsement)
 {
     if (endorsement.empty())
         return false;
 
-    sighash_type = endorsement.back();
+    sighash_type = *(endorsement.end() - 1);
     der_signature = { endorsement.begin(), endorsement.end() - 1 };
     return true;
 }
@@ -404,6 +480,41 @@ bool verify_signature(data_slice point, const hash_digest& hash,
         secp256k1_ecdsa_verify(context, &normal, hash.data(), &pubkey) == 1;
 }
 
+// EC batch verify
+// ----------------------------------------------------------------------------
+
+bool verify_signatures(verify_job::list& jobs)
+{
+    const auto context = verification.context();
+    return verify_signatures(context, jobs.begin(), jobs.end());
+}
+
+// Partitions share the context, which is read-only once initialized.
+bool verify_signatures(verify_job::list& jobs, threadpool& pool)
+{
+    const auto size = jobs.size();
+    const auto buckets = std::min(pool.size(), size);
+
+    if (buckets < 2)
+        return verify_signatures(jobs);
+
+    const auto context = verification.context();
+    std::atomic<bool> all(true);
+
+    const auto verify = [&](size_t bucket)
+    {
+        const auto first = jobs.begin() + bucket * size / buckets;
+        const auto last = jobs.begin() + (bucket + 1) * size / buckets;
+
+        if (!verify_signatures(context, first, last))
+            all = false;
+    };
+
+    dispatcher dispatch(pool, "verify");
+    dispatch.partition(buckets, verify);
+    return all;
+}
+
 // Recoverable sign/recover
 // ----------------------------------------------------------------------------
 
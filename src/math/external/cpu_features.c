@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "cpu_features.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef CPU_FEATURES_X86
+    #include <cpuid.h>
+#endif
+
+#ifdef CPU_FEATURES_X86
+
+static uint64_t xgetbv(uint32_t index)
+{
+    uint32_t eax, edx;
+    __asm__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+    return ((uint64_t)edx << 32) | eax;
+}
+
+void CPUFeaturesProbe(CPUFeatures* features)
+{
+    uint32_t eax, ebx, ecx, edx;
+    const unsigned int maximum = __get_cpuid_max(0, NULL);
+    memset(features, 0, sizeof(CPUFeatures));
+
+    if (maximum >= 1)
+    {
+        __cpuid(1, eax, ebx, ecx, edx);
+        features->sse2 = (edx >> 26) & 1;
+        features->sse41 = (ecx >> 19) & 1;
+
+        /* AVX requires that the OS saves the ymm registers (osxsave). */
+        if (((ecx >> 27) & 1) && ((ecx >> 28) & 1))
+            features->avx = (xgetbv(0) & 6) == 6;
+    }
+
+    if (maximum >= 7)
+    {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        features->avx2 = features->avx && ((ebx >> 5) & 1);
+        features->sha = (ebx >> 29) & 1;
+    }
+}
+
+#else
+
+void CPUFeaturesProbe(CPUFeatures* features)
+{
+    memset(features, 0, sizeof(CPUFeatures));
+}
+
+#endif
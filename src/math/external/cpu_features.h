@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CPU_FEATURES_H
+#define LIBBITCOIN_CPU_FEATURES_H
+
+/* The probe requires gcc/clang cpuid intrinsics (features are zero if not). */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define CPU_FEATURES_X86
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Each is nonzero if usable, avx and avx2 also require os ymm state saving. */
+typedef struct CPUFeatures
+{
+    int sse2;
+    int sse41;
+    int avx;
+    int avx2;
+    int sha;
+} CPUFeatures;
+
+/* Probe the features of the executing cpu. This is safe to call from load
+ * time constructors, as it depends on no other static initialization. */
+void CPUFeaturesProbe(CPUFeatures* features);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
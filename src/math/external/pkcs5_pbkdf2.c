@@ -21,48 +21,98 @@
 #include <stdlib.h>
 #include <string.h>
 #include "hmac_sha512.h"
+#include "sha512.h"
 #include "zeroize.h"
 
+#define WORDS (HMACSHA512_DIGEST_LENGTH / 8)
+
+static void be64dec_vect(uint64_t* dst, const uint8_t* src)
+{
+    size_t i, j;
+    for (i = 0; i < WORDS; i++)
+        for (dst[i] = 0, j = 0; j < 8; j++)
+            dst[i] = (dst[i] << 8) | src[i * 8 + j];
+}
+
+static void be64enc_vect(uint8_t* dst, const uint64_t* src)
+{
+    size_t i, j;
+    for (i = 0; i < WORDS; i++)
+        for (j = 0; j < 8; j++)
+            dst[i * 8 + j] = (src[i] >> (56 - j * 8)) & 0xff;
+}
+
+/* The hmac context holds the inner and outer midstates of the passphrase, */
+/* from which the first digest of the given block of the key is computed. */
+static void pbkdf2_prepare(const HMACSHA512CTX* hmac, const uint8_t* salt,
+    size_t salt_length, size_t block, uint64_t inner[WORDS],
+    uint64_t outer[WORDS], uint64_t digest[WORDS], uint64_t result[WORDS])
+{
+    HMACSHA512CTX context;
+    uint8_t buffer[HMACSHA512_DIGEST_LENGTH];
+    const size_t count = block + 1;
+    const uint8_t counter[4] =
+    {
+        (count >> 24) & 0xff,
+        (count >> 16) & 0xff,
+        (count >> 8) & 0xff,
+        (count >> 0) & 0xff
+    };
+
+    memcpy(&context, hmac, sizeof(context));
+    HMACSHA512Update(&context, salt, salt_length);
+    HMACSHA512Update(&context, counter, sizeof(counter));
+    HMACSHA512Final(&context, buffer);
+
+    be64dec_vect(digest, buffer);
+    memcpy(result, digest, HMACSHA512_DIGEST_LENGTH);
+    memcpy(inner, hmac->ictx.state, HMACSHA512_DIGEST_LENGTH);
+    memcpy(outer, hmac->octx.state, HMACSHA512_DIGEST_LENGTH);
+
+    zeroize(buffer, sizeof(buffer));
+    zeroize(&context, sizeof(context));
+}
+
+/* Each iteration is one block from each cached midstate, over all lanes. */
+static void pbkdf2_iterate(const uint64_t* inner, const uint64_t* outer,
+    uint64_t* digests, uint64_t* results, size_t lanes, size_t iterations)
+{
+    size_t index, iteration;
+
+    for (iteration = 1; iteration < iterations; iteration++)
+    {
+        SHA512Final64(digests, inner, lanes);
+        SHA512Final64(digests, outer, lanes);
+
+        for (index = 0; index < lanes * WORDS; index++)
+            results[index] ^= digests[index];
+    }
+}
+
 int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint8_t* key, size_t key_length,
     size_t iterations)
 {
-    uint8_t* asalt;
-    size_t asalt_size;
-    size_t count, index, iteration, length;
+    size_t block, length;
+    HMACSHA512CTX hmac;
+    uint64_t inner[WORDS];
+    uint64_t outer[WORDS];
+    uint64_t digest[WORDS];
+    uint64_t result[WORDS];
     uint8_t buffer[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest1[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest2[HMACSHA512_DIGEST_LENGTH];
 
     /* An iteration count of 0 is equivalent to a count of 1. */
     /* A key_length of 0 is a no-op. */
     /* A salt_length of 0 is perfectly valid. */
 
-    if (salt_length > SIZE_MAX - 4)
-        return -1;
-    asalt_size = salt_length + 4;
-    asalt = malloc(asalt_size);
-    if (asalt == NULL)
-        return -1;
+    HMACSHA512Init(&hmac, passphrase, passphrase_length);
 
-    memcpy(asalt, salt, salt_length);
-    for (count = 1; key_length > 0; count++)
+    for (block = 0; key_length > 0; block++)
     {
-        asalt[salt_length + 0] = (count >> 24) & 0xff;
-        asalt[salt_length + 1] = (count >> 16) & 0xff;
-        asalt[salt_length + 2] = (count >> 8) & 0xff;
-        asalt[salt_length + 3] = (count >> 0) & 0xff;
-        HMACSHA512(asalt, asalt_size, passphrase, passphrase_length, digest1);
-        memcpy(buffer, digest1, sizeof(buffer));
-
-        for (iteration = 1; iteration < iterations; iteration++)
-        {
-            HMACSHA512(digest1, sizeof(digest1), passphrase, passphrase_length,
-                digest2);
-            memcpy(digest1, digest2, sizeof(digest1));
-            for (index = 0; index < sizeof(buffer); index++)
-                buffer[index] ^= digest1[index];
-        }
+        pbkdf2_prepare(&hmac, salt, salt_length, block, inner, outer, digest,
+            result);
+        pbkdf2_iterate(inner, outer, digest, result, 1, iterations);
+        be64enc_vect(buffer, result);
 
         length = (key_length < sizeof(buffer) ? key_length : sizeof(buffer));
         memcpy(key, buffer, length);
@@ -70,11 +120,69 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
         key_length -= length;
     };
 
-    zeroize(digest1, sizeof(digest1));
-    zeroize(digest2, sizeof(digest2));
+    zeroize(&hmac, sizeof(hmac));
+    zeroize(inner, sizeof(inner));
+    zeroize(outer, sizeof(outer));
+    zeroize(digest, sizeof(digest));
+    zeroize(result, sizeof(result));
+    zeroize(buffer, sizeof(buffer));
+
+    return 0;
+}
+
+int pkcs5_pbkdf2_batch(const uint8_t* const* passphrases,
+    const size_t* passphrase_lengths, const uint8_t* const* salts,
+    const size_t* salt_lengths, uint8_t* keys, size_t key_length,
+    size_t count, size_t iterations)
+{
+    size_t key, block, lane, length, size;
+    uint64_t* words;
+    HMACSHA512CTX hmac;
+    uint8_t buffer[HMACSHA512_DIGEST_LENGTH];
+    const size_t blocks = (key_length + sizeof(buffer) - 1) / sizeof(buffer);
+    const size_t lanes = blocks * count;
+
+    if (lanes == 0)
+        return 0;
+
+    /* Lane states are laid out as inner, outer, digest and result arrays. */
+    if (lanes / count != blocks || lanes > SIZE_MAX / (4 * sizeof(buffer)))
+        return -1;
+    size = lanes * 4 * sizeof(buffer);
+    words = malloc(size);
+    if (words == NULL)
+        return -1;
+
+    for (key = 0, lane = 0; key < count; key++)
+    {
+        HMACSHA512Init(&hmac, passphrases[key], passphrase_lengths[key]);
+
+        for (block = 0; block < blocks; block++, lane++)
+            pbkdf2_prepare(&hmac, salts[key], salt_lengths[key], block,
+                &words[lane * WORDS], &words[(lanes + lane) * WORDS],
+                &words[(2 * lanes + lane) * WORDS],
+                &words[(3 * lanes + lane) * WORDS]);
+    }
+
+    pbkdf2_iterate(words, &words[lanes * WORDS], &words[2 * lanes * WORDS],
+        &words[3 * lanes * WORDS], lanes, iterations);
+
+    for (key = 0, lane = 0; key < count; key++)
+    {
+        for (block = 0; block < blocks; block++, lane++)
+        {
+            be64enc_vect(buffer, &words[(3 * lanes + lane) * WORDS]);
+            length = key_length - block * sizeof(buffer);
+            length = (length < sizeof(buffer) ? length : sizeof(buffer));
+            memcpy(&keys[key * key_length + block * sizeof(buffer)], buffer,
+                length);
+        }
+    }
+
+    zeroize(&hmac, sizeof(hmac));
     zeroize(buffer, sizeof(buffer));
-    zeroize(asalt, asalt_size);
-    free(asalt);
+    zeroize(words, size);
+    free(words);
 
     return 0;
 }
@@ -33,6 +33,15 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint8_t* key, size_t key_length,
     size_t iterations);
 
+/* Derive count keys of key_length bytes each into consecutive key buffers,
+ * the passphrase and salt of key i at index i of the respective arrays. */
+/* Independent derivations share the multi-lane sha512 engine. */
+/* returns 0 if successful. */
+int pkcs5_pbkdf2_batch(const uint8_t* const* passphrases,
+    const size_t* passphrase_lengths, const uint8_t* const* salts,
+    const size_t* salt_lengths, uint8_t* keys, size_t key_length,
+    size_t count, size_t iterations);
+
 #ifdef __cplusplus
 }
 #endif
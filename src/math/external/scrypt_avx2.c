@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scrypt_x86.h"
+
+#ifdef SCRYPT_X86
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#define TARGET __attribute__((target("avx2")))
+#define N 1024
+#define ROWS 8
+#define LANES 2
+
+#define ADD(x, y)    _mm256_add_epi32(x, y)
+#define XOR(x, y)    _mm256_xor_si256(x, y)
+#define ROTL(x, n)   XOR(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#define SHUFFLE(x, n) _mm256_shuffle_epi32(x, n)
+
+static uint32_t le32dec(const uint8_t* p)
+{
+    return ((uint32_t)(p[0]) + ((uint32_t)(p[1]) << 8) +
+        ((uint32_t)(p[2]) << 16) + ((uint32_t)(p[3]) << 24));
+}
+
+static void le32enc(uint8_t* p, uint32_t x)
+{
+    p[0] = x & 0xff;
+    p[1] = (x >> 8) & 0xff;
+    p[2] = (x >> 16) & 0xff;
+    p[3] = (x >> 24) & 0xff;
+}
+
+/* Each row holds a diagonal of the salsa state (as in the sse2 kernel) of
+ * the first lane in its low half and of the second lane in its high half. */
+TARGET static void load(__m256i X[ROWS], const uint8_t blocks[LANES * 128])
+{
+    uint32_t words[LANES][32];
+    int lane, k, i;
+
+    for (lane = 0; lane < LANES; ++lane)
+        for (k = 0; k < 2; ++k)
+            for (i = 0; i < 16; ++i)
+                words[lane][k * 16 + i] = le32dec(
+                    &blocks[lane * 128 + (k * 16 + i * 5 % 16) * 4]);
+
+    for (i = 0; i < ROWS; ++i)
+        X[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i*)&words[0][i * 4])),
+            _mm_loadu_si128((const __m128i*)&words[1][i * 4]), 1);
+}
+
+TARGET static void store(uint8_t blocks[LANES * 128], const __m256i X[ROWS])
+{
+    uint32_t words[LANES][32];
+    int lane, k, i;
+
+    for (i = 0; i < ROWS; ++i)
+    {
+        _mm_storeu_si128((__m128i*)&words[0][i * 4],
+            _mm256_castsi256_si128(X[i]));
+        _mm_storeu_si128((__m128i*)&words[1][i * 4],
+            _mm256_extracti128_si256(X[i], 1));
+    }
+
+    for (lane = 0; lane < LANES; ++lane)
+        for (k = 0; k < 2; ++k)
+            for (i = 0; i < 16; ++i)
+                le32enc(&blocks[lane * 128 + (k * 16 + i * 5 % 16) * 4],
+                    words[lane][k * 16 + i]);
+}
+
+/* The shuffles operate within each 128 bit half, so lanes do not mix. */
+TARGET static void salsa20_8(__m256i B[4])
+{
+    __m256i X0 = B[0], X1 = B[1], X2 = B[2], X3 = B[3];
+    int i;
+
+    for (i = 0; i < 8; i += 2)
+    {
+        /* Operate on columns. */
+        X1 = XOR(X1, ROTL(ADD(X0, X3), 7));
+        X2 = XOR(X2, ROTL(ADD(X1, X0), 9));
+        X3 = XOR(X3, ROTL(ADD(X2, X1), 13));
+        X0 = XOR(X0, ROTL(ADD(X3, X2), 18));
+
+        /* Rearrange data. */
+        X1 = SHUFFLE(X1, 0x93);
+        X2 = SHUFFLE(X2, 0x4e);
+        X3 = SHUFFLE(X3, 0x39);
+
+        /* Operate on rows. */
+        X3 = XOR(X3, ROTL(ADD(X0, X1), 7));
+        X2 = XOR(X2, ROTL(ADD(X3, X0), 9));
+        X1 = XOR(X1, ROTL(ADD(X2, X3), 13));
+        X0 = XOR(X0, ROTL(ADD(X1, X2), 18));
+
+        /* Rearrange data. */
+        X1 = SHUFFLE(X1, 0x39);
+        X2 = SHUFFLE(X2, 0x4e);
+        X3 = SHUFFLE(X3, 0x93);
+    }
+
+    B[0] = ADD(B[0], X0);
+    B[1] = ADD(B[1], X1);
+    B[2] = ADD(B[2], X2);
+    B[3] = ADD(B[3], X3);
+}
+
+/* BlockMix (r=1) in place, B0 <-- H(B0 ^ B1), B1 <-- H(B1 ^ B0'). */
+TARGET static void blockmix(__m256i X[ROWS])
+{
+    int i;
+
+    for (i = 0; i < 4; ++i)
+        X[i] = XOR(X[i], X[i + 4]);
+
+    salsa20_8(&X[0]);
+
+    for (i = 0; i < 4; ++i)
+        X[i + 4] = XOR(X[i + 4], X[i]);
+
+    salsa20_8(&X[4]);
+}
+
+TARGET void ScryptSMix2AVX2(uint8_t blocks[LANES * 128], void* scratch)
+{
+    __m256i* V = (__m256i*)scratch;
+    __m256i X[ROWS];
+    uint32_t i, j0, j1;
+    int k;
+
+    load(X, blocks);
+
+    for (i = 0; i < N; ++i)
+    {
+        for (k = 0; k < ROWS; ++k)
+            V[i * ROWS + k] = X[k];
+
+        blockmix(X);
+    }
+
+    for (i = 0; i < N; ++i)
+    {
+        /* Each lane reads its own half of a possibly different row. */
+        j0 = (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(X[4])) &
+            (N - 1);
+        j1 = (uint32_t)_mm_cvtsi128_si32(_mm256_extracti128_si256(X[4], 1)) &
+            (N - 1);
+
+        for (k = 0; k < ROWS; ++k)
+            X[k] = XOR(X[k], _mm256_blend_epi32(V[j0 * ROWS + k],
+                V[j1 * ROWS + k], 0xf0));
+
+        blockmix(X);
+    }
+
+    store(blocks, X);
+}
+
+#endif
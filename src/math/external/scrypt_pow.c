@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scrypt_pow.h"
+
+#include <stdint.h>
+#include <string.h>
+#include "cpu_features.h"
+#include "pbkdf2_sha256.h"
+#include "scrypt_x86.h"
+
+#define N 1024
+#define BLOCK_LENGTH 128
+#define WORDS 32
+
+typedef void (*smix_function)(uint8_t block[BLOCK_LENGTH], void* scratch);
+typedef void (*smix2_function)(uint8_t blocks[2 * BLOCK_LENGTH],
+    void* scratch);
+
+static void ScryptSMixGeneric(uint8_t block[BLOCK_LENGTH], void* scratch);
+
+/* Engines are selected once at load, before any concurrent use. */
+static smix_function smix = ScryptSMixGeneric;
+static smix2_function smix2 = NULL;
+static const char* engines = "generic";
+
+#ifdef SCRYPT_X86
+
+__attribute__((constructor))
+static void ScryptSelect(void)
+{
+    CPUFeatures features;
+    CPUFeaturesProbe(&features);
+    const int sse2 = features.sse2;
+    const int avx2 = features.avx2;
+
+    if (sse2)
+        smix = ScryptSMixSSE2;
+
+    if (avx2)
+        smix2 = ScryptSMix2AVX2;
+
+    engines =
+        avx2 ? "avx2,sse2" :
+        sse2 ? "sse2" : "generic";
+}
+
+#endif
+
+static uint32_t le32dec(const uint8_t* p)
+{
+    return ((uint32_t)(p[0]) + ((uint32_t)(p[1]) << 8) +
+        ((uint32_t)(p[2]) << 16) + ((uint32_t)(p[3]) << 24));
+}
+
+static void le32enc(uint8_t* p, uint32_t x)
+{
+    p[0] = x & 0xff;
+    p[1] = (x >> 8) & 0xff;
+    p[2] = (x >> 16) & 0xff;
+    p[3] = (x >> 24) & 0xff;
+}
+
+#define R(a, b) (((a) << (b)) | ((a) >> (32 - (b))))
+
+/* Salsa20/8 core applied to host order words. */
+static void salsa20_8(uint32_t B[16])
+{
+    uint32_t x[16];
+    size_t i;
+
+    memcpy(x, B, sizeof(x));
+
+    for (i = 0; i < 8; i += 2)
+    {
+        /* Operate on columns. */
+        x[ 4] ^= R(x[ 0]+x[12], 7);  x[ 8] ^= R(x[ 4]+x[ 0], 9);
+        x[12] ^= R(x[ 8]+x[ 4],13);  x[ 0] ^= R(x[12]+x[ 8],18);
+        x[ 9] ^= R(x[ 5]+x[ 1], 7);  x[13] ^= R(x[ 9]+x[ 5], 9);
+        x[ 1] ^= R(x[13]+x[ 9],13);  x[ 5] ^= R(x[ 1]+x[13],18);
+        x[14] ^= R(x[10]+x[ 6], 7);  x[ 2] ^= R(x[14]+x[10], 9);
+        x[ 6] ^= R(x[ 2]+x[14],13);  x[10] ^= R(x[ 6]+x[ 2],18);
+        x[ 3] ^= R(x[15]+x[11], 7);  x[ 7] ^= R(x[ 3]+x[15], 9);
+        x[11] ^= R(x[ 7]+x[ 3],13);  x[15] ^= R(x[11]+x[ 7],18);
+
+        /* Operate on rows. */
+        x[ 1] ^= R(x[ 0]+x[ 3], 7);  x[ 2] ^= R(x[ 1]+x[ 0], 9);
+        x[ 3] ^= R(x[ 2]+x[ 1],13);  x[ 0] ^= R(x[ 3]+x[ 2],18);
+        x[ 6] ^= R(x[ 5]+x[ 4], 7);  x[ 7] ^= R(x[ 6]+x[ 5], 9);
+        x[ 4] ^= R(x[ 7]+x[ 6],13);  x[ 5] ^= R(x[ 4]+x[ 7],18);
+        x[11] ^= R(x[10]+x[ 9], 7);  x[ 8] ^= R(x[11]+x[10], 9);
+        x[ 9] ^= R(x[ 8]+x[11],13);  x[10] ^= R(x[ 9]+x[ 8],18);
+        x[12] ^= R(x[15]+x[14], 7);  x[13] ^= R(x[12]+x[15], 9);
+        x[14] ^= R(x[13]+x[12],13);  x[15] ^= R(x[14]+x[13],18);
+    }
+
+    for (i = 0; i < 16; ++i)
+        B[i] += x[i];
+}
+
+#undef R
+
+/* BlockMix (r=1) in place, B0 <-- H(B0 ^ B1), B1 <-- H(B1 ^ B0'). */
+static void blockmix(uint32_t X[WORDS])
+{
+    size_t i;
+
+    for (i = 0; i < 16; ++i)
+        X[i] ^= X[i + 16];
+
+    salsa20_8(&X[0]);
+
+    for (i = 0; i < 16; ++i)
+        X[i + 16] ^= X[i];
+
+    salsa20_8(&X[16]);
+}
+
+/* Word-wise SMix (N=1024, r=1), byte order is converted only at the ends. */
+static void ScryptSMixGeneric(uint8_t block[BLOCK_LENGTH], void* scratch)
+{
+    uint32_t* V = (uint32_t*)scratch;
+    uint32_t X[WORDS];
+    uint32_t i, j;
+    size_t k;
+
+    for (k = 0; k < WORDS; ++k)
+        X[k] = le32dec(&block[k * 4]);
+
+    for (i = 0; i < N; ++i)
+    {
+        memcpy(&V[i * WORDS], X, sizeof(X));
+        blockmix(X);
+    }
+
+    for (i = 0; i < N; ++i)
+    {
+        /* Integerify, the first word of the last block. */
+        j = X[16] & (N - 1);
+
+        for (k = 0; k < WORDS; ++k)
+            X[k] ^= V[j * WORDS + k];
+
+        blockmix(X);
+    }
+
+    for (k = 0; k < WORDS; ++k)
+        le32enc(&block[k * 4], X[k]);
+}
+
+void ScryptPOW(uint8_t hash[SCRYPT_POW_HASH_LENGTH], const uint8_t* data,
+    size_t length, void* scratch)
+{
+    uint8_t block[BLOCK_LENGTH];
+    pbkdf2_sha256(data, length, data, length, 1, block, BLOCK_LENGTH);
+    smix(block, scratch);
+    pbkdf2_sha256(data, length, block, BLOCK_LENGTH, 1, hash,
+        SCRYPT_POW_HASH_LENGTH);
+}
+
+void ScryptPOWBatch(uint8_t* hashes, const uint8_t* items, size_t length,
+    size_t count, void* scratch)
+{
+    uint8_t blocks[2 * BLOCK_LENGTH];
+
+    if (smix2 != NULL)
+    {
+        for (; count >= 2; count -= 2, items += 2 * length,
+            hashes += 2 * SCRYPT_POW_HASH_LENGTH)
+        {
+            const uint8_t* second = items + length;
+            pbkdf2_sha256(items, length, items, length, 1, blocks,
+                BLOCK_LENGTH);
+            pbkdf2_sha256(second, length, second, length, 1,
+                blocks + BLOCK_LENGTH, BLOCK_LENGTH);
+            smix2(blocks, scratch);
+            pbkdf2_sha256(items, length, blocks, BLOCK_LENGTH, 1, hashes,
+                SCRYPT_POW_HASH_LENGTH);
+            pbkdf2_sha256(second, length, blocks + BLOCK_LENGTH,
+                BLOCK_LENGTH, 1, hashes + SCRYPT_POW_HASH_LENGTH,
+                SCRYPT_POW_HASH_LENGTH);
+        }
+    }
+
+    for (; count > 0; --count, items += length,
+        hashes += SCRYPT_POW_HASH_LENGTH)
+        ScryptPOW(hashes, items, length, scratch);
+}
+
+const char* ScryptPOWEngines(void)
+{
+    return engines;
+}
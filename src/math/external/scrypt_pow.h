@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SCRYPT_POW_H
+#define LIBBITCOIN_SCRYPT_POW_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Scrypt proof of work parameters are N=1024, r=1, p=1 and 32 byte output. */
+#define SCRYPT_POW_HASH_LENGTH 32U
+
+/* Scratch for the widest (two lane) kernel, V is N * 128 bytes per lane. */
+#define SCRYPT_POW_SCRATCH_LENGTH (2U * 1024U * 128U)
+#define SCRYPT_POW_SCRATCH_ALIGNMENT 64U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Compute scrypt(data, data, 1024, 1, 1, 32), the scratch must be aligned to
+ * SCRYPT_POW_SCRATCH_ALIGNMENT and of SCRYPT_POW_SCRATCH_LENGTH bytes. The
+ * scratch is not allocated and may be reused across calls. */
+void ScryptPOW(uint8_t hash[SCRYPT_POW_HASH_LENGTH], const uint8_t* data,
+    size_t length, void* scratch);
+
+/* Compute ScryptPOW of count consecutive items of equal length, as many at
+ * once as the selected kernel has lanes. */
+void ScryptPOWBatch(uint8_t* hashes, const uint8_t* items, size_t length,
+    size_t count, void* scratch);
+
+/* Names of the kernels selected for this cpu. */
+const char* ScryptPOWEngines(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
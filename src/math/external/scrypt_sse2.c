@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scrypt_x86.h"
+
+#ifdef SCRYPT_X86
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#define TARGET __attribute__((target("sse2")))
+#define N 1024
+#define ROWS 8
+
+#define ADD(x, y)    _mm_add_epi32(x, y)
+#define XOR(x, y)    _mm_xor_si128(x, y)
+#define ROTL(x, n)   XOR(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+#define SHUFFLE(x, n) _mm_shuffle_epi32(x, n)
+
+static uint32_t le32dec(const uint8_t* p)
+{
+    return ((uint32_t)(p[0]) + ((uint32_t)(p[1]) << 8) +
+        ((uint32_t)(p[2]) << 16) + ((uint32_t)(p[3]) << 24));
+}
+
+static void le32enc(uint8_t* p, uint32_t x)
+{
+    p[0] = x & 0xff;
+    p[1] = (x >> 8) & 0xff;
+    p[2] = (x >> 16) & 0xff;
+    p[3] = (x >> 24) & 0xff;
+}
+
+/* Each row holds a diagonal of the salsa state, word i is moved from i*5%16,
+ * so that the column and row rounds operate on whole rows. */
+TARGET static void load(__m128i X[ROWS], const uint8_t block[128])
+{
+    uint32_t words[32];
+    int k, i;
+
+    for (k = 0; k < 2; ++k)
+        for (i = 0; i < 16; ++i)
+            words[k * 16 + i] = le32dec(&block[(k * 16 + i * 5 % 16) * 4]);
+
+    for (i = 0; i < ROWS; ++i)
+        X[i] = _mm_loadu_si128((const __m128i*)&words[i * 4]);
+}
+
+TARGET static void store(uint8_t block[128], const __m128i X[ROWS])
+{
+    uint32_t words[32];
+    int k, i;
+
+    for (i = 0; i < ROWS; ++i)
+        _mm_storeu_si128((__m128i*)&words[i * 4], X[i]);
+
+    for (k = 0; k < 2; ++k)
+        for (i = 0; i < 16; ++i)
+            le32enc(&block[(k * 16 + i * 5 % 16) * 4], words[k * 16 + i]);
+}
+
+TARGET static void salsa20_8(__m128i B[4])
+{
+    __m128i X0 = B[0], X1 = B[1], X2 = B[2], X3 = B[3];
+    int i;
+
+    for (i = 0; i < 8; i += 2)
+    {
+        /* Operate on columns. */
+        X1 = XOR(X1, ROTL(ADD(X0, X3), 7));
+        X2 = XOR(X2, ROTL(ADD(X1, X0), 9));
+        X3 = XOR(X3, ROTL(ADD(X2, X1), 13));
+        X0 = XOR(X0, ROTL(ADD(X3, X2), 18));
+
+        /* Rearrange data. */
+        X1 = SHUFFLE(X1, 0x93);
+        X2 = SHUFFLE(X2, 0x4e);
+        X3 = SHUFFLE(X3, 0x39);
+
+        /* Operate on rows. */
+        X3 = XOR(X3, ROTL(ADD(X0, X1), 7));
+        X2 = XOR(X2, ROTL(ADD(X3, X0), 9));
+        X1 = XOR(X1, ROTL(ADD(X2, X3), 13));
+        X0 = XOR(X0, ROTL(ADD(X1, X2), 18));
+
+        /* Rearrange data. */
+        X1 = SHUFFLE(X1, 0x39);
+        X2 = SHUFFLE(X2, 0x4e);
+        X3 = SHUFFLE(X3, 0x93);
+    }
+
+    B[0] = ADD(B[0], X0);
+    B[1] = ADD(B[1], X1);
+    B[2] = ADD(B[2], X2);
+    B[3] = ADD(B[3], X3);
+}
+
+/* BlockMix (r=1) in place, B0 <-- H(B0 ^ B1), B1 <-- H(B1 ^ B0'). */
+TARGET static void blockmix(__m128i X[ROWS])
+{
+    int i;
+
+    for (i = 0; i < 4; ++i)
+        X[i] = XOR(X[i], X[i + 4]);
+
+    salsa20_8(&X[0]);
+
+    for (i = 0; i < 4; ++i)
+        X[i + 4] = XOR(X[i + 4], X[i]);
+
+    salsa20_8(&X[4]);
+}
+
+TARGET void ScryptSMixSSE2(uint8_t block[128], void* scratch)
+{
+    __m128i* V = (__m128i*)scratch;
+    __m128i X[ROWS];
+    uint32_t i, j;
+    int k;
+
+    load(X, block);
+
+    for (i = 0; i < N; ++i)
+    {
+        for (k = 0; k < ROWS; ++k)
+            V[i * ROWS + k] = X[k];
+
+        blockmix(X);
+    }
+
+    for (i = 0; i < N; ++i)
+    {
+        /* Integerify, the first word of the last block is not moved. */
+        j = (uint32_t)_mm_cvtsi128_si32(X[4]) & (N - 1);
+
+        for (k = 0; k < ROWS; ++k)
+            X[k] = XOR(X[k], V[j * ROWS + k]);
+
+        blockmix(X);
+    }
+
+    store(block, X);
+}
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SCRYPT_X86_H
+#define LIBBITCOIN_SCRYPT_X86_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Vectorized kernels require gcc/clang function-level target attributes. */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define SCRYPT_X86
+#endif
+
+#ifdef SCRYPT_X86
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Requires sse2, computes SMix (N=1024, r=1) of one 128 byte block in place.
+ * The scratch must be 16 byte aligned and of 128 KiB. */
+void ScryptSMixSSE2(uint8_t block[128], void* scratch);
+
+/* Requires avx2, computes SMix (N=1024, r=1) of two consecutive 128 byte
+ * blocks in place. The scratch must be 32 byte aligned and of 256 KiB. */
+void ScryptSMix2AVX2(uint8_t blocks[2 * 128], void* scratch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
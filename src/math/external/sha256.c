@@ -27,6 +27,8 @@
 
 #include <stdint.h>
 #include <string.h>
+#include "cpu_features.h"
+#include "sha256_x86.h"
 #include "zeroize.h"
 
 static uint32_t be32dec(const void* pp)
@@ -95,9 +97,144 @@ static unsigned char PAD[SHA256_BLOCK_LENGTH] =
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+/* Padding block of a 64 byte message. */
+static const uint8_t PAD64[SHA256_BLOCK_LENGTH] =
+{
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0
+};
+
+/* Padding half block of a 32 byte message. */
+static const uint8_t PAD32[SHA256_DIGEST_LENGTH] =
+{
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0
+};
+
+static const uint32_t IV[SHA256_STATE_LENGTH] =
+{
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+typedef void (*transform_function)(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+typedef void (*double64_function)(uint8_t* digests, const uint8_t* blocks);
+
 void SHA256Pad(SHA256CTX* context);
-void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
+static void SHA256TransformBlock(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH]);
+static void SHA256TransformGeneric(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+static void SHA256Double64Generic(uint8_t digest[SHA256_DIGEST_LENGTH],
     const uint8_t block[SHA256_BLOCK_LENGTH]);
+static void SHA256Double64Transform(transform_function single,
+    uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH]);
+
+/* Engines are selected once at load, before any concurrent use. */
+static transform_function transform = SHA256TransformGeneric;
+static double64_function double64_8way = NULL;
+static double64_function double64_4way = NULL;
+static const char* engines = "generic";
+
+#ifdef SHA256_X86
+
+__attribute__((constructor))
+static void SHA256Select(void)
+{
+    CPUFeatures features;
+    CPUFeaturesProbe(&features);
+    const int sse41 = features.sse41;
+    const int avx2 = features.avx2;
+    const int shani = sse41 && features.sha;
+
+    if (shani)
+        transform = SHA256TransformSHANI;
+
+    if (avx2)
+        double64_8way = SHA256Double64AVX2;
+
+    /* A single sha-ni lane outperforms four sse4.1 lanes. */
+    if (sse41 && !shani)
+        double64_4way = SHA256Double64SSE41;
+
+    engines =
+        shani && avx2 ? "sha-ni,avx2" :
+        shani ? "sha-ni" :
+        avx2 ? "avx2,sse4.1" :
+        sse41 ? "sse4.1" : "generic";
+}
+
+#endif
+
+const char* SHA256Engines(void)
+{
+    return engines;
+}
+
+void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    transform(state, blocks, count);
+}
+
+void SHA256Double64(uint8_t* digests, const uint8_t* blocks, size_t count)
+{
+    if (double64_8way != NULL)
+        for (; count >= 8; count -= 8, digests += 8 * 32, blocks += 8 * 64)
+            double64_8way(digests, blocks);
+
+    if (double64_4way != NULL)
+        for (; count >= 4; count -= 4, digests += 4 * 32, blocks += 4 * 64)
+            double64_4way(digests, blocks);
+
+    for (; count != 0; --count, digests += 32, blocks += 64)
+        SHA256Double64Generic(digests, blocks);
+}
+
+int SHA256Double64Engine(uint8_t* digests, const uint8_t* blocks,
+    size_t count, const char* engine)
+{
+    transform_function single = SHA256TransformGeneric;
+    double64_function lanes = NULL;
+    size_t width = 1;
+
+#ifdef SHA256_X86
+    CPUFeatures features;
+    CPUFeaturesProbe(&features);
+
+    if (strcmp(engine, "sha-ni") == 0 && features.sse41 && features.sha)
+    {
+        single = SHA256TransformSHANI;
+    }
+    else if (strcmp(engine, "sse4.1") == 0 && features.sse41)
+    {
+        lanes = SHA256Double64SSE41;
+        width = 4;
+    }
+    else if (strcmp(engine, "avx2") == 0 && features.avx2)
+    {
+        lanes = SHA256Double64AVX2;
+        width = 8;
+    }
+    else
+#endif
+    if (strcmp(engine, "generic") != 0)
+        return 0;
+
+    if (lanes != NULL)
+        for (; count >= width; count -= width, digests += width * 32,
+            blocks += width * 64)
+            lanes(digests, blocks);
+
+    for (; count != 0; --count, digests += 32, blocks += 64)
+        SHA256Double64Transform(single, digests, blocks);
+
+    return 1;
+}
 
 void SHA256_(const uint8_t* input, size_t length,
     uint8_t digest[SHA256_DIGEST_LENGTH])
@@ -112,14 +249,7 @@ void SHA256Init(SHA256CTX* context)
 {
     context->count[0] = context->count[1] = 0;
 
-    context->state[0] = 0x6A09E667;
-    context->state[1] = 0xBB67AE85;
-    context->state[2] = 0x3C6EF372;
-    context->state[3] = 0xA54FF53A;
-    context->state[4] = 0x510E527F;
-    context->state[5] = 0x9B05688C;
-    context->state[6] = 0x1F83D9AB;
-    context->state[7] = 0x5BE0CD19;
+    memcpy(context->state, IV, sizeof IV);
 }
 
 void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length)
@@ -144,16 +274,16 @@ void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length)
     }
 
     memcpy(&context->buf[r], input, 64 - r);
-    SHA256Transform(context->state, context->buf);
+    transform(context->state, context->buf, 1);
 
     input += 64 - r;
     length -= 64 - r;
 
-    while (length >= 64)
+    if (length >= 64)
     {
-        SHA256Transform(context->state, input);
-        input += 64;
-        length -= 64;
+        transform(context->state, input, length / 64);
+        input += length & ~(size_t)63;
+        length &= 63;
     }
 
     memcpy(context->buf, input, length);
@@ -182,7 +312,41 @@ void SHA256Pad(SHA256CTX* context)
     SHA256Update(context, len, 8);
 }
 
-void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
+/* The digest may alias the block. */
+static void SHA256Double64Generic(uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH])
+{
+    SHA256Double64Transform(transform, digest, block);
+}
+
+/* The digest may alias the block. */
+static void SHA256Double64Transform(transform_function single,
+    uint8_t digest[SHA256_DIGEST_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH])
+{
+    uint32_t state[SHA256_STATE_LENGTH];
+    uint8_t buffer[SHA256_BLOCK_LENGTH];
+
+    memcpy(state, IV, sizeof IV);
+    single(state, block, 1);
+    single(state, PAD64, 1);
+
+    be32enc_vect(buffer, state, SHA256_DIGEST_LENGTH);
+    memcpy(buffer + SHA256_DIGEST_LENGTH, PAD32, sizeof PAD32);
+
+    memcpy(state, IV, sizeof IV);
+    single(state, buffer, 1);
+    be32enc_vect(digest, state, SHA256_DIGEST_LENGTH);
+}
+
+static void SHA256TransformGeneric(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+    for (; count != 0; --count, blocks += SHA256_BLOCK_LENGTH)
+        SHA256TransformBlock(state, blocks);
+}
+
+static void SHA256TransformBlock(uint32_t state[SHA256_STATE_LENGTH],
     const uint8_t block[SHA256_BLOCK_LENGTH])
 {
     int i;
@@ -53,6 +53,22 @@ void SHA256Init(SHA256CTX* context);
 void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length);
 void SHA256Final(SHA256CTX* context, uint8_t digest[SHA256_DIGEST_LENGTH]);
 
+/* Transform consecutive blocks with the fastest engine for this cpu. */
+void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count);
+
+/* Double hash consecutive 64 byte blocks, digests may alias the blocks. */
+void SHA256Double64(uint8_t* digests, const uint8_t* blocks, size_t count);
+
+/* Double hash consecutive 64 byte blocks with the named engine (generic,
+ * sha-ni, sse4.1 or avx2) whether or not it is selected for this cpu, with a
+ * portable single block tail. Returns zero if unknown or not supported. */
+int SHA256Double64Engine(uint8_t* digests, const uint8_t* blocks,
+    size_t count, const char* engine);
+
+/* Names of the engines selected for this cpu (comma separated). */
+const char* SHA256Engines(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256_x86.h"
+
+#ifdef SHA256_X86
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#define TARGET __attribute__((target("avx2")))
+#define LANES 8
+
+#define SET(x)       _mm256_set1_epi32((int)(x))
+#define ADD(x, y)    _mm256_add_epi32(x, y)
+#define XOR(x, y)    _mm256_xor_si256(x, y)
+#define AND(x, y)    _mm256_and_si256(x, y)
+#define OR(x, y)     _mm256_or_si256(x, y)
+#define SHR(x, n)    _mm256_srli_epi32(x, n)
+#define ROTR(x, n)   OR(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define Ch(x, y, z)  XOR(z, AND(x, XOR(y, z)))
+#define Maj(x, y, z) OR(AND(x, y), AND(z, OR(x, y)))
+#define S0(x)        XOR(XOR(ROTR(x, 2), ROTR(x, 13)), ROTR(x, 22))
+#define S1(x)        XOR(XOR(ROTR(x, 6), ROTR(x, 11)), ROTR(x, 25))
+#define s0(x)        XOR(XOR(ROTR(x, 7), ROTR(x, 18)), SHR(x, 3))
+#define s1(x)        XOR(XOR(ROTR(x, 17), ROTR(x, 19)), SHR(x, 10))
+
+static const uint32_t K[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t IV[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+TARGET static void initialize(__m256i state[8])
+{
+    int i;
+    for (i = 0; i < 8; ++i)
+        state[i] = SET(IV[i]);
+}
+
+/* Each vector holds the same word of each lane's message schedule. */
+TARGET static void compress(__m256i state[8], __m256i W[64])
+{
+    int i;
+    __m256i t1, t2;
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (i = 16; i < 64; ++i)
+        W[i] = ADD(ADD(s1(W[i - 2]), W[i - 7]), ADD(s0(W[i - 15]), W[i - 16]));
+
+    for (i = 0; i < 64; ++i)
+    {
+        t1 = ADD(ADD(ADD(h, S1(e)), ADD(Ch(e, f, g), SET(K[i]))), W[i]);
+        t2 = ADD(S0(a), Maj(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = ADD(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = ADD(t1, t2);
+    }
+
+    state[0] = ADD(state[0], a);
+    state[1] = ADD(state[1], b);
+    state[2] = ADD(state[2], c);
+    state[3] = ADD(state[3], d);
+    state[4] = ADD(state[4], e);
+    state[5] = ADD(state[5], f);
+    state[6] = ADD(state[6], g);
+    state[7] = ADD(state[7], h);
+}
+
+/* In-place 4x4 transpose of 32 bit words within each 128 bit half. */
+TARGET static void transpose(__m256i* x0, __m256i* x1, __m256i* x2,
+    __m256i* x3)
+{
+    const __m256i t0 = _mm256_unpacklo_epi32(*x0, *x1);
+    const __m256i t1 = _mm256_unpacklo_epi32(*x2, *x3);
+    const __m256i t2 = _mm256_unpackhi_epi32(*x0, *x1);
+    const __m256i t3 = _mm256_unpackhi_epi32(*x2, *x3);
+    *x0 = _mm256_unpacklo_epi64(t0, t1);
+    *x1 = _mm256_unpackhi_epi64(t0, t1);
+    *x2 = _mm256_unpacklo_epi64(t2, t3);
+    *x3 = _mm256_unpackhi_epi64(t2, t3);
+}
+
+/* Lane i is in the low half and lane i + 4 in the high half. */
+TARGET static __m256i load(const uint8_t* low, const uint8_t* high)
+{
+    const __m256i swap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5,
+        6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m256i value = _mm256_inserti128_si256(_mm256_castsi128_si256(
+        _mm_loadu_si128((const __m128i*)low)),
+        _mm_loadu_si128((const __m128i*)high), 1);
+    return _mm256_shuffle_epi8(value, swap);
+}
+
+TARGET static void store(uint8_t* low, uint8_t* high, __m256i value)
+{
+    const __m256i swap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5,
+        6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m256i swapped = _mm256_shuffle_epi8(value, swap);
+    _mm_storeu_si128((__m128i*)low, _mm256_castsi256_si128(swapped));
+    _mm_storeu_si128((__m128i*)high, _mm256_extracti128_si256(swapped, 1));
+}
+
+TARGET void SHA256Double64AVX2(uint8_t digests[8 * 32],
+    const uint8_t* blocks)
+{
+    int i, word;
+    __m256i W[64];
+    __m256i state[8];
+
+    /* All blocks are read before any digest is written (may alias). */
+    for (word = 0; word < 16; word += 4)
+    {
+        for (i = 0; i < LANES / 2; ++i)
+            W[word + i] = load(blocks + i * 64 + word * 4,
+                blocks + (i + 4) * 64 + word * 4);
+
+        transpose(&W[word], &W[word + 1], &W[word + 2], &W[word + 3]);
+    }
+
+    initialize(state);
+    compress(state, W);
+
+    /* Padding block of the 64 byte message. */
+    W[0] = SET(0x80000000);
+    for (i = 1; i < 15; ++i)
+        W[i] = _mm256_setzero_si256();
+    W[15] = SET(512);
+    compress(state, W);
+
+    /* Single block of the 32 byte first hash and its padding. */
+    for (i = 0; i < 8; ++i)
+        W[i] = state[i];
+    W[8] = SET(0x80000000);
+    for (i = 9; i < 15; ++i)
+        W[i] = _mm256_setzero_si256();
+    W[15] = SET(256);
+    initialize(state);
+    compress(state, W);
+
+    for (word = 0; word < 8; word += 4)
+    {
+        transpose(&state[word], &state[word + 1], &state[word + 2],
+            &state[word + 3]);
+
+        for (i = 0; i < LANES / 2; ++i)
+            store(digests + i * 32 + word * 4,
+                digests + (i + 4) * 32 + word * 4, state[word + i]);
+    }
+}
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256_x86.h"
+
+#ifdef SHA256_X86
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#define TARGET __attribute__((target("sha,sse4.1")))
+
+static const uint32_t K[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* Four rounds, the state is held as (ABEF, CDGH). */
+#define QUAD_ROUND(abef, cdgh, message, round) \
+{ \
+    const __m128i k = _mm_add_epi32(message, \
+        _mm_loadu_si128((const __m128i*)&K[(round) * 4])); \
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, k); \
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(k, 0x0e)); \
+}
+
+/* Partial schedule of the next four words (w[i] + s0(w[i + 1])). */
+#define SCHEDULE_A(m0, m1) \
+    m0 = _mm_sha256msg1_epu32(m0, m1)
+
+/* Completes the schedule of m2 from the preceding twelve words. */
+#define SCHEDULE_C(m0, m1, m2) \
+    m2 = _mm_sha256msg2_epu32(_mm_add_epi32(m2, \
+        _mm_alignr_epi8(m1, m0, 4)), m1)
+
+#define SCHEDULE_B(m0, m1, m2) \
+    SCHEDULE_C(m0, m1, m2); \
+    SCHEDULE_A(m0, m1)
+
+TARGET static __m128i load(const uint8_t* data)
+{
+    const __m128i swap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6,
+        7, 0, 1, 2, 3);
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), swap);
+}
+
+TARGET void SHA256TransformSHANI(uint32_t state[8], const uint8_t* blocks,
+    size_t count)
+{
+    __m128i m0, m1, m2, m3, abef, cdgh, saved_abef, saved_cdgh;
+
+    /* Reorder (ABCD, EFGH) into the (ABEF, CDGH) instruction layout. */
+    const __m128i abcd = _mm_loadu_si128((const __m128i*)&state[0]);
+    const __m128i efgh = _mm_loadu_si128((const __m128i*)&state[4]);
+    const __m128i badc = _mm_shuffle_epi32(abcd, 0xb1);
+    const __m128i hgfe = _mm_shuffle_epi32(efgh, 0x1b);
+    abef = _mm_alignr_epi8(badc, hgfe, 8);
+    cdgh = _mm_blend_epi16(hgfe, badc, 0xf0);
+
+    for (; count != 0; --count, blocks += 64)
+    {
+        saved_abef = abef;
+        saved_cdgh = cdgh;
+
+        m0 = load(blocks);
+        QUAD_ROUND(abef, cdgh, m0, 0);
+        m1 = load(blocks + 16);
+        QUAD_ROUND(abef, cdgh, m1, 1);
+        SCHEDULE_A(m0, m1);
+        m2 = load(blocks + 32);
+        QUAD_ROUND(abef, cdgh, m2, 2);
+        SCHEDULE_A(m1, m2);
+        m3 = load(blocks + 48);
+        QUAD_ROUND(abef, cdgh, m3, 3);
+        SCHEDULE_B(m2, m3, m0);
+        QUAD_ROUND(abef, cdgh, m0, 4);
+        SCHEDULE_B(m3, m0, m1);
+        QUAD_ROUND(abef, cdgh, m1, 5);
+        SCHEDULE_B(m0, m1, m2);
+        QUAD_ROUND(abef, cdgh, m2, 6);
+        SCHEDULE_B(m1, m2, m3);
+        QUAD_ROUND(abef, cdgh, m3, 7);
+        SCHEDULE_B(m2, m3, m0);
+        QUAD_ROUND(abef, cdgh, m0, 8);
+        SCHEDULE_B(m3, m0, m1);
+        QUAD_ROUND(abef, cdgh, m1, 9);
+        SCHEDULE_B(m0, m1, m2);
+        QUAD_ROUND(abef, cdgh, m2, 10);
+        SCHEDULE_B(m1, m2, m3);
+        QUAD_ROUND(abef, cdgh, m3, 11);
+        SCHEDULE_B(m2, m3, m0);
+        QUAD_ROUND(abef, cdgh, m0, 12);
+        SCHEDULE_B(m3, m0, m1);
+        QUAD_ROUND(abef, cdgh, m1, 13);
+        SCHEDULE_C(m0, m1, m2);
+        QUAD_ROUND(abef, cdgh, m2, 14);
+        SCHEDULE_C(m1, m2, m3);
+        QUAD_ROUND(abef, cdgh, m3, 15);
+
+        abef = _mm_add_epi32(abef, saved_abef);
+        cdgh = _mm_add_epi32(cdgh, saved_cdgh);
+    }
+
+    /* Restore the (ABCD, EFGH) state layout. */
+    {
+        const __m128i reversed = _mm_shuffle_epi32(abef, 0x1b);
+        const __m128i swapped = _mm_shuffle_epi32(cdgh, 0xb1);
+        _mm_storeu_si128((__m128i*)&state[0],
+            _mm_blend_epi16(reversed, swapped, 0xf0));
+        _mm_storeu_si128((__m128i*)&state[4],
+            _mm_alignr_epi8(swapped, reversed, 8));
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SHA256_X86_H
+#define LIBBITCOIN_SHA256_X86_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Vectorized kernels require gcc/clang function-level target attributes. */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define SHA256_X86
+#endif
+
+#ifdef SHA256_X86
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Requires sha and sse4.1, transforms count consecutive blocks. */
+void SHA256TransformSHANI(uint32_t state[8], const uint8_t* blocks,
+    size_t count);
+
+/* Requires sse4.1, double hashes four consecutive 64 byte blocks. */
+void SHA256Double64SSE41(uint8_t digests[4 * 32], const uint8_t* blocks);
+
+/* Requires avx2, double hashes eight consecutive 64 byte blocks. */
+void SHA256Double64AVX2(uint8_t digests[8 * 32], const uint8_t* blocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
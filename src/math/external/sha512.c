@@ -27,8 +27,12 @@
 
 #include <string.h>
 #include <stdint.h>
+#include "cpu_features.h"
+#include "sha512_x86.h"
 #include "zeroize.h"
 
+typedef void(*final64_function)(uint64_t*, const uint64_t*);
+
 static uint64_t be64dec(const void* pp)
 {
     const uint8_t* p = (uint8_t const*)pp;
@@ -108,6 +112,37 @@ static unsigned char PAD[SHA512_BLOCK_LENGTH] =
 void SHA512Pad(SHA512CTX* context);
 void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
     const uint8_t block[SHA512_BLOCK_LENGTH]);
+static void SHA512Compress(uint64_t state[SHA512_STATE_LENGTH],
+    uint64_t W[80]);
+static void SHA512Final64Generic(uint64_t words[SHA512_STATE_LENGTH],
+    const uint64_t state[SHA512_STATE_LENGTH]);
+
+/* Engines are selected once at load, before any concurrent use. */
+static final64_function final64_4way = NULL;
+
+#ifdef SHA512_X86
+
+__attribute__((constructor))
+static void SHA512Select(void)
+{
+    CPUFeatures features;
+    CPUFeaturesProbe(&features);
+
+    if (features.avx2)
+        final64_4way = SHA512Final64AVX2;
+}
+
+#endif
+
+void SHA512Final64(uint64_t* words, const uint64_t* states, size_t count)
+{
+    if (final64_4way != NULL)
+        for (; count >= 4; count -= 4, words += 4 * 8, states += 4 * 8)
+            final64_4way(words, states);
+
+    for (; count != 0; --count, words += 8, states += 8)
+        SHA512Final64Generic(words, states);
+}
 
 void SHA512_(const uint8_t* input, size_t length,
     uint8_t digest[SHA512_DIGEST_LENGTH])
@@ -178,6 +213,25 @@ void SHA512Final(SHA512CTX* context, uint8_t digest[SHA512_DIGEST_LENGTH])
 
 /* Local */
 
+/* The message follows one absorbed block, so its length is 1536 bits. */
+static void SHA512Final64Generic(uint64_t words[SHA512_STATE_LENGTH],
+    const uint64_t state[SHA512_STATE_LENGTH])
+{
+    int i;
+    uint64_t W[80];
+
+    memcpy(W, words, 64);
+    W[8] = 0x8000000000000000ULL;
+    for (i = 9; i < 15; i++)
+        W[i] = 0;
+    W[15] = (SHA512_BLOCK_LENGTH + 64) * 8;
+
+    memcpy(words, state, 64);
+    SHA512Compress(words, W);
+
+    zeroize((void*)W, sizeof W);
+}
+
 void SHA512Pad(SHA512CTX* context)
 {
     uint8_t len[16];
@@ -195,12 +249,21 @@ void SHA512Pad(SHA512CTX* context)
 void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
     const uint8_t block[SHA512_BLOCK_LENGTH])
 {
-    int i;
     uint64_t W[80];
-    uint64_t S[8];
-    uint64_t t0, t1;
 
     be64dec_vect(W, block, SHA512_BLOCK_LENGTH);
+    SHA512Compress(state, W);
+
+    zeroize((void*)W, sizeof W);
+}
+
+/* The first 16 words of W are the block, the remainder is the schedule. */
+static void SHA512Compress(uint64_t state[SHA512_STATE_LENGTH],
+    uint64_t W[80])
+{
+    int i;
+    uint64_t S[8];
+    uint64_t t0, t1;
 
     for (i = 16; i < 80; i++)
     {
@@ -295,7 +358,6 @@ void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
         state[i] += S[i];
     }
 
-    zeroize((void*)W, sizeof W);
     zeroize((void*)S, sizeof S);
     zeroize((void*)&t0, sizeof t0);
     zeroize((void*)&t1, sizeof t1);
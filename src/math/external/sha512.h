@@ -53,6 +53,11 @@ void SHA512Init(SHA512CTX* context);
 void SHA512Update(SHA512CTX* context, const uint8_t* input, size_t length);
 void SHA512Final(SHA512CTX* context, uint8_t digest[SHA512_DIGEST_LENGTH]);
 
+/* Finalize count midstates, each having absorbed exactly one block, over 64
+ * byte messages of big endian words. Lane i reads its state at states + 8i
+ * and its message at words + 8i, where its digest words are then written. */
+void SHA512Final64(uint64_t* words, const uint64_t* states, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha512_x86.h"
+
+#ifdef SHA512_X86
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#define TARGET __attribute__((target("avx2")))
+#define LANES 4
+
+#define SET(x)       _mm256_set1_epi64x((long long)(x))
+#define ADD(x, y)    _mm256_add_epi64(x, y)
+#define XOR(x, y)    _mm256_xor_si256(x, y)
+#define AND(x, y)    _mm256_and_si256(x, y)
+#define OR(x, y)     _mm256_or_si256(x, y)
+#define SHR(x, n)    _mm256_srli_epi64(x, n)
+#define ROTR(x, n)   OR(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+#define Ch(x, y, z)  XOR(z, AND(x, XOR(y, z)))
+#define Maj(x, y, z) OR(AND(x, y), AND(z, OR(x, y)))
+#define S0(x)        XOR(XOR(ROTR(x, 28), ROTR(x, 34)), ROTR(x, 39))
+#define S1(x)        XOR(XOR(ROTR(x, 14), ROTR(x, 18)), ROTR(x, 41))
+#define s0(x)        XOR(XOR(ROTR(x, 1), ROTR(x, 8)), SHR(x, 7))
+#define s1(x)        XOR(XOR(ROTR(x, 19), ROTR(x, 61)), SHR(x, 6))
+
+static const uint64_t K[80] =
+{
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+/* Each vector holds the same word of each lane's message schedule. */
+TARGET static void compress(__m256i state[8], __m256i W[80])
+{
+    int i;
+    __m256i t1, t2;
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (i = 16; i < 80; ++i)
+        W[i] = ADD(ADD(s1(W[i - 2]), W[i - 7]), ADD(s0(W[i - 15]), W[i - 16]));
+
+    for (i = 0; i < 80; ++i)
+    {
+        t1 = ADD(ADD(ADD(h, S1(e)), ADD(Ch(e, f, g), SET(K[i]))), W[i]);
+        t2 = ADD(S0(a), Maj(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = ADD(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = ADD(t1, t2);
+    }
+
+    state[0] = ADD(state[0], a);
+    state[1] = ADD(state[1], b);
+    state[2] = ADD(state[2], c);
+    state[3] = ADD(state[3], d);
+    state[4] = ADD(state[4], e);
+    state[5] = ADD(state[5], f);
+    state[6] = ADD(state[6], g);
+    state[7] = ADD(state[7], h);
+}
+
+/* Gather word i of each of the four lanes, which are eight words apart. */
+TARGET static __m256i load(const uint64_t* lanes, int i)
+{
+    return _mm256_set_epi64x((long long)lanes[3 * 8 + i],
+        (long long)lanes[2 * 8 + i], (long long)lanes[8 + i],
+        (long long)lanes[i]);
+}
+
+TARGET static void store(uint64_t* lanes, int i, __m256i value)
+{
+    uint64_t words[LANES];
+    _mm256_storeu_si256((__m256i*)words, value);
+    lanes[i] = words[0];
+    lanes[8 + i] = words[1];
+    lanes[2 * 8 + i] = words[2];
+    lanes[3 * 8 + i] = words[3];
+}
+
+TARGET void SHA512Final64AVX2(uint64_t words[4 * 8],
+    const uint64_t states[4 * 8])
+{
+    int i;
+    __m256i W[80];
+    __m256i state[8];
+
+    for (i = 0; i < 8; ++i)
+    {
+        W[i] = load(words, i);
+        state[i] = load(states, i);
+    }
+
+    /* Padding of the 64 byte message that follows the absorbed block. */
+    W[8] = SET(0x8000000000000000ULL);
+    for (i = 9; i < 15; ++i)
+        W[i] = _mm256_setzero_si256();
+    W[15] = SET((128 + 64) * 8);
+
+    compress(state, W);
+
+    for (i = 0; i < 8; ++i)
+        store(words, i, state[i]);
+}
+
+#endif
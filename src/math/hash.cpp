@@ -22,13 +22,21 @@
 #include <cstddef>
 #include <cstdint>
 #include <errno.h>
+#include <memory>
 #include <new>
+#include <random>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
 #include "../math/external/crypto_scrypt.h"
 #include "../math/external/hmac_sha256.h"
 #include "../math/external/hmac_sha512.h"
 #include "../math/external/pkcs5_pbkdf2.h"
 #include "../math/external/ripemd160.h"
+#include "../math/external/scrypt_pow.h"
 #include "../math/external/sha1.h"
 #include "../math/external/sha256.h"
 #include "../math/external/sha512.h"
@@ -37,12 +45,123 @@ namespace libbitcoin {
 
 hash_digest bitcoin_hash(data_slice data)
 {
+    // A single block (such as a merkle pair) avoids the hashing context.
+    if (data.size() == SHA256_BLOCK_LENGTH)
+    {
+        hash_digest hash;
+        SHA256Double64(hash.data(), data.data(), 1);
+        return hash;
+    }
+
     return sha256_hash(sha256_hash(data));
 }
 
+hash_list bitcoin_hash_blocks(data_slice blocks)
+{
+    hash_list hashes(blocks.size() / SHA256_BLOCK_LENGTH);
+
+    if (!hashes.empty())
+        SHA256Double64(hashes.front().data(), blocks.data(), hashes.size());
+
+    return hashes;
+}
+
+bool bitcoin_hash_blocks(hash_list& out, data_slice blocks,
+    const std::string& engine)
+{
+    out.resize(blocks.size() / SHA256_BLOCK_LENGTH);
+    const auto digests = out.empty() ? nullptr : out.front().data();
+    return SHA256Double64Engine(digests, blocks.data(), out.size(),
+        engine.c_str()) != 0;
+}
+
+std::string sha256_engines()
+{
+    return SHA256Engines();
+}
+
+// Scrypt scratch is too large for the stack and costly to allocate for each
+// hash, so released buffers are retained for reuse by any thread.
+class scrypt_scratch
+  : noncopyable
+{
+public:
+    scrypt_scratch()
+      : buffer_(acquire())
+    {
+        if (!buffer_)
+            buffer_.reset(new uint8_t[SCRYPT_POW_SCRATCH_LENGTH + align]);
+    }
+
+    ~scrypt_scratch()
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(mutex_);
+
+        buffers_.push_back(std::move(buffer_));
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    void* data() const
+    {
+        const auto address = reinterpret_cast<uintptr_t>(buffer_.get());
+        return buffer_.get() + (align - address % align) % align;
+    }
+
+private:
+    typedef std::unique_ptr<uint8_t[]> buffer;
+    static const size_t align = SCRYPT_POW_SCRATCH_ALIGNMENT;
+
+    // Returns a released buffer, or null if there is none.
+    static buffer acquire()
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(mutex_);
+
+        if (buffers_.empty())
+            return nullptr;
+
+        auto out = std::move(buffers_.back());
+        buffers_.pop_back();
+        return out;
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    static shared_mutex mutex_;
+    static std::vector<buffer> buffers_;
+    buffer buffer_;
+};
+
+shared_mutex scrypt_scratch::mutex_;
+std::vector<scrypt_scratch::buffer> scrypt_scratch::buffers_;
+
 hash_digest scrypt_hash(data_slice data)
 {
-    return scrypt<hash_size>(data, data, 1024u, 1u, 1u);
+    hash_digest hash;
+    const scrypt_scratch scratch;
+    ScryptPOW(hash.data(), data.data(), data.size(), scratch.data());
+    return hash;
+}
+
+hash_list scrypt_hash_blocks(data_slice blocks, size_t block_size)
+{
+    hash_list hashes(block_size == 0 ? 0 : blocks.size() / block_size);
+
+    if (!hashes.empty())
+    {
+        const scrypt_scratch scratch;
+        ScryptPOWBatch(hashes.front().data(), blocks.data(), block_size,
+            hashes.size(), scratch.data());
+    }
+
+    return hashes;
+}
+
+std::string scrypt_engines()
+{
+    return ScryptPOWEngines();
 }
 
 short_hash bitcoin_short_hash(data_slice data)
@@ -137,6 +256,58 @@ long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     return hash;
 }
 
+long_hash_list pkcs5_pbkdf2_hmac_sha512(const data_stack& passphrases,
+    const data_stack& salts, size_t iterations)
+{
+    const auto count = passphrases.size();
+
+    if (salts.size() != count)
+        throw std::invalid_argument("passphrase and salt counts differ");
+
+    std::vector<const uint8_t*> passphrase_data, salt_data;
+    std::vector<size_t> passphrase_sizes, salt_sizes;
+    passphrase_data.reserve(count);
+    passphrase_sizes.reserve(count);
+    salt_data.reserve(count);
+    salt_sizes.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        passphrase_data.push_back(passphrases[index].data());
+        passphrase_sizes.push_back(passphrases[index].size());
+        salt_data.push_back(salts[index].data());
+        salt_sizes.push_back(salts[index].size());
+    }
+
+    // The hashes are written as one contiguous buffer of keys.
+    static_assert(sizeof(long_hash) == long_hash_size, "unpadded long_hash");
+    long_hash_list hashes(count);
+
+    if (hashes.empty())
+        return hashes;
+
+    const auto result = pkcs5_pbkdf2_batch(passphrase_data.data(),
+        passphrase_sizes.data(), salt_data.data(), salt_sizes.data(),
+        hashes.front().data(), long_hash_size, count, iterations);
+
+    if (result != 0)
+        throw std::bad_alloc();
+
+    return hashes;
+}
+
+uint64_t hash_salt()
+{
+    static const auto salt = []()
+    {
+        std::random_device device;
+        const uint64_t high = device();
+        return (high << 32) | device();
+    }();
+
+    return salt;
+}
+
 static void handle_script_result(int result)
 {
     if (result == 0)
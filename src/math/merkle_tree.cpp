@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/merkle_tree.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+
+// Static functions.
+//-----------------------------------------------------------------------------
+
+// Hash adjacent pairs of the level into its front half and truncate.
+// Hashes are contiguous so each pair is a 64 byte block, and the digests
+// may overwrite the blocks because the kernels read before they write.
+void merkle_tree::reduce_level(hash_list& level)
+{
+    // If number of hashes is odd, duplicate last hash in the list.
+    if (level.size() % 2 != 0)
+        level.push_back(level.back());
+
+    const auto pairs = level.size() / 2;
+    SHA256Double64(level.front().data(), level.front().data(), pairs);
+    level.resize(pairs);
+}
+
+hash_digest merkle_tree::reduce(hash_list&& leaves)
+{
+    if (leaves.empty())
+        return null_hash;
+
+    while (leaves.size() > 1)
+        reduce_level(leaves);
+
+    // There is now only one item in the list.
+    return leaves.front();
+}
+
+hash_digest merkle_tree::branch_root(const hash_digest& leaf,
+    const hash_list& branch, size_t index)
+{
+    auto hash = leaf;
+
+    for (const auto& sibling: branch)
+    {
+        hash = (index % 2 == 0) ? bitcoin_hash(splice(hash, sibling)) :
+            bitcoin_hash(splice(sibling, hash));
+        index /= 2;
+    }
+
+    return hash;
+}
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+merkle_tree::merkle_tree()
+  : tree_()
+{
+}
+
+merkle_tree::merkle_tree(merkle_tree&& other)
+  : tree_(std::move(other.tree_))
+{
+}
+
+merkle_tree::merkle_tree(const merkle_tree& other)
+  : tree_(other.tree_)
+{
+}
+
+merkle_tree::merkle_tree(hash_list&& leaves)
+  : tree_()
+{
+    if (leaves.empty())
+        return;
+
+    tree_.push_back(std::move(leaves));
+    build();
+}
+
+merkle_tree::merkle_tree(const hash_list& leaves)
+  : merkle_tree(hash_list(leaves))
+{
+}
+
+// Each level is retained as computed, without its odd duplicate, so that
+// level widths match the bip37 tree widths. An odd last pair is hashed from
+// a separate block rather than extending the retained level.
+void merkle_tree::build()
+{
+    while (tree_.back().size() > 1)
+    {
+        const auto& level = tree_.back();
+        const auto pairs = level.size() / 2;
+        const auto odd = level.size() % 2 != 0;
+        hash_list next(pairs + (odd ? 1 : 0));
+
+        if (pairs != 0)
+            SHA256Double64(next.front().data(), level.front().data(), pairs);
+
+        if (odd)
+            next.back() = bitcoin_hash(splice(level.back(), level.back()));
+
+        tree_.push_back(std::move(next));
+    }
+}
+
+// Operators.
+//-----------------------------------------------------------------------------
+
+merkle_tree& merkle_tree::operator=(merkle_tree&& other)
+{
+    tree_ = std::move(other.tree_);
+    return *this;
+}
+
+merkle_tree& merkle_tree::operator=(const merkle_tree& other)
+{
+    tree_ = other.tree_;
+    return *this;
+}
+
+bool merkle_tree::operator==(const merkle_tree& other) const
+{
+    return tree_ == other.tree_;
+}
+
+bool merkle_tree::operator!=(const merkle_tree& other) const
+{
+    return !(*this == other);
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+bool merkle_tree::empty() const
+{
+    return tree_.empty();
+}
+
+size_t merkle_tree::size() const
+{
+    return tree_.empty() ? 0 : tree_.front().size();
+}
+
+size_t merkle_tree::height() const
+{
+    return tree_.size();
+}
+
+const merkle_tree::levels& merkle_tree::tree() const
+{
+    return tree_;
+}
+
+hash_digest merkle_tree::root() const
+{
+    return tree_.empty() ? null_hash : tree_.back().front();
+}
+
+// Proofs.
+//-----------------------------------------------------------------------------
+
+hash_list merkle_tree::branch(size_t index) const
+{
+    hash_list branch;
+
+    if (index >= size())
+        return branch;
+
+    branch.reserve(height() - 1);
+
+    for (size_t depth = 0; depth + 1 < height(); ++depth)
+    {
+        const auto& level = tree_[depth];
+        const auto sibling = index ^ 1;
+
+        // The sibling of an odd last hash is its own duplicate.
+        branch.push_back(sibling < level.size() ? level[sibling] :
+            level[index]);
+        index /= 2;
+    }
+
+    return branch;
+}
+
+bool merkle_tree::partial(hash_list& out_hashes, data_chunk& out_flags,
+    const std::vector<bool>& matches) const
+{
+    if (empty() || matches.size() != size())
+        return false;
+
+    std::vector<bool> bits;
+    out_hashes.clear();
+    traverse(out_hashes, bits, matches, height() - 1, 0);
+
+    // Flag bits are packed into bytes from the least significant bit.
+    out_flags.assign((bits.size() + 7) / 8, 0x00);
+
+    for (size_t bit = 0; bit < bits.size(); ++bit)
+        if (bits[bit])
+            out_flags[bit / 8] |= (1 << (bit % 8));
+
+    return true;
+}
+
+// Depth first traversal, descending only into subtrees containing a match.
+void merkle_tree::traverse(hash_list& out_hashes, std::vector<bool>& out_bits,
+    const std::vector<bool>& matches, size_t depth, size_t position) const
+{
+    const auto begin = matches.begin() + (position << depth);
+    const auto end = matches.begin() +
+        std::min((position + 1) << depth, matches.size());
+    const auto parent_of_match = std::find(begin, end, true) != end;
+    out_bits.push_back(parent_of_match);
+
+    if (depth == 0 || !parent_of_match)
+    {
+        out_hashes.push_back(tree_[depth][position]);
+        return;
+    }
+
+    const auto left = position * 2;
+    traverse(out_hashes, out_bits, matches, depth - 1, left);
+
+    if (left + 1 < tree_[depth - 1].size())
+        traverse(out_hashes, out_bits, matches, depth - 1, left + 1);
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR uint32_t murmur3_c1 = 0xcc9e2d51;
+static BC_CONSTEXPR uint32_t murmur3_c2 = 0x1b873593;
+
+static inline uint32_t rotate_left(uint32_t value, uint8_t shift)
+{
+    return (value << shift) | (value >> (32 - shift));
+}
+
+static inline uint32_t scramble(uint32_t word)
+{
+    return rotate_left(word * murmur3_c1, 15) * murmur3_c2;
+}
+
+uint32_t murmur3(data_slice data, uint32_t seed)
+{
+    const auto size = data.size();
+    const auto words = size / sizeof(uint32_t);
+    auto it = data.begin();
+    auto hash = seed;
+
+    for (size_t word = 0; word < words; ++word, it += sizeof(uint32_t))
+    {
+        hash ^= scramble(from_little_endian_unsafe<uint32_t>(it));
+        hash = rotate_left(hash, 13) * 5 + 0xe6546b64;
+    }
+
+    // The remaining (up to three) bytes are mixed as a little-endian word.
+    uint32_t tail = 0;
+
+    for (size_t byte = 0; it != data.end(); ++it, ++byte)
+        tail |= static_cast<uint32_t>(*it) << (8 * byte);
+
+    if ((size % sizeof(uint32_t)) != 0)
+        hash ^= scramble(tail);
+
+    // Finalization avalanches the bits of the hash.
+    hash ^= static_cast<uint32_t>(size);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+} // namespace libbitcoin
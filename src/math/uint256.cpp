@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/uint256.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR uint32_t decimal_chunk = 1000000000;
+static BC_CONSTEXPR size_t decimal_chunk_digits = 9;
+
+static size_t word_bit_length(uint64_t word)
+{
+    size_t length = 0;
+
+    for (; word != 0; word >>= 1)
+        ++length;
+
+    return length;
+}
+
+uint256_t::hash_type uint256_t::hash() const
+{
+    hash_type out;
+
+    for (size_t index = 0; index < out.size(); ++index)
+    {
+        const auto word = words_[index / 8];
+        out[index] = static_cast<uint8_t>(word >> (8 * (index % 8)));
+    }
+
+    return out;
+}
+
+size_t uint256_t::bit_length() const
+{
+    for (auto index = words; index > 0; --index)
+        if (words_[index - 1] != 0)
+            return 64 * (index - 1) + word_bit_length(words_[index - 1]);
+
+    return 0;
+}
+
+size_t uint256_t::byte_length() const
+{
+    return (bit_length() + 7) / 8;
+}
+
+uint32_t uint256_t::divide(uint32_t divisor)
+{
+    static BC_CONSTEXPR uint64_t mask = 0xffffffff;
+    uint64_t remainder = 0;
+
+    // Divide by 32 bit halves, the remainder is always less than the divisor.
+    for (auto index = words; index > 0; --index)
+    {
+        const auto word = words_[index - 1];
+        const auto high = (remainder << 32) | (word >> 32);
+        remainder = high % divisor;
+        const auto low = (remainder << 32) | (word & mask);
+        remainder = low % divisor;
+        words_[index - 1] = ((high / divisor) << 32) | (low / divisor);
+    }
+
+    return static_cast<uint32_t>(remainder);
+}
+
+uint256_t& uint256_t::operator/=(uint32_t value)
+{
+    if (value == 0)
+        throw std::overflow_error("uint256_t division by zero");
+
+    divide(value);
+    return *this;
+}
+
+uint256_t& uint256_t::operator/=(const uint256_t& value)
+{
+    const auto divisor_bits = value.bit_length();
+
+    if (divisor_bits == 0)
+        throw std::overflow_error("uint256_t division by zero");
+
+    if (divisor_bits <= 32)
+        return *this /= static_cast<uint32_t>(value.words_[0]);
+
+    const auto dividend_bits = bit_length();
+
+    if (dividend_bits < divisor_bits)
+        return *this = 0;
+
+    // Binary long division from the highest aligned multiple of the divisor.
+    auto shift = dividend_bits - divisor_bits;
+    auto remainder = *this;
+    auto divisor = value << static_cast<uint32_t>(shift);
+    uint256_t quotient;
+
+    for (++shift; shift > 0; --shift)
+    {
+        quotient <<= 1;
+
+        if (remainder >= divisor)
+        {
+            remainder -= divisor;
+            quotient.words_[0] |= 1;
+        }
+
+        divisor >>= 1;
+    }
+
+    return *this = quotient;
+}
+
+std::ostream& operator<<(std::ostream& output, const uint256_t& value)
+{
+    auto quotient = value;
+    std::vector<uint32_t> chunks;
+
+    do
+    {
+        chunks.push_back(quotient.divide(decimal_chunk));
+    } while (quotient != 0);
+
+    std::ostringstream text;
+    text << chunks.back();
+
+    for (auto chunk = chunks.rbegin() + 1; chunk != chunks.rend(); ++chunk)
+        text << std::setw(decimal_chunk_digits) << std::setfill('0') << *chunk;
+
+    output << text.str();
+    return output;
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/machine/script_pattern.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/merkle_tree.hpp>
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::chain;
+using namespace bc::machine;
+
+// The seed of each hash function is spaced by this (bip37) constant.
+static BC_CONSTEXPR uint32_t seed_multiplier = 0xfba4c795;
+
+const size_t bloom_filter::max_filter_size = 36000;
+const uint32_t bloom_filter::max_hash_functions = 50;
+
+bloom_filter::bloom_filter()
+  : bloom_filter({}, 0, 0, static_cast<uint8_t>(update::none))
+{
+}
+
+bloom_filter::bloom_filter(const filter_load& message)
+  : bloom_filter(message.filter(), message.hash_functions(), message.tweak(),
+      message.flags())
+{
+}
+
+bloom_filter::bloom_filter(const data_chunk& filter, uint32_t hash_functions,
+    uint32_t tweak, uint8_t flags)
+  : filter_(filter),
+    hash_functions_(hash_functions),
+    tweak_(tweak),
+    flags_(flags),
+    bits_(filter.size() * byte_bits),
+    empty_(true),
+    full_(false)
+{
+    set_state();
+}
+
+bool bloom_filter::is_valid() const
+{
+    return filter_.size() <= max_filter_size &&
+        hash_functions_ <= max_hash_functions;
+}
+
+const data_chunk& bloom_filter::filter() const
+{
+    return filter_;
+}
+
+// A filter of all zeros matches nothing and of all ones matches everything,
+// so both are short-circuited (this is only determined on load). A zero length
+// filter is full, as it is in the satoshi client (bip37 does not specify).
+void bloom_filter::set_state()
+{
+    const auto is_zero = [](uint8_t byte) { return byte == 0x00; };
+    const auto is_ones = [](uint8_t byte) { return byte == 0xff; };
+    empty_ = std::all_of(filter_.begin(), filter_.end(), is_zero);
+    full_ = std::all_of(filter_.begin(), filter_.end(), is_ones);
+}
+
+// Elements.
+//-----------------------------------------------------------------------------
+
+size_t bloom_filter::bit_index(data_slice element, uint32_t function) const
+{
+    const auto seed = function * seed_multiplier + tweak_;
+    return murmur3(element, seed) % bits_;
+}
+
+void bloom_filter::insert(data_slice element)
+{
+    if (full_)
+        return;
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto bit = bit_index(element, function);
+        filter_[bit / byte_bits] |= (1 << (bit % byte_bits));
+    }
+
+    empty_ = false;
+}
+
+void bloom_filter::insert(const point& outpoint)
+{
+    insert(to_bytes(outpoint));
+}
+
+bool bloom_filter::contains(data_slice element) const
+{
+    if (full_)
+        return true;
+
+    if (empty_)
+        return false;
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto bit = bit_index(element, function);
+
+        if ((filter_[bit / byte_bits] & (1 << (bit % byte_bits))) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool bloom_filter::contains(const point& outpoint) const
+{
+    return contains(to_bytes(outpoint));
+}
+
+// The outpoint is hashed in its wire serialization, without allocation.
+bloom_filter::point_bytes bloom_filter::to_bytes(const point& outpoint)
+{
+    point_bytes bytes;
+    const auto& hash = outpoint.hash();
+    const auto index = to_little_endian(outpoint.index());
+    const auto next = std::copy(hash.begin(), hash.end(), bytes.begin());
+    std::copy(index.begin(), index.end(), next);
+    return bytes;
+}
+
+// Matching.
+//-----------------------------------------------------------------------------
+
+bool bloom_filter::match(const transaction& tx)
+{
+    if (full_)
+        return true;
+
+    if (empty_)
+        return false;
+
+    // Outputs are always matched, as they may update the filter.
+    auto matched = contains(tx.hash());
+    matched |= match_outputs(tx);
+    return matched || match_inputs(tx);
+}
+
+bool bloom_filter::match_outputs(const transaction& tx)
+{
+    const auto mask = static_cast<uint8_t>(update::mask);
+    const auto mode = static_cast<update>(flags_ & mask);
+    const auto& outputs = tx.outputs();
+    auto matched = false;
+
+    for (uint32_t index = 0; index < outputs.size(); ++index)
+    {
+        const auto& script = outputs[index].script();
+
+        for (const auto& op: script.operations())
+        {
+            const auto& data = op.data();
+
+            if (data.empty() || !contains(data))
+                continue;
+
+            matched = true;
+
+            if (mode == update::all)
+            {
+                insert(point{ tx.hash(), index });
+            }
+            else if (mode == update::pay_public_key_only)
+            {
+                const auto pattern = script.output_pattern();
+
+                if (pattern == script_pattern::pay_public_key ||
+                    pattern == script_pattern::pay_multisig)
+                    insert(point{ tx.hash(), index });
+            }
+
+            break;
+        }
+    }
+
+    return matched;
+}
+
+bool bloom_filter::match_inputs(const transaction& tx) const
+{
+    for (const auto& input: tx.inputs())
+    {
+        if (contains(input.previous_output()))
+            return true;
+
+        for (const auto& op: input.script().operations())
+        {
+            const auto& data = op.data();
+
+            if (!data.empty() && contains(data))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+merkle_block bloom_filter::to_merkle_block(const block& block)
+{
+    std::vector<bool> matches;
+    return to_merkle_block(block, matches);
+}
+
+merkle_block bloom_filter::to_merkle_block(const block& block,
+    std::vector<bool>& out_matches)
+{
+    const auto& transactions = block.transactions();
+    hash_list hashes;
+    hashes.reserve(transactions.size());
+    out_matches.clear();
+    out_matches.reserve(transactions.size());
+
+    for (const auto& tx: transactions)
+    {
+        hashes.push_back(tx.hash());
+        out_matches.push_back(match(tx));
+    }
+
+    return { block.header(), merkle_tree(std::move(hashes)), out_matches };
+}
+
+} // namespace message
+} // namespace libbitcoin
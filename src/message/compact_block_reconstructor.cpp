@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/compact_block_reconstructor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/utility/container_sink.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+static BC_CONSTEXPR uint64_t short_id_mask = 0x0000ffffffffffff;
+
+compact_block_reconstructor::compact_block_reconstructor(
+    const compact_block& block, bool witness)
+  : header_(block.header()),
+    key_(to_key(block)),
+    witness_(witness),
+    remaining_(0),
+    valid_(false)
+{
+    valid_ = initialize(block);
+}
+
+// Initialization.
+//-----------------------------------------------------------------------------
+
+// The key is the first two little-endian words of sha256(header || nonce).
+siphash_key compact_block_reconstructor::to_key(const compact_block& block)
+{
+    data_chunk data;
+    data.reserve(block.header().serialized_size() + sizeof(uint64_t));
+    data_sink ostream(data);
+    ostream_writer sink(ostream);
+    block.header().to_data(sink);
+    sink.write_8_bytes_little_endian(block.nonce());
+    ostream.flush();
+
+    const auto hash = sha256_hash(data);
+    half_hash half;
+    std::copy_n(hash.begin(), half.size(), half.begin());
+    return to_siphash_key(half);
+}
+
+uint64_t compact_block_reconstructor::to_short_id(
+    const compact_block::short_id& id)
+{
+    uint64_t value = 0;
+
+    for (size_t byte = 0; byte < id.size(); ++byte)
+        value |= static_cast<uint64_t>(id[byte]) << (8 * byte);
+
+    return value;
+}
+
+bool compact_block_reconstructor::initialize(const compact_block& block)
+{
+    const auto& prefilled = block.transactions();
+    const auto& short_ids = block.short_ids();
+    const auto count = prefilled.size() + short_ids.size();
+
+    if (count == 0)
+        return false;
+
+    transactions_.resize(count);
+    slots_.resize(count, slot::empty);
+
+    // Prefilled indexes are differentially encoded, each is the number of
+    // positions skipped since the previous prefilled transaction.
+    uint64_t offset = 0;
+
+    for (const auto& transaction: prefilled)
+    {
+        if (transaction.index() >= count - offset)
+            return false;
+
+        offset += transaction.index();
+        transactions_[offset] = transaction.transaction();
+        slots_[offset++] = slot::filled;
+    }
+
+    // Short ids fill the remaining positions in order.
+    index_.reserve(short_ids.size());
+    auto id = short_ids.begin();
+
+    for (size_t position = 0; position < count; ++position)
+    {
+        if (slots_[position] != slot::empty)
+            continue;
+
+        // Colliding short ids cannot be resolved from candidates.
+        if (!index_.emplace(to_short_id(*id++), position).second)
+            return false;
+
+        ++remaining_;
+    }
+
+    return true;
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+bool compact_block_reconstructor::is_valid() const
+{
+    return valid_;
+}
+
+bool compact_block_reconstructor::is_complete() const
+{
+    return valid_ && remaining_ == 0;
+}
+
+uint64_t compact_block_reconstructor::short_id(const hash_digest& hash) const
+{
+    return siphash(key_, hash) & short_id_mask;
+}
+
+// Reconstruction.
+//-----------------------------------------------------------------------------
+
+bool compact_block_reconstructor::match(const chain::transaction& candidate)
+{
+    if (!valid_)
+        return false;
+
+    const auto hash = candidate.hash(witness_);
+    const auto it = index_.find(short_id(hash));
+
+    if (it == index_.end())
+        return false;
+
+    const auto position = it->second;
+
+    switch (slots_[position])
+    {
+        case slot::empty:
+        {
+            transactions_[position] = candidate;
+            slots_[position] = slot::filled;
+            --remaining_;
+            return true;
+        }
+
+        // A second distinct candidate makes the position ambiguous.
+        case slot::filled:
+        {
+            if (transactions_[position].hash(witness_) != hash)
+            {
+                transactions_[position] = chain::transaction{};
+                slots_[position] = slot::conflicted;
+                ++remaining_;
+            }
+
+            return false;
+        }
+
+        case slot::conflicted:
+        default:
+            return false;
+    }
+}
+
+size_t compact_block_reconstructor::match(
+    const chain::transaction::list& candidates)
+{
+    size_t placed = 0;
+
+    for (const auto& candidate: candidates)
+    {
+        if (!valid_ || remaining_ == 0)
+            break;
+
+        if (match(candidate))
+            ++placed;
+    }
+
+    return placed;
+}
+
+bool compact_block_reconstructor::fill(const block_transactions& response)
+{
+    const auto& transactions = response.transactions();
+
+    if (!valid_ || response.block_hash() != header_.hash() ||
+        transactions.size() != remaining_)
+        return false;
+
+    auto transaction = transactions.begin();
+
+    for (size_t position = 0; position < slots_.size(); ++position)
+    {
+        if (slots_[position] == slot::filled)
+            continue;
+
+        transactions_[position] = *transaction++;
+        slots_[position] = slot::filled;
+    }
+
+    remaining_ = 0;
+    return true;
+}
+
+std::vector<uint64_t> compact_block_reconstructor::missing() const
+{
+    std::vector<uint64_t> indexes;
+    indexes.reserve(remaining_);
+
+    for (size_t position = 0; position < slots_.size(); ++position)
+        if (slots_[position] != slot::filled)
+            indexes.push_back(position);
+
+    return indexes;
+}
+
+get_block_transactions compact_block_reconstructor::to_request() const
+{
+    auto indexes = missing();
+    uint64_t next = 0;
+
+    // Encode each index as the number of positions skipped since the last.
+    for (auto& index: indexes)
+    {
+        const auto position = index;
+        index -= next;
+        next = position + 1;
+    }
+
+    return { header_.hash(), std::move(indexes) };
+}
+
+chain::block compact_block_reconstructor::to_block() const
+{
+    if (!is_complete())
+        return {};
+
+    return { header_, transactions_ };
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/frame.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <bitcoin/bitcoin/math/checksum.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+frame::shared_payload::shared_payload(data_chunk&& payload)
+  : data(std::move(payload)),
+    checksum(bitcoin_checksum(data))
+{
+}
+
+static frame::heading_data to_heading(uint32_t magic,
+    const std::string& command, const frame::shared_payload& payload)
+{
+    BITCOIN_ASSERT(heading::satoshi_fixed_size() ==
+        std::tuple_size<frame::heading_data>::value);
+
+    frame::heading_data data;
+    auto sink = make_unsafe_serializer(data.begin());
+    const auto payload_size = safe_unsigned<uint32_t>(payload.data.size());
+    heading(magic, command, payload_size, payload.checksum).to_data(sink);
+    return data;
+}
+
+frame::frame(uint32_t magic, const std::string& command, payload_ptr payload)
+  : payload_(payload),
+    heading_(to_heading(magic, command, *payload))
+{
+}
+
+const frame::heading_data& frame::heading() const
+{
+    return heading_;
+}
+
+const data_chunk& frame::payload() const
+{
+    return payload_->data;
+}
+
+size_t frame::size() const
+{
+    return heading_.size() + payload_->data.size();
+}
+
+frame::buffers frame::to_buffers() const
+{
+    return
+    {
+        {
+            asio::const_buffer(heading_.data(), heading_.size()),
+            asio::const_buffer(payload_->data.data(),
+                payload_->data.size())
+        }
+    };
+}
+
+data_chunk frame::to_data() const
+{
+    data_chunk data(size());
+    const auto next = std::copy(heading_.begin(), heading_.end(),
+        data.begin());
+    std::copy(payload_->data.begin(), payload_->data.end(), next);
+    return data;
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -19,19 +19,29 @@
 #include <bitcoin/bitcoin/message/headers.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
+#include <iterator>
+#include <memory>
 #include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/chain_state.hpp>
+#include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
+#include <bitcoin/bitcoin/settings.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -105,8 +115,8 @@ void headers::reset()
 
 bool headers::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool headers::from_data(uint32_t version, std::istream& stream)
@@ -210,6 +220,122 @@ void headers::to_inventory(inventory_vector::list& out,
     std::for_each(elements_.begin(), elements_.end(), map);
 }
 
+// Validation.
+//-----------------------------------------------------------------------------
+
+code headers::check(size_t& failed, uint32_t timestamp_limit_seconds,
+    uint32_t proof_of_work_limit, threadpool& pool, bool scrypt) const
+{
+    const auto count = elements_.size();
+    const auto buckets = std::min(pool.size(), count);
+    failed = count;
+
+    if (buckets < 2)
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            const auto ec = elements_[index].check(timestamp_limit_seconds,
+                proof_of_work_limit, scrypt);
+
+            if (ec)
+            {
+                failed = index;
+                return ec;
+            }
+        }
+
+        return error::success;
+    }
+
+    // Each bucket records its first failure, which is its lowest index.
+    std::vector<code> codes(buckets, error::success);
+    std::vector<size_t> failures(buckets, count);
+
+    // Headers are claimed in order, stopping at the lowest known failure.
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> lowest(count);
+
+    const auto verify = [&](size_t bucket)
+    {
+        for (auto index = next++; index < lowest; index = next++)
+        {
+            const auto ec = elements_[index].check(timestamp_limit_seconds,
+                proof_of_work_limit, scrypt);
+
+            if (ec)
+            {
+                codes[bucket] = ec;
+                failures[bucket] = index;
+                auto current = lowest.load();
+
+                while (index < current &&
+                    !lowest.compare_exchange_weak(current, index));
+
+                break;
+            }
+        }
+    };
+
+    dispatcher dispatch(pool, "headers");
+    dispatch.partition(buckets, verify);
+
+    const auto first = std::min_element(failures.begin(), failures.end());
+    failed = *first;
+    return codes[std::distance(failures.begin(), first)];
+}
+
+code headers::accept(size_t& failed, const chain::chain_state& parent,
+    const bc::settings& settings) const
+{
+    return accept(failed, parent, settings, elements_.size());
+}
+
+// Accept the first count headers, failed is count if all are accepted.
+code headers::accept(size_t& failed, const chain::chain_state& parent,
+    const bc::settings& settings, size_t count) const
+{
+    const auto* state = &parent;
+    failed = count;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto& header = elements_[index];
+
+        if (header.previous_block_hash() != state->hash())
+        {
+            failed = index;
+            return error::orphan_block;
+        }
+
+        const auto next = std::make_shared<chain::chain_state>(*state,
+            header, settings);
+        const auto ec = header.accept(*next);
+
+        if (ec)
+        {
+            failed = index;
+            return ec;
+        }
+
+        header.metadata.state = next;
+        state = next.get();
+    }
+
+    return error::success;
+}
+
+code headers::validate(size_t& failed, const chain::chain_state& parent,
+    const bc::settings& settings, threadpool& pool, bool scrypt) const
+{
+    size_t checked;
+    const auto ec = check(checked, settings.timestamp_limit_seconds,
+        settings.proof_of_work_limit, pool, scrypt);
+
+    // Only headers preceding a check failure are accepted.
+    const auto accepted = accept(failed, parent, settings, checked);
+    return accepted ? accepted : ec;
+}
+
 size_t headers::serialized_size(uint32_t version) const
 {
     return variable_uint_size(elements_.size()) +
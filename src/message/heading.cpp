@@ -22,7 +22,7 @@
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -131,8 +131,8 @@ void heading::reset()
 
 bool heading::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source);
 }
 
 bool heading::from_data(std::istream& stream)
@@ -21,11 +21,12 @@
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/math/merkle_tree.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -86,6 +87,16 @@ merkle_block::merkle_block(const chain::block& block)
 {
 }
 
+// The tree levels are retained, so the partial tree is not rehashed. An
+// invalid match set produces a reset (invalid) instance.
+merkle_block::merkle_block(const chain::header& header,
+    const merkle_tree& tree, const std::vector<bool>& matches)
+  : header_(header), total_transactions_(tree.size()), hashes_(), flags_()
+{
+    if (!tree.partial(hashes_, flags_, matches))
+        reset();
+}
+
 merkle_block::merkle_block(const merkle_block& other)
   : merkle_block(other.header_, other.total_transactions_, other.hashes_,
       other.flags_)
@@ -115,8 +126,8 @@ void merkle_block::reset()
 
 bool merkle_block::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool merkle_block::from_data(uint32_t version, std::istream& stream)
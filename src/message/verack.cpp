@@ -20,7 +20,7 @@
 
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -67,8 +67,8 @@ void verack::reset()
 
 bool verack::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool verack::from_data(uint32_t version, std::istream& stream)
@@ -99,6 +99,10 @@ void verack::to_data(uint32_t, std::ostream&) const
 {
 }
 
+void verack::to_data(uint32_t, writer&) const
+{
+}
+
 size_t verack::serialized_size(uint32_t version) const
 {
     return verack::satoshi_fixed_size(version);
@@ -18,7 +18,11 @@
  */
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/work.hpp>
@@ -30,6 +34,69 @@ dispatcher::dispatcher(threadpool& pool, const std::string& name)
 {
 }
 
+// Partition
+// ----------------------------------------------------------------------------
+
+// Posted jobs may run after partition returns, so they share this state by
+// reference count. A job that claims no bucket does not touch the handler.
+struct partition_state
+{
+    partition_state(size_t buckets,
+        const dispatcher::partition_handler& handler)
+      : buckets(buckets), next(0), completed(0), handler(handler)
+    {
+    }
+
+    const size_t buckets;
+    std::atomic<size_t> next;
+
+    // These are protected by mutex.
+    size_t completed;
+    std::mutex mutex;
+    std::condition_variable done;
+
+    // This is valid until all buckets have completed.
+    const dispatcher::partition_handler& handler;
+};
+
+static void run_partition(std::shared_ptr<partition_state> state)
+{
+    for (auto bucket = state->next++; bucket < state->buckets;
+        bucket = state->next++)
+    {
+        state->handler(bucket);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        std::lock_guard<std::mutex> lock(state->mutex);
+
+        if (++state->completed == state->buckets)
+            state->done.notify_all();
+        ///////////////////////////////////////////////////////////////////////
+    }
+}
+
+void dispatcher::partition(size_t buckets, const partition_handler& handler)
+{
+    if (buckets == 0)
+        return;
+
+    const auto state = std::make_shared<partition_state>(buckets, handler);
+
+    // The calling thread is a worker, so one fewer job is posted.
+    for (size_t job = 1; job < buckets; ++job)
+        concurrent(&run_partition, state);
+
+    run_partition(state);
+
+    // Remaining buckets were claimed by pool threads that are running them.
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]()
+    {
+        return state->completed == state->buckets;
+    });
+}
+
 ////size_t dispatcher::ordered_backlog()
 ////{
 ////    return heap_->ordered_backlog();
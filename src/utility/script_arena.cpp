@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/script_arena.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+
+namespace libbitcoin {
+
+const size_t script_arena::default_chunk_size = 64 * 1024;
+
+script_arena::script_arena(size_t chunk_size)
+  : chunk_size_(std::max(chunk_size, size_t(1))),
+    references_(0),
+    position_(nullptr),
+    end_(nullptr),
+    allocated_(0),
+    reserved_(0)
+{
+}
+
+void* script_arena::allocate(size_t size, size_t alignment)
+{
+    BITCOIN_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    const auto address = reinterpret_cast<uintptr_t>(position_);
+    auto padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+    if (position_ == nullptr ||
+        static_cast<size_t>(end_ - position_) < padding + size)
+    {
+        // An oversized request gets its own chunk, the remainder is unused.
+        const auto reserve = std::max(chunk_size_, size + alignment);
+        chunks_.emplace_back(new uint8_t[reserve]);
+        position_ = chunks_.back().get();
+        end_ = position_ + reserve;
+        reserved_ += reserve;
+
+        const auto start = reinterpret_cast<uintptr_t>(position_);
+        padding = (alignment - (start & (alignment - 1))) & (alignment - 1);
+    }
+
+    const auto result = position_ + padding;
+    position_ = result + size;
+    allocated_ += size;
+    return result;
+}
+
+size_t script_arena::allocated() const
+{
+    return allocated_;
+}
+
+size_t script_arena::reserved() const
+{
+    return reserved_;
+}
+
+void intrusive_ptr_add_ref(script_arena* memory)
+{
+    memory->references_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void intrusive_ptr_release(script_arena* memory)
+{
+    if (memory->references_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete memory;
+}
+
+} // namespace libbitcoin
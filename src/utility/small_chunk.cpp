@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/small_chunk.hpp>
+
+#include <cstddef>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+const size_t small_chunk::inline_capacity;
+
+data_stack to_data_stack(const small_stack& stack)
+{
+    data_stack out;
+    out.reserve(stack.size());
+
+    for (const auto& element: stack)
+        out.emplace_back(element.begin(), element.end());
+
+    return out;
+}
+
+small_stack to_small_stack(const data_stack& stack)
+{
+    small_stack out;
+    out.reserve(stack.size());
+
+    for (const auto& element: stack)
+        out.emplace_back(element);
+
+    return out;
+}
+
+} // namespace libbitcoin
@@ -18,6 +18,7 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -272,6 +273,36 @@ hd_public hd_private::derive_public(uint32_t index) const
     return derive_private(index).to_public();
 }
 
+bool hd_private::derive_private_range(secret_list& out, uint32_t first,
+    size_t count) const
+{
+    // Hardened data is 0x00 || ser256(kpar) || ser32(i).
+    constexpr uint8_t private_key_prefix = 0x00;
+    const auto hardened = first >= hd_first_hardened_key;
+    const auto limit = hardened ? max_uint32 - first + 1 :
+        hd_first_hardened_key - first;
+
+    if (count > limit || lineage_.depth == max_uint8)
+        return false;
+
+    const auto prefix = hardened ?
+        splice(to_array(private_key_prefix), secret_) : point_;
+
+    derive_tweaks(out, prefix, chain_, first, count);
+
+    // The child keys ki are (parse256(IL) + kpar) mod n.
+    for (auto& tweak: out)
+    {
+        auto child = secret_;
+        if (!ec_add(child, tweak))
+            return false;
+
+        tweak = child;
+    }
+
+    return true;
+}
+
 // Operators.
 // ----------------------------------------------------------------------------
 
@@ -18,12 +18,16 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_public.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
 #include <boost/program_options.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/formats/base_58.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
@@ -31,10 +35,14 @@
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include "../math/external/hmac_sha512.h"
 
 namespace libbitcoin {
 namespace wallet {
@@ -240,6 +248,72 @@ hd_public hd_public::derive_public(uint32_t index) const
     return hd_public(child, intermediate.right, lineage);
 }
 
+bool hd_public::derive_public_range(point_list& out, uint32_t first,
+    size_t count) const
+{
+    if (first >= hd_first_hardened_key ||
+        count > hd_first_hardened_key - first ||
+        lineage_.depth == max_uint8)
+        return false;
+
+    secret_list tweaks;
+    derive_tweaks(tweaks, point_, chain_, first, count);
+
+    // The child keys Ki are point(parse256(IL)) + Kpar.
+    return ec_add(out, point_, tweaks);
+}
+
+// Partitions share only the parent, each derives its own tweaks and points.
+bool hd_public::derive_public_range(point_list& out, uint32_t first,
+    size_t count, threadpool& pool) const
+{
+    const auto buckets = std::min(pool.size(), count);
+
+    if (buckets < 2)
+        return derive_public_range(out, first, count);
+
+    if (first >= hd_first_hardened_key ||
+        count > hd_first_hardened_key - first)
+        return false;
+
+    out.resize(count);
+    std::atomic<bool> all(true);
+
+    const auto derive = [&](size_t bucket)
+    {
+        const auto begin = bucket * count / buckets;
+        const auto end = (bucket + 1) * count / buckets;
+        const auto start = static_cast<uint32_t>(first + begin);
+        point_list points;
+
+        if (derive_public_range(points, start, end - begin))
+            std::copy(points.begin(), points.end(), out.begin() + begin);
+        else
+            all = false;
+    };
+
+    dispatcher dispatch(pool, "derive");
+    dispatch.partition(buckets, derive);
+    return all;
+}
+
+bool hd_public::derive_public_range(payment_address::list& out,
+    uint32_t first, size_t count, uint8_t version) const
+{
+    point_list points;
+    out.clear();
+
+    if (!derive_public_range(points, first, count))
+        return false;
+
+    out.reserve(count);
+
+    for (const auto& point: points)
+        out.emplace_back(ec_public(point), version);
+
+    return true;
+}
+
 // Helpers.
 // ----------------------------------------------------------------------------
 
@@ -249,6 +323,27 @@ uint32_t hd_public::fingerprint() const
     return from_big_endian_unsafe<uint32_t>(message_digest.begin());
 }
 
+// The hmac context is keyed and absorbs the prefix once, so that each child
+// only hashes its index and finalizes a copy of the context.
+void hd_public::derive_tweaks(secret_list& out, data_slice prefix,
+    const hd_chain_code& chain_code, uint32_t first, size_t count)
+{
+    long_hash intermediate;
+    HMACSHA512CTX parent;
+    HMACSHA512Init(&parent, chain_code.data(), chain_code.size());
+    HMACSHA512Update(&parent, prefix.data(), prefix.size());
+    out.resize(count);
+
+    for (size_t offset = 0; offset < count; ++offset)
+    {
+        auto context = parent;
+        const auto index = to_big_endian(static_cast<uint32_t>(first + offset));
+        HMACSHA512Update(&context, index.data(), index.size());
+        HMACSHA512Final(&context, intermediate.data());
+        std::copy_n(intermediate.begin(), ec_secret_size, out[offset].begin());
+    }
+}
+
 // Operators.
 // ----------------------------------------------------------------------------
 
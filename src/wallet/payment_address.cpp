@@ -269,7 +269,7 @@ payment_address::list payment_address::extract_input(
         {
             return
             {
-                { ec_public{ script[1].data() }, p2kh_version }////,
+                { ec_public{ script[1].data().to_chunk() }, p2kh_version }////,
                 ////{ bitcoin_short_hash(script.back().data()), p2sh_version }
             };
         }
@@ -329,7 +329,7 @@ payment_address::list payment_address::extract_output(
             return
             {
                 // pay_public_key is not p2kh but we conflate for tracking.
-                { ec_public{ script[0].data() }, p2kh_version }
+                { ec_public{ script[0].data().to_chunk() }, p2kh_version }
             };
         }
 
@@ -291,6 +291,16 @@ BOOST_AUTO_TEST_CASE(block__genesis__regtest__valid_structure)
     BOOST_REQUIRE(genesis.header().merkle() == genesis.generate_merkle_root());
 }
 
+BOOST_AUTO_TEST_CASE(block__generate_merkle_tree__three_transactions__matches_root)
+{
+    chain::block instance;
+    instance.set_transactions({ { 1, 0, {}, {} }, { 2, 0, {}, {} }, { 3, 0, {}, {} } });
+    const auto tree = instance.generate_merkle_tree();
+    BOOST_REQUIRE_EQUAL(tree.size(), 3u);
+    BOOST_REQUIRE(tree.tree().front() == instance.to_hashes());
+    BOOST_REQUIRE(tree.root() == instance.generate_merkle_root());
+}
+
 
 BOOST_AUTO_TEST_CASE(block__factory_1__genesis_mainnet__success)
 {
@@ -355,6 +365,42 @@ BOOST_AUTO_TEST_CASE(block__factory_3__genesis_mainnet__success)
     BOOST_REQUIRE(genesis.header().merkle() == block.generate_merkle_root());
 }
 
+BOOST_AUTO_TEST_CASE(block__factory_4__genesis_mainnet_arena__success)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    const auto raw_block = genesis.to_data();
+    const script_arena::ptr memory(new script_arena);
+
+    // Reload genesis block with scripts allocated from the arena.
+    const auto block = chain::block::factory(raw_block, memory);
+
+    BOOST_REQUIRE(block.is_valid());
+    BOOST_REQUIRE(block == genesis);
+    BOOST_REQUIRE(block.to_data() == raw_block);
+    BOOST_REQUIRE(genesis.header().merkle() == block.generate_merkle_root());
+    BOOST_REQUIRE_GT(memory->allocated(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(block__factory_4__arena_block_destroyed__copy_retains_scripts)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    const auto raw_block = genesis.to_data();
+    script_arena::ptr memory(new script_arena);
+
+    auto block = std::make_shared<chain::block>(
+        chain::block::factory(raw_block, memory));
+    BOOST_REQUIRE(block->is_valid());
+
+    // A copy of the block holds its scripts on the heap.
+    const auto allocated = memory->allocated();
+    const chain::block copy(*block);
+    BOOST_REQUIRE_EQUAL(memory->allocated(), allocated);
+
+    memory.reset();
+    block.reset();
+    BOOST_REQUIRE(copy == genesis);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(block_generate_merkle_root_tests)
@@ -662,6 +708,15 @@ BOOST_AUTO_TEST_CASE(validate_block__is_distinct_tx_set__partialy_distinct_not_a
     BOOST_REQUIRE(!value.is_distinct_transaction_set());
 }
 
+BOOST_AUTO_TEST_CASE(validate_block__is_distinct_tx_set__not_adjacent__sets_repeated_position)
+{
+    chain::block value;
+    value.set_transactions({ { 1, 0, {}, {} }, { 2, 0, {}, {} }, { 1, 0, {}, {} } });
+    size_t transaction = 0;
+    BOOST_REQUIRE(!value.is_distinct_transaction_set(transaction));
+    BOOST_REQUIRE_EQUAL(transaction, 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(block_is_forward_reference_tests)
@@ -784,6 +839,250 @@ BOOST_AUTO_TEST_CASE(block__is_internal_double_spend__nonunique_prevouts__true)
     BOOST_REQUIRE_EQUAL(instance.is_internal_double_spend(), true);
 }
 
+BOOST_AUTO_TEST_CASE(block__is_internal_double_spend__nonunique_prevouts__sets_repeated_position)
+{
+    chain::block instance;
+    chain::transaction::list tx_list;
+    chain::transaction coinbase;
+    tx_list.emplace_back(coinbase);
+    chain::transaction tx1;
+    tx1.inputs().emplace_back(chain::output_point{ hash_tx1, 42 }, chain::script{}, 0);
+    tx1.inputs().emplace_back(chain::output_point{ hash_tx2, 27 }, chain::script{}, 0);
+    tx_list.emplace_back(tx1);
+    chain::transaction tx2;
+    tx2.inputs().emplace_back(chain::output_point{ hash_tx3, 36 }, chain::script{}, 0);
+    tx2.inputs().emplace_back(chain::output_point{ hash_tx2, 27 }, chain::script{}, 0);
+    tx_list.emplace_back(tx2);
+    instance.set_transactions(tx_list);
+
+    size_t transaction = 0;
+    size_t input = 0;
+    BOOST_REQUIRE(instance.is_internal_double_spend(transaction, input));
+    BOOST_REQUIRE_EQUAL(transaction, 2u);
+    BOOST_REQUIRE_EQUAL(input, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(block__is_internal_double_spend__same_checksum__false)
+{
+    // Indexes 32768 apart share a checksum and are distinguished exactly.
+    chain::block instance;
+    chain::transaction::list tx_list;
+    chain::transaction coinbase;
+    tx_list.emplace_back(coinbase);
+    chain::transaction tx1;
+    tx1.inputs().emplace_back(chain::output_point{ hash_tx1, 1 }, chain::script{}, 0);
+    tx1.inputs().emplace_back(chain::output_point{ hash_tx1, 32769 }, chain::script{}, 0);
+    tx_list.emplace_back(tx1);
+    instance.set_transactions(tx_list);
+    BOOST_REQUIRE_EQUAL(instance.is_internal_double_spend(), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(block_connect_tests)
+
+const auto hash_prevout = hash_literal(
+    "bf7c3f5a69a78edd81f3eff7e93a37fb2d7da394d48db4d85e7e5353b9b8e270");
+
+// Test helper.
+static chain::transaction make_spend(uint32_t version,
+    const std::string& prevout_script)
+{
+    chain::transaction tx{ version, 0, { { { hash_prevout, version }, {}, 0 } }, {} };
+
+    if (!prevout_script.empty())
+    {
+        chain::script script;
+        BOOST_REQUIRE(script.from_string(prevout_script));
+        tx.inputs().front().previous_output().metadata.cache = { 0, script };
+    }
+
+    return tx;
+}
+
+// Test helper.
+static chain::block make_block(const chain::transaction::list& spends)
+{
+    chain::transaction coinbase{ 1, 0, { { { null_hash, chain::point::null_index }, {}, 0 } }, {} };
+    chain::transaction::list transactions{ coinbase };
+    transactions.insert(transactions.end(), spends.begin(), spends.end());
+    chain::block instance;
+    instance.set_transactions(transactions);
+    return instance;
+}
+
+// Test helper.
+static chain::chain_state make_state()
+{
+    // Settings are referenced by the state, and must outlive it.
+    static const settings mainnet(config::settings::mainnet);
+    static const chain::chain_state::checkpoints checkpoints;
+
+    chain::chain_state::data values;
+    values.height = 0;
+    return { std::move(values), checkpoints, machine::rule_fork::no_rules, 0,
+        mainnet };
+}
+
+// Test helper.
+static chain::transaction make_key_hash_spend(uint32_t version, bool valid)
+{
+    static const ec_secret secret = base16_literal(
+        "8010b1bb119ad37d4b65a1022a314897b1b3614b345974332cb1b9582cf03536");
+
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    const auto public_key = to_chunk(point);
+    const chain::script prevout_script(chain::script::to_pay_key_hash_pattern(
+        bitcoin_short_hash(public_key)));
+
+    chain::transaction tx{ version, 0, { { { hash_prevout, version }, {}, 0 } }, {} };
+    tx.inputs().front().previous_output().metadata.cache = { 0, prevout_script };
+
+    endorsement out;
+    BOOST_REQUIRE(chain::script::create_endorsement(out, secret,
+        prevout_script, tx, 0, machine::sighash_algorithm::all));
+
+    // Changing the locktime invalidates the signature, not its encoding.
+    if (!valid)
+        tx.set_locktime(1);
+
+    tx.inputs().front().set_script(chain::script({ { to_chunk(out) },
+        { public_key } }));
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(block__connect__pool_coinbase_only__success)
+{
+    threadpool pool(2);
+    const auto state = make_state();
+    const auto instance = make_block({});
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect__empty_pool_valid_inputs__success)
+{
+    threadpool pool;
+    const auto state = make_state();
+    const auto instance = make_block({ make_spend(1, "1"),
+        make_spend(2, "1") });
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(block__connect__pool_valid_inputs__success_and_rate)
+{
+    threadpool pool(4);
+    const auto state = make_state();
+    chain::transaction::list spends;
+
+    for (uint32_t version = 1; version <= 100; ++version)
+        spends.push_back(make_spend(version, "1"));
+
+    const auto instance = make_block(spends);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+    BOOST_REQUIRE(instance.metadata.end_connect >=
+        instance.metadata.start_connect);
+    BOOST_REQUIRE(instance.metadata.connect_rate > 0);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect__pool_missing_prevout__missing_previous_output)
+{
+    threadpool pool(2);
+    const auto state = make_state();
+    const auto instance = make_block({ make_spend(1, "1"),
+        make_spend(2, "") });
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool),
+        error::missing_previous_output);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect__pool_multiple_failures__matches_serial)
+{
+    threadpool pool(4);
+    const auto state = make_state();
+    chain::transaction::list spends;
+
+    for (uint32_t version = 1; version <= 100; ++version)
+        spends.push_back(make_spend(version, version == 42 ? "0" :
+            (version == 77 ? "" : "1")));
+
+    const auto instance = make_block(spends);
+    const auto serial = instance.connect(state);
+    BOOST_REQUIRE_EQUAL(serial, error::stack_false);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), serial);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect__pool_key_hash_spends__success)
+{
+    threadpool pool(4);
+    const auto state = make_state();
+    chain::transaction::list spends;
+
+    for (uint32_t version = 1; version <= 20; ++version)
+        spends.push_back(version % 2 == 0 ?
+            make_key_hash_spend(version, true) : make_spend(version, "1"));
+
+    const auto instance = make_block(spends);
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::success);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+// Key hash spends verified by the batch are not interpreted, so the script
+// cache is only populated by the serial connect.
+BOOST_AUTO_TEST_CASE(block__connect__pool_key_hash_spends__batch_verified)
+{
+    threadpool pool(4);
+    const auto state = make_state();
+    chain::transaction::list spends;
+
+    for (uint32_t version = 1; version <= 20; ++version)
+        spends.push_back(make_key_hash_spend(version, true));
+
+    auto& cache = chain::script::script_cache();
+    cache.resize(100);
+
+    const auto instance = make_block(spends);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), error::success);
+    BOOST_REQUIRE(instance.metadata.connect_rate > 0);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 0u);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+
+    BOOST_REQUIRE_EQUAL(instance.connect(state), error::success);
+    BOOST_REQUIRE_EQUAL(cache.size(), spends.size());
+
+    cache.resize(0);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect__pool_invalid_key_hash_signature__matches_serial)
+{
+    threadpool pool(4);
+    const auto state = make_state();
+    chain::transaction::list spends;
+
+    for (uint32_t version = 1; version <= 20; ++version)
+        spends.push_back(version == 12 ? make_spend(version, "") :
+            make_key_hash_spend(version, version != 7));
+
+    // The failed signature precedes the missing previous output.
+    const auto instance = make_block(spends);
+    const auto serial = instance.connect(state);
+    BOOST_REQUIRE_EQUAL(serial, error::stack_false);
+    BOOST_REQUIRE_EQUAL(instance.connect(state, pool), serial);
+    pool.shutdown();
+    pool.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(block_pipeline_tests)
+
+typedef block_pipeline::block_const_ptr block_ptr;
+
+// Test helper.
+static block_ptr make_genesis()
+{
+    static const settings mainnet(config::settings::mainnet);
+    return std::make_shared<const block>(mainnet.genesis_block);
+}
+
+// Test helper, a genesis block with a chain state that accepts it.
+static block_ptr make_valid_genesis()
+{
+    // Settings are referenced by the state, and must outlive it.
+    static const settings mainnet(config::settings::mainnet);
+    static const chain_state::checkpoints checkpoints;
+    const auto instance = std::make_shared<const block>(mainnet.genesis_block);
+    const auto& header = instance->header();
+
+    // Height zero requires no work, so present the block at height one with
+    // a single (earlier) ancestor of the same difficulty and version.
+    chain_state::data values;
+    values.height = 1;
+    values.hash = header.hash();
+    values.bip9_bit0_hash = null_hash;
+    values.bip9_bit1_hash = null_hash;
+    values.bits.self = header.bits();
+    values.bits.ordered = { header.bits() };
+    values.version.self = header.version();
+    values.version.ordered = { header.version() };
+    values.timestamp.self = header.timestamp();
+    values.timestamp.retarget = header.timestamp();
+    values.timestamp.ordered = { header.timestamp() - 600 };
+    header.metadata.state = std::make_shared<chain_state>(std::move(values),
+        checkpoints, machine::rule_fork::no_rules, 0, mainnet);
+    return instance;
+}
+
+// Test helper, polls the condition for up to ten seconds.
+template <typename Condition>
+static bool wait_for(Condition condition)
+{
+    for (size_t poll = 0; poll < 1000; ++poll)
+    {
+        if (condition())
+            return true;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return false;
+}
+
+// Test helper, records results in completion order.
+struct recorder
+{
+    void record(const code& ec, block_ptr block)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        codes.push_back(ec);
+        blocks.push_back(block);
+    }
+
+    std::vector<code> codes;
+    std::vector<block_ptr> blocks;
+    std::mutex mutex;
+};
+
+BOOST_AUTO_TEST_CASE(block_pipeline__push__valid_block__success_all_stages)
+{
+    threadpool pool(3);
+    const settings mainnet(config::settings::mainnet);
+    const auto genesis = make_valid_genesis();
+    recorder results;
+
+    {
+        block_pipeline instance(pool, mainnet);
+        BOOST_REQUIRE(instance.push(genesis, [&](const code& ec, block_ptr block)
+        {
+            results.record(ec, block);
+        }));
+
+        instance.wait();
+        const auto check = instance.stage_statistics(block_pipeline::stage::check);
+        const auto accept = instance.stage_statistics(block_pipeline::stage::accept);
+        const auto connect = instance.stage_statistics(block_pipeline::stage::connect);
+        BOOST_REQUIRE_EQUAL(check.completed, 1u);
+        BOOST_REQUIRE_EQUAL(accept.completed, 1u);
+        BOOST_REQUIRE_EQUAL(connect.completed, 1u);
+    }
+
+    BOOST_REQUIRE_EQUAL(results.codes.size(), 1u);
+    BOOST_REQUIRE_EQUAL(results.codes.front(), error::success);
+    BOOST_REQUIRE(results.blocks.front() == genesis);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block_pipeline__push__two_blocks__check_overlaps_accept)
+{
+    threadpool pool(3);
+    const settings mainnet(config::settings::mainnet);
+    const auto first = make_valid_genesis();
+    const auto second = make_valid_genesis();
+    std::atomic<bool> overlapped(false);
+    recorder results;
+
+    {
+        block_pipeline instance(pool, mainnet);
+
+        // The first block is held in accept until the second is checked.
+        instance.set_populator([&](const block& block)
+        {
+            if (&block == first.get())
+                overlapped = wait_for([&]()
+                {
+                    return instance.stage_statistics(
+                        block_pipeline::stage::check).completed == 2;
+                });
+
+            return error::success;
+        });
+
+        const auto handler = [&](const code& ec, block_ptr block)
+        {
+            results.record(ec, block);
+        };
+
+        BOOST_REQUIRE(instance.push(first, handler));
+        BOOST_REQUIRE(instance.push(second, handler));
+        instance.wait();
+    }
+
+    BOOST_REQUIRE(overlapped);
+    BOOST_REQUIRE_EQUAL(results.codes.size(), 2u);
+    BOOST_REQUIRE_EQUAL(results.codes[0], error::success);
+    BOOST_REQUIRE_EQUAL(results.codes[1], error::success);
+    BOOST_REQUIRE(results.blocks[0] == first);
+    BOOST_REQUIRE(results.blocks[1] == second);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block_pipeline__push__at_capacity__waits_for_completion)
+{
+    threadpool pool(3);
+    const settings mainnet(config::settings::mainnet);
+    const auto first = make_valid_genesis();
+    const auto second = make_valid_genesis();
+    std::atomic<bool> release(false);
+    std::atomic<bool> pushed(false);
+    recorder results;
+
+    {
+        block_pipeline instance(pool, mainnet, 1);
+
+        // Each block is held in accept until released.
+        instance.set_populator([&](const block&)
+        {
+            wait_for([&]() { return release.load(); });
+            return error::success;
+        });
+
+        const auto handler = [&](const code& ec, block_ptr block)
+        {
+            results.record(ec, block);
+        };
+
+        BOOST_REQUIRE(instance.push(first, handler));
+
+        std::thread pusher([&]()
+        {
+            pushed = instance.push(second, handler);
+        });
+
+        // The second push waits while the first block occupies capacity.
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto held = !pushed;
+        const auto in_flight = instance.in_flight();
+
+        release = true;
+        pusher.join();
+        instance.wait();
+
+        BOOST_REQUIRE(held);
+        BOOST_REQUIRE_EQUAL(in_flight, 1u);
+        BOOST_REQUIRE(pushed);
+    }
+
+    BOOST_REQUIRE_EQUAL(results.codes.size(), 2u);
+    BOOST_REQUIRE_EQUAL(results.codes[0], error::success);
+    BOOST_REQUIRE_EQUAL(results.codes[1], error::success);
+    BOOST_REQUIRE(results.blocks[0] == first);
+    BOOST_REQUIRE(results.blocks[1] == second);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block_pipeline__push__invalid_blocks__first_fails_rest_skipped_in_order)
+{
+    threadpool pool(3);
+    const settings mainnet(config::settings::mainnet);
+    const auto invalid = std::make_shared<const block>();
+    const auto expected = invalid->check(mainnet.max_money(),
+        mainnet.timestamp_limit_seconds, mainnet.proof_of_work_limit);
+    BOOST_REQUIRE(expected);
+
+    recorder results;
+    std::vector<block_ptr> blocks;
+
+    {
+        block_pipeline instance(pool, mainnet, 2);
+
+        for (size_t index = 0; index < 5; ++index)
+        {
+            blocks.push_back(index == 0 ? invalid :
+                std::make_shared<const block>());
+            BOOST_REQUIRE(instance.push(blocks.back(),
+                [&](const code& ec, block_ptr block)
+                {
+                    results.record(ec, block);
+                }));
+        }
+
+        instance.wait();
+        BOOST_REQUIRE_EQUAL(instance.in_flight(), 0u);
+    }
+
+    BOOST_REQUIRE_EQUAL(results.codes.size(), 5u);
+    BOOST_REQUIRE_EQUAL(results.codes[0], expected);
+
+    for (size_t index = 0; index < 5; ++index)
+    {
+        BOOST_REQUIRE(results.blocks[index] == blocks[index]);
+
+        if (index != 0)
+            BOOST_REQUIRE_EQUAL(results.codes[index], error::operation_failed);
+    }
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block_pipeline__push__populator_failure__populator_code)
+{
+    threadpool pool(3);
+    const settings mainnet(config::settings::mainnet);
+    const auto genesis = make_genesis();
+    recorder results;
+
+    {
+        block_pipeline instance(pool, mainnet);
+        instance.set_populator([](const block&)
+        {
+            return error::missing_previous_output;
+        });
+
+        BOOST_REQUIRE(instance.push(genesis, [&](const code& ec, block_ptr block)
+        {
+            results.record(ec, block);
+        }));
+
+        instance.wait();
+
+        const auto check = instance.stage_statistics(block_pipeline::stage::check);
+        const auto accept = instance.stage_statistics(block_pipeline::stage::accept);
+        const auto connect = instance.stage_statistics(block_pipeline::stage::connect);
+        BOOST_REQUIRE_EQUAL(check.completed, 1u);
+        BOOST_REQUIRE_EQUAL(accept.completed, 1u);
+        BOOST_REQUIRE_EQUAL(connect.completed, 1u);
+        BOOST_REQUIRE_EQUAL(check.depth, 0u);
+        BOOST_REQUIRE_EQUAL(accept.depth, 0u);
+        BOOST_REQUIRE_EQUAL(connect.depth, 0u);
+        BOOST_REQUIRE(check.total >= check.last);
+    }
+
+    BOOST_REQUIRE_EQUAL(results.codes.size(), 1u);
+    BOOST_REQUIRE_EQUAL(results.codes.front(), error::missing_previous_output);
+    BOOST_REQUIRE(genesis->metadata.start_populate >= genesis->metadata.start_check);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block_pipeline__push__no_chain_state__operation_failed)
+{
+    threadpool pool(3);
+    const settings mainnet(config::settings::mainnet);
+    recorder results;
+
+    {
+        block_pipeline instance(pool, mainnet);
+        BOOST_REQUIRE(instance.push(make_genesis(), [&](const code& ec, block_ptr block)
+        {
+            results.record(ec, block);
+        }));
+
+        instance.wait();
+    }
+
+    BOOST_REQUIRE_EQUAL(results.codes.size(), 1u);
+    BOOST_REQUIRE_EQUAL(results.codes.front(), error::operation_failed);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block_pipeline__push__stopped__false)
+{
+    threadpool pool(1);
+    const settings mainnet(config::settings::mainnet);
+    block_pipeline instance(pool, mainnet);
+    instance.stop();
+    BOOST_REQUIRE(!instance.push(make_genesis(), [](const code&, block_ptr)
+    {
+        BOOST_FAIL("unexpected handler invocation");
+    }));
+
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), 0u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(block_view_tests)
+
+// Test helper.
+static chain::block make_block(bool double_spend)
+{
+    const chain::input coinbase_input{ { null_hash, chain::point::null_index }, {}, 0 };
+    const chain::transaction coinbase{ 1, 0, { coinbase_input }, { { 50, {} } } };
+    const chain::input spend{ { hash_literal("bf7c3f5a69a78edd81f3eff7e93a37fb2d7da394d48db4d85e7e5353b9b8e270"), 0 }, {}, 0 };
+    const chain::transaction first{ 1, 0, { spend }, { { 10, {} } } };
+    const chain::transaction second{ 2, 0, { double_spend ? spend : chain::input{} }, { { 20, {} } } };
+
+    chain::block instance;
+    instance.set_transactions({ coinbase, first, second });
+    auto header = instance.header();
+    header.set_merkle(instance.generate_merkle_root());
+    instance.set_header(header);
+    return instance;
+}
+
+BOOST_AUTO_TEST_CASE(block_view__constructor__default__invalid)
+{
+    const chain::block_view instance;
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.transactions().empty());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__block__equivalent)
+{
+    const auto block = make_block(false);
+    const auto data = block.to_data();
+    chain::block_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), data.size());
+    BOOST_REQUIRE(instance.header() == block.header());
+    BOOST_REQUIRE(instance.hash() == block.hash());
+    BOOST_REQUIRE_EQUAL(instance.transactions().size(), 3u);
+    BOOST_REQUIRE(instance.transactions().front().is_coinbase());
+    BOOST_REQUIRE(instance.to_hashes() == block.to_hashes());
+    BOOST_REQUIRE(instance.generate_merkle_root() == block.header().merkle());
+    BOOST_REQUIRE(instance.to_block() == block);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__generate_merkle_root__witness__equivalent)
+{
+    const chain::witness reserved{ data_stack{ data_chunk(32, 0x00) } };
+    const chain::witness signature{ data_stack{ { 0x42 }, { 0x2a } } };
+    const chain::input coinbase_input{ { null_hash, chain::point::null_index }, {}, reserved, 0 };
+    const chain::transaction coinbase{ 1, 0, { coinbase_input }, { { 50, {} } } };
+    const chain::input spend{ { hash_literal("bf7c3f5a69a78edd81f3eff7e93a37fb2d7da394d48db4d85e7e5353b9b8e270"), 0 }, {}, signature, 0 };
+    const chain::transaction transaction{ 1, 0, { spend }, { { 10, {} } } };
+
+    chain::block block;
+    block.set_transactions({ coinbase, transaction });
+    const auto data = block.to_data(true);
+
+    chain::block_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    BOOST_REQUIRE(instance.transactions().front().is_segregated());
+    BOOST_REQUIRE(instance.transactions().front().hash(true) == null_hash);
+    BOOST_REQUIRE(instance.to_hashes(true) == block.to_hashes(true));
+    BOOST_REQUIRE(instance.generate_merkle_root(true) == block.generate_merkle_root(true));
+    BOOST_REQUIRE(instance.generate_merkle_root() == block.generate_merkle_root());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__is_internal_double_spend__distinct__false)
+{
+    const auto data = make_block(false).to_data();
+    chain::block_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    BOOST_REQUIRE(!instance.is_internal_double_spend());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__is_internal_double_spend__duplicate__true)
+{
+    const auto data = make_block(true).to_data();
+    chain::block_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    BOOST_REQUIRE(instance.is_internal_double_spend());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__insufficient_bytes__failure)
+{
+    auto data = make_block(false).to_data();
+    data.pop_back();
+    chain::block_view instance;
+    BOOST_REQUIRE(!instance.from_data(data));
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.transactions().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
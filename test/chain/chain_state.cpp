@@ -58,4 +58,65 @@ BOOST_AUTO_TEST_CASE(chain_state__work_required_retarget__overflow_patch_enabled
     BOOST_REQUIRE_EQUAL(work, settings.proof_of_work_limit);
 }
 
+BOOST_AUTO_TEST_CASE(chain_state__constructor__promoted_headers__matches_raw_data)
+{
+    settings settings(config::settings::mainnet);
+    settings.activation_sample = 5;
+    settings.activation_threshold = 3;
+    settings.enforcement_threshold = 4;
+    const chain::chain_state::checkpoints checkpoints;
+    const uint32_t forks = machine::rule_fork::all_rules &
+        ~machine::rule_fork::bip90_rule;
+
+    chain::chain_state::data values;
+    values.height = 100;
+    values.hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    values.bip9_bit0_hash = null_hash;
+    values.bip9_bit1_hash = null_hash;
+    values.bits.self = 0x1d00ffff;
+    values.bits.ordered = { 0x1d00ffff };
+    values.version.self = 4;
+    values.version.ordered = { 1, 2, 3, 4, 0x80000004 };
+    values.timestamp.self = 1000660;
+    values.timestamp.retarget = 0;
+    values.timestamp.ordered = { 1000000, 1000900, 1000060, 1000600, 1000120,
+        1000540, 1000180, 1000480, 1000240, 1000420, 1000300 };
+
+    auto expected = values;
+    auto parent = std::make_shared<chain::chain_state>(std::move(values),
+        checkpoints, forks, 0, settings);
+
+    for (uint32_t index = 0; index < 32; ++index)
+    {
+        const uint32_t version = index % 7 == 0 ? 0x80000004 : index % 4 + 1;
+        const uint32_t timestamp = 1000000 + (index * 7919 % 50) * 60;
+        const chain::header header(version, parent->hash(), null_hash,
+            timestamp, 0x1d00ffff, 0);
+
+        // Promote the expected values as a raw data source would.
+        expected.version.ordered.push_back(expected.version.self);
+        expected.version.ordered.pop_front();
+        expected.timestamp.ordered.push_back(expected.timestamp.self);
+        expected.timestamp.ordered.pop_front();
+        expected.height++;
+        expected.hash = header.hash();
+        expected.version.self = version;
+        expected.timestamp.self = timestamp;
+
+        auto copy = expected;
+        const chain::chain_state raw(std::move(copy), checkpoints, forks, 0,
+            settings);
+
+        parent = std::make_shared<chain::chain_state>(*parent, header,
+            settings);
+
+        BOOST_REQUIRE_EQUAL(parent->height(), raw.height());
+        BOOST_REQUIRE_EQUAL(parent->median_time_past(), raw.median_time_past());
+        BOOST_REQUIRE_EQUAL(parent->enabled_forks(), raw.enabled_forks());
+        BOOST_REQUIRE_EQUAL(parent->minimum_block_version(),
+            raw.minimum_block_version());
+        BOOST_REQUIRE_EQUAL(parent->work_required(), raw.work_required());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
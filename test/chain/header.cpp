@@ -539,4 +539,24 @@ BOOST_AUTO_TEST_CASE(header__operator_boolean_not_equals__differs__returns_true)
     BOOST_REQUIRE(instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__genesis_nonce_only__true)
+{
+    static const uint32_t iterations = 16;
+    const settings settings(bc::config::settings::mainnet);
+    const chain::block genesis = settings.genesis_block;
+    const auto nonce = genesis.header().nonce();
+    auto header = genesis.header();
+    size_t valid = 0;
+
+    // Only the genesis nonce satisfies the genesis target.
+    for (uint32_t count = 0; count < iterations; ++count)
+    {
+        header.set_nonce(nonce + count);
+        valid += header.is_valid_proof_of_work(settings.proof_of_work_limit,
+            false) ? 1 : 0;
+    }
+
+    BOOST_REQUIRE_EQUAL(valid, 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
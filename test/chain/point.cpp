@@ -17,6 +17,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <boost/test/unit_test.hpp>
+#include <unordered_set>
 #include <bitcoin/bitcoin.hpp>
 
 using namespace bc;
@@ -304,4 +305,23 @@ BOOST_AUTO_TEST_CASE(point__checksum__pattern_high__returns_expected)
     BOOST_REQUIRE_EQUAL(instance.checksum(), 0x1234567aaaacdef);
 }
 
+BOOST_AUTO_TEST_CASE(point__std_hash__unordered_set__finds_equal_points)
+{
+    static const auto tx_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    std::unordered_set<chain::point> set;
+    BOOST_REQUIRE(set.insert({ tx_hash, 0 }).second);
+    BOOST_REQUIRE(set.insert({ tx_hash, 1 }).second);
+    BOOST_REQUIRE(!set.insert({ tx_hash, 0 }).second);
+    BOOST_REQUIRE_EQUAL(set.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(point__std_hash__output_point__matches_point)
+{
+    static const auto tx_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const chain::point instance(tx_hash, 42);
+    const chain::output_point output(tx_hash, 42);
+    BOOST_REQUIRE_EQUAL(std::hash<chain::point>()(instance),
+        std::hash<chain::output_point>()(output));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
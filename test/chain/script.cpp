@@ -19,6 +19,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <sstream>
+#include <utility>
 #include <bitcoin/bitcoin.hpp>
 #include "script.hpp"
 
@@ -221,6 +222,70 @@ BOOST_AUTO_TEST_CASE(script__factory_reader_test)
     BOOST_REQUIRE(instance.is_valid());
 }
 
+// Test helper, a prefixed pay key hash script read into the arena.
+static script arena_script(const script_arena::ptr& memory)
+{
+    const auto raw = to_chunk(base16_literal(
+        "1976a914fc7b44566256621affb1541cc9d59f08336d276b88ac"));
+    auto source = make_safe_deserializer(raw.data(), raw.data() + raw.size());
+    script instance;
+    BOOST_REQUIRE(instance.from_data(source, memory, true));
+    return instance;
+}
+
+BOOST_AUTO_TEST_CASE(script__from_data__arena__allocates_from_arena)
+{
+    const script_arena::ptr memory(new script_arena);
+    const auto instance = arena_script(memory);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(memory->allocated(), 25u);
+    BOOST_REQUIRE(instance.is_pay_key_hash_pattern(instance.operations()));
+}
+
+BOOST_AUTO_TEST_CASE(script__move__arena_released__retains_bytes)
+{
+    script_arena::ptr memory(new script_arena);
+    auto instance = arena_script(memory);
+    const auto expected = instance.to_data(true);
+    memory.reset();
+
+    const script moved(std::move(instance));
+    BOOST_REQUIRE(moved.to_data(true) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(script__copy_assign__into_arena_script__does_not_allocate_from_arena)
+{
+    const script_arena::ptr memory(new script_arena);
+    auto instance = arena_script(memory);
+    const auto allocated = memory->allocated();
+
+    script other;
+    BOOST_REQUIRE(other.from_string(SCRIPT_16_OF_16_MULTISIG));
+    instance = other;
+    instance = other;
+    BOOST_REQUIRE(instance == other);
+    BOOST_REQUIRE_EQUAL(memory->allocated(), allocated);
+}
+
+BOOST_AUTO_TEST_CASE(script__find_and_delete__arena_script__detaches)
+{
+    const script_arena::ptr memory(new script_arena);
+    auto instance = arena_script(memory);
+    const auto allocated = memory->allocated();
+    const auto hash = base16_literal("fc7b44566256621affb1541cc9d59f08336d276b");
+    instance.find_and_delete({ small_chunk(hash.begin(), hash.end()) });
+
+    BOOST_REQUIRE(instance == script(to_chunk(base16_literal("76a988ac")), false));
+    BOOST_REQUIRE_EQUAL(memory->allocated(), allocated);
+}
+
+BOOST_AUTO_TEST_CASE(script__sizeof__arena_support__no_larger_than_heap_bytes)
+{
+    // Arena bytes share the space of heap bytes, only a flag is added.
+    BOOST_REQUIRE_LE(sizeof(script), sizeof(once_value<operation::list>) +
+        sizeof(data_chunk) + sizeof(size_t));
+}
+
 BOOST_AUTO_TEST_CASE(script__from_data__first_byte_invalid_wire_code__success)
 {
     const auto raw = to_chunk(base16_literal(
@@ -667,6 +732,129 @@ BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all__expected)
     BOOST_REQUIRE_EQUAL(result, expected);
 }
 
+// Reference serialization of the unversioned signature hash (no separators).
+static hash_digest copied_signature_hash(const transaction& tx,
+    uint32_t index, const script& script_code, uint8_t sighash_type)
+{
+    const auto algorithm = sighash_type & sighash_algorithm::mask;
+    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
+    const auto single = algorithm == sighash_algorithm::single;
+    const auto none = algorithm == sighash_algorithm::none;
+    const auto& inputs = tx.inputs();
+    const auto& self = inputs[index];
+
+    input::list ins;
+    if (any)
+    {
+        ins.emplace_back(self.previous_output(), script_code, self.sequence());
+    }
+    else
+    {
+        for (uint32_t at = 0; at < inputs.size(); ++at)
+            ins.emplace_back(inputs[at].previous_output(),
+                at == index ? script_code : script{},
+                at == index || !(single || none) ? inputs[at].sequence() : 0);
+    }
+
+    output::list outs;
+    if (single)
+    {
+        outs.resize(index + 1);
+        outs.back() = tx.outputs()[index];
+    }
+    else if (!none)
+    {
+        outs = tx.outputs();
+    }
+
+    auto data = transaction(tx.version(), tx.locktime(), ins, outs).to_data();
+    extend_data(data, to_little_endian<uint32_t>(sighash_type));
+    return bitcoin_hash(data);
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all_types_all_inputs__expected)
+{
+    // Two inputs and two outputs (testnet block 23428).
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000002c0cd5346700d18a937575424eb84888bdc277bdbfade39b3bb9a4ce31fd4455101000000fdf60100483045022100f681bb660ef85bb191e337450f2ba3493c37b90a8622864d932cec5b40a74428022007cab269d846b7e63899b8e7082bdea94375d4b1c197b7c50365823c9ffd935e01483045022100b4d3be95b088c8ef176b25c9cee0b16ac7f91c10ccf645ab7421ad3de1d8aba802205c6b3bd9df0b19271abefc47997ce7bd113a6f069674003c821c01440d49a48b0148304502207fad219634211fb614cef1654bdb956a9ed751a352e47c2b64d4ac8459e05ec2022100bd4ae53e76f266938f2ec09d1b2d515eaf5e21b990e5c7df0779ca61f24a10de014830450221009f2dd7fa5eafdf9f660e764750aabffd86628bb19501d49007551151f6409266022019fad776d46c6896a849bf7fcacefa73da6d5db22680c7bacdd055d8d8547858014ccf542102d7dafdc7f5d63bc1e5210a93a93c57e96acfb123df06ca02318be689791fa634210204affb8e9fd6228d370aed6b8fff2fc33bbe9603e2933ae3b92b11a67d7e7d3d210269fa9a07b38c01440ecabc74481fdd2ede1591e293a1108ba1ac511d85e40ca62102f24bda0faab218a98c5975cb7eb035b37020ec3758e454d95f382e1f274da2112102795716e51a5539961872b559f2e938a29862565c1d0c70ed6a748adb8541c82b2103828209539e87cc72694e0d397a00ae1c1b3aa3aa7931df3bb72c71172758ed7756aeffffffffca1ea035fedd045da687f8219f6d76982b47fd3edab01212d3def0dc917d321801000000fdf40100473044022050cf9d0bf024af1780af7ce91a8cac62fd54a3df96cc1eb27889a58aaf82f09e02205f85c010faa5978963f569cfa6bd7202363841ad82bab0a6044c1092140ba49001483045022100f3f5076e1f233acf3fd2bb1188da82f3259224ee29a50af287b707c71503543f02202e82db849e59f8eb836ec6c55dab6a3d61b6511e9d25e550901d5534276432320148304502210094ff0cd6c74dd756a07334c2b76373dd4fb8f5ef7c1da7e09a168d54cf79a7770220114337de0ac0edd7871c079b796ad422d2d5e50d350d3b9f7371b0f1bd66fe7a01473044022022bc92872b6c680da40aa6388e28ef396c7ffa410317ae574c1f31836c85b28602203b43a7d2cdcc2ba1afaf53c1a0c0b474933581b0e359aed788ad7ad819260dfb014ccf542102d7dafdc7f5d63bc1e5210a93a93c57e96acfb123df06ca02318be689791fa634210204affb8e9fd6228d370aed6b8fff2fc33bbe9603e2933ae3b92b11a67d7e7d3d210269fa9a07b38c01440ecabc74481fdd2ede1591e293a1108ba1ac511d85e40ca62102f24bda0faab218a98c5975cb7eb035b37020ec3758e454d95f382e1f274da2112102795716e51a5539961872b559f2e938a29862565c1d0c70ed6a748adb8541c82b2103828209539e87cc72694e0d397a00ae1c1b3aa3aa7931df3bb72c71172758ed7756aeffffffff02605af405000000001976a914bb6754a948265de730c60fbd745aeb5868ea921e88ac00e1f5050000000017a9144aba54e2541475f91659ccdbb13ce0b490778c7f8700000000");
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(tx_data));
+
+    script prevout_script;
+    BOOST_REQUIRE(prevout_script.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig"));
+
+    // Includes undefined types, which are treated as sighash all.
+    static const uint8_t types[] { 0x00, 0x01, 0x02, 0x03, 0x04, 0x81, 0x82, 0x83, 0xe4 };
+
+    for (uint32_t index = 0; index < tx.inputs().size(); ++index)
+    {
+        for (const auto type: types)
+        {
+            const auto sighash = script::generate_signature_hash(tx, index, prevout_script, type);
+            BOOST_REQUIRE(sighash == copied_signature_hash(tx, index, prevout_script, type));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__single_without_output__one_hash)
+{
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000001b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee0970000000000ffffffff0000000000");
+    transaction new_tx;
+    BOOST_REQUIRE(new_tx.from_data(tx_data));
+
+    const auto sighash = script::generate_signature_hash(new_tx, 0, script{}, sighash_algorithm::single);
+    BOOST_REQUIRE_EQUAL(encode_hash(sighash), "0000000000000000000000000000000000000000000000000000000000000001");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__set_inputs__context_reset)
+{
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000001b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee0970100000000ffffffff01905f0100000000001976a91418c0bd8d1818f1bf99cb1df2269c645318ef7b7388ac00000000");
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(tx_data));
+
+    script prevout_script;
+    BOOST_REQUIRE(prevout_script.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig"));
+
+    const auto type = sighash_algorithm::all;
+    const auto before = script::generate_signature_hash(tx, 0, prevout_script, type);
+
+    auto inputs = tx.inputs();
+    inputs.front().set_sequence(42);
+    tx.set_inputs(inputs);
+
+    const auto after = script::generate_signature_hash(tx, 0, prevout_script, type);
+    BOOST_REQUIRE(before != after);
+    BOOST_REQUIRE(after == copied_signature_hash(tx, 0, prevout_script, type));
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__script_cache_enabled__caches_success_only)
+{
+    const input::list inputs{ { output_point{ null_hash, 0 }, script{}, 0 } };
+    const transaction tx(1, 0, inputs, {});
+    script valid_script;
+    BOOST_REQUIRE(valid_script.from_string("[01]"));
+    script invalid_script;
+    BOOST_REQUIRE(invalid_script.from_string("[00]"));
+
+    auto& cache = script::script_cache();
+    cache.resize(10);
+
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::no_rules, valid_script, 0), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::no_rules, valid_script, 0), error::success);
+    BOOST_REQUIRE_EQUAL(cache.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 1u);
+
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::no_rules, invalid_script, 0), error::stack_false);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::no_rules, invalid_script, 0), error::stack_false);
+    BOOST_REQUIRE_EQUAL(cache.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 3u);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+
+    cache.resize(0);
+}
+
 // Ad-hoc test cases.
 //-----------------------------------------------------------------------------
 
@@ -908,6 +1096,238 @@ BOOST_AUTO_TEST_CASE(script__verify__bip143_native_p2wpkh_tx__valid)
     BOOST_REQUIRE_EQUAL(result1.value(), error::unexpected_witness);
 }
 
+BOOST_AUTO_TEST_CASE(script__verify__p2wpkh_key_hash_mismatch__interpreter_error)
+{
+    transaction tx;
+    data_chunk decoded_tx;
+    data_chunk decoded_script;
+    BOOST_REQUIRE(decode_base16(decoded_tx, "01000000000102fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f00000000494830450221008b9d1dc26ba6a9cb62127b02742fa9d754cd3bebf337f7a55d114c8e5cdd30be022040529b194ba3f9281a99f2b1c0a19c0489bc22ede944ccf4ecbab4cc618ef3ed01eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac000247304402203609e17b84f6a7d30c80bfa610b5b4542f32a8a0d5447a12fb1366d7f01cc44a0220573a954c4518331561406f90300e8f3358f51928d43c212a8caed02de67eebee0121025476c2e83188368da1ff3e292e7acafcdb3566bb0ad253f62fc70f07aeee635711000000"));
+    BOOST_REQUIRE(tx.from_data(decoded_tx, true, true));
+
+    // The program differs from the hash of the witness public key.
+    auto& prevout1 = tx.inputs()[1].previous_output().metadata.cache;
+    BOOST_REQUIRE(decode_base16(decoded_script, "00141d0f172a0ecb48aee1be1f2687d2963ae33f71a2"));
+    prevout1.set_script(script::factory(decoded_script, false));
+    prevout1.set_value(600000000);
+
+    const auto result = script::verify(tx, 1, rule_fork::bip141_rule | rule_fork::bip143_rule);
+    BOOST_REQUIRE_EQUAL(result.value(), error::op_equal_verify2);
+}
+
+// Key hash fast path test cases.
+//-----------------------------------------------------------------------------
+
+static const auto key_hash_secret = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+
+// Verify the input with the interpreter alone, bypassing the key hash fast
+// paths of script::verify (non-p2sh spends only).
+static code interpret(const transaction& tx, uint32_t index, uint32_t forks)
+{
+    code ec;
+    const auto& in = tx.inputs()[index];
+    const auto& prevout = in.previous_output().metadata.cache;
+
+    program input(in.script(), tx, index, forks);
+    if ((ec = input.evaluate()))
+        return ec;
+
+    program output(prevout.script(), input);
+    if ((ec = output.evaluate()))
+        return ec;
+
+    if (!output.stack_result(false))
+        return error::stack_false;
+
+    const auto bip141 = script::is_enabled(forks, rule_fork::bip141_rule);
+    const auto& ops = prevout.script().operations();
+
+    if (bip141 && script::is_witness_program_pattern(ops))
+        return in.script().empty() ? in.witness().verify(tx, index, forks,
+            prevout.script(), prevout.value()) : error::dirty_witness;
+
+    return in.witness().empty() ? error::success : error::unexpected_witness;
+}
+
+// Create a one input transaction with a p2pkh prevout of the given key and an
+// endorsement of it, the input script is left to the caller.
+static transaction make_pay_key_hash_spend(endorsement& out,
+    const data_chunk& public_key)
+{
+    data_chunk tx_data;
+    BOOST_REQUIRE(decode_base16(tx_data, "0100000001b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee0970100000000ffffffff01905f0100000000001976a91418c0bd8d1818f1bf99cb1df2269c645318ef7b7388ac00000000"));
+
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(tx_data));
+
+    const auto hash = bitcoin_short_hash(public_key);
+    const script prevout_script(script::to_pay_key_hash_pattern(hash));
+    tx.inputs()[0].previous_output().metadata.cache.set_script(prevout_script);
+    BOOST_REQUIRE(script::create_endorsement(out, key_hash_secret,
+        prevout_script, tx, 0, sighash_algorithm::all));
+    return tx;
+}
+
+static data_chunk make_public_key()
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, key_hash_secret));
+    return to_chunk(point);
+}
+
+// The bip143 native p2wpkh transaction, input 1 is the p2wpkh spend.
+static transaction make_pay_witness_key_hash_spend()
+{
+    transaction tx;
+    data_chunk decoded_tx;
+    data_chunk decoded_script;
+    BOOST_REQUIRE(decode_base16(decoded_tx, "01000000000102fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f00000000494830450221008b9d1dc26ba6a9cb62127b02742fa9d754cd3bebf337f7a55d114c8e5cdd30be022040529b194ba3f9281a99f2b1c0a19c0489bc22ede944ccf4ecbab4cc618ef3ed01eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac000247304402203609e17b84f6a7d30c80bfa610b5b4542f32a8a0d5447a12fb1366d7f01cc44a0220573a954c4518331561406f90300e8f3358f51928d43c212a8caed02de67eebee0121025476c2e83188368da1ff3e292e7acafcdb3566bb0ad253f62fc70f07aeee635711000000"));
+    BOOST_REQUIRE(tx.from_data(decoded_tx, true, true));
+
+    auto& prevout = tx.inputs()[1].previous_output().metadata.cache;
+    BOOST_REQUIRE(decode_base16(decoded_script, "00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1"));
+    prevout.set_script(script::factory(decoded_script, false));
+    prevout.set_value(600000000);
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_key_hash__equals_interpreter)
+{
+    endorsement out;
+    const auto public_key = make_public_key();
+    auto tx = make_pay_key_hash_spend(out, public_key);
+    tx.inputs()[0].set_script(script({ { to_chunk(out) }, { public_key } }));
+
+    const auto forks = rule_fork::all_rules;
+    BOOST_REQUIRE_EQUAL(interpret(tx, 0, forks).value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks).value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_key_hash_non_canonical_push__equals_interpreter)
+{
+    endorsement out;
+    const auto public_key = make_public_key();
+    auto tx = make_pay_key_hash_spend(out, public_key);
+
+    // The endorsement is pushed with push_one_size (non-minimal encoding).
+    data_chunk encoded{ static_cast<uint8_t>(opcode::push_one_size) };
+    encoded.push_back(static_cast<uint8_t>(out.size()));
+    extend_data(encoded, out);
+    encoded.push_back(static_cast<uint8_t>(public_key.size()));
+    extend_data(encoded, public_key);
+
+    const script input_script(encoded, false);
+    BOOST_REQUIRE(input_script.is_valid());
+    BOOST_REQUIRE(input_script[0].code() == opcode::push_one_size);
+    tx.inputs()[0].set_script(input_script);
+
+    const auto forks = rule_fork::all_rules;
+    const auto expected = interpret(tx, 0, forks);
+    BOOST_REQUIRE_EQUAL(expected.value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks).value(), expected.value());
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_key_hash_short_hash_size_endorsement__equals_interpreter)
+{
+    endorsement out;
+    const auto public_key = make_public_key();
+    auto tx = make_pay_key_hash_spend(out, public_key);
+    const data_chunk short_endorsement(short_hash_size, 0x42);
+    tx.inputs()[0].set_script(script({ { short_endorsement }, { public_key } }));
+
+    const auto forks = rule_fork::all_rules;
+    const auto expected = interpret(tx, 0, forks);
+    BOOST_REQUIRE(expected);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks).value(), expected.value());
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_key_hash_oversized_key__equals_interpreter)
+{
+    // The prevout commits to the hash of the oversized key.
+    endorsement out;
+    auto public_key = make_public_key();
+    public_key.push_back(0x00);
+    auto tx = make_pay_key_hash_spend(out, public_key);
+    tx.inputs()[0].set_script(script({ { to_chunk(out) }, { public_key } }));
+
+    const auto forks = rule_fork::all_rules;
+    const auto expected = interpret(tx, 0, forks);
+    BOOST_REQUIRE_EQUAL(expected.value(), error::stack_false);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks).value(), expected.value());
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_key_hash_extra_nop__equals_interpreter)
+{
+    endorsement out;
+    const auto public_key = make_public_key();
+    auto tx = make_pay_key_hash_spend(out, public_key);
+    tx.inputs()[0].set_script(script({ { to_chunk(out) }, { public_key },
+        { opcode::nop } }));
+
+    const auto forks = rule_fork::all_rules;
+    const auto expected = interpret(tx, 0, forks);
+    BOOST_REQUIRE_EQUAL(expected.value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks).value(), expected.value());
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_key_hash_extra_drop__equals_interpreter)
+{
+    endorsement out;
+    const auto public_key = make_public_key();
+    auto tx = make_pay_key_hash_spend(out, public_key);
+    tx.inputs()[0].set_script(script({ { to_chunk(out) }, { public_key },
+        { opcode::drop } }));
+
+    const auto forks = rule_fork::all_rules;
+    const auto expected = interpret(tx, 0, forks);
+    BOOST_REQUIRE(expected);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks).value(), expected.value());
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_witness_key_hash__equals_interpreter)
+{
+    const auto tx = make_pay_witness_key_hash_spend();
+
+    const auto forks = rule_fork::bip141_rule | rule_fork::bip143_rule;
+    BOOST_REQUIRE_EQUAL(interpret(tx, 1, forks).value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 1, forks).value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_witness_key_hash_extra_item__equals_interpreter)
+{
+    auto tx = make_pay_witness_key_hash_spend();
+    auto stack = tx.inputs()[1].witness().stack();
+    stack.push_back(data_chunk{ 0x01 });
+    tx.inputs()[1].set_witness(witness(std::move(stack)));
+
+    const auto forks = rule_fork::bip141_rule | rule_fork::bip143_rule;
+    const auto expected = interpret(tx, 1, forks);
+    BOOST_REQUIRE_EQUAL(expected.value(), error::invalid_witness);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 1, forks).value(), expected.value());
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_witness_key_hash_short_hash_size_endorsement__equals_interpreter)
+{
+    auto tx = make_pay_witness_key_hash_spend();
+    auto stack = tx.inputs()[1].witness().stack();
+    stack[0] = data_chunk(short_hash_size, 0x42);
+    tx.inputs()[1].set_witness(witness(std::move(stack)));
+
+    const auto forks = rule_fork::bip141_rule | rule_fork::bip143_rule;
+    const auto expected = interpret(tx, 1, forks);
+    BOOST_REQUIRE_EQUAL(expected.value(), error::stack_false);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 1, forks).value(), expected.value());
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_witness_key_hash_missing_bip143__equals_interpreter)
+{
+    const auto tx = make_pay_witness_key_hash_spend();
+
+    const auto forks = rule_fork::bip141_rule;
+    const auto expected = interpret(tx, 1, forks);
+    BOOST_REQUIRE_EQUAL(expected.value(), error::stack_false);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 1, forks).value(), expected.value());
+}
+
 BOOST_AUTO_TEST_CASE(script__verify__bip143_p2sh_p2wpkh_tx__valid)
 {
     transaction tx;
@@ -17,6 +17,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <boost/test/unit_test.hpp>
+
+#include <utility>
 #include <bitcoin/bitcoin.hpp>
 
 using namespace bc;
@@ -1081,4 +1083,160 @@ BOOST_AUTO_TEST_CASE(transaction__is_internal_double_spend__nonunique_prevouts__
     BOOST_REQUIRE_EQUAL(instance.is_internal_double_spend(), true);
 }
 
+#define WITNESS_TX \
+"01000000000101db6b1b20aa0fd7b23880be2ecbd4a98130974cf4748fb66092ac4d3c" \
+"eb1a5477010000001716001479091972186c449eb1ded22b78e40d009bdf0089feffff" \
+"ff02b8b4eb0b000000001976a914a457b684d7f0d539a46a45bbc043f35b59d0d96388" \
+"ac0008af2f000000001976a914fd270b1ee6abcaea97fea7ad0402e8bd8ad6d77c88ac" \
+"02473044022047ac8e878352d3ebbde1c94ce3a10d057c24175747116f8288e5d794d1" \
+"2d482f0220217f36a485cae903c713331d877c1f64677e3622ad4010726870540656fe" \
+"9dcb012103ad1d8e89212f0b92c74d23bb710c00662ad1470198ac48c43f7d6f93a2a2" \
+"687392040000"
+
+BOOST_AUTO_TEST_CASE(transaction__from_data__buffer_and_stream__same_hashes)
+{
+    static const auto raw_tx = to_chunk(base16_literal(TX4));
+    data_source stream(raw_tx);
+    const auto streamed = chain::transaction::factory(stream);
+    const auto buffered = chain::transaction::factory(raw_tx);
+    BOOST_REQUIRE(streamed.is_valid());
+    BOOST_REQUIRE(buffered.is_valid());
+    BOOST_REQUIRE(buffered.hash() == hash_literal(TX4_HASH));
+    BOOST_REQUIRE(buffered.hash() == streamed.hash());
+}
+
+BOOST_AUTO_TEST_CASE(transaction__from_data__witness_buffer__expected_hashes)
+{
+    static const auto raw_tx = to_chunk(base16_literal(WITNESS_TX));
+    data_source stream(raw_tx);
+    const auto streamed = chain::transaction::factory(stream, true, true);
+    const auto buffered = chain::transaction::factory(raw_tx, true, true);
+    BOOST_REQUIRE(buffered.is_valid());
+    BOOST_REQUIRE(buffered.is_segregated());
+    BOOST_REQUIRE(buffered.hash() == streamed.hash());
+    BOOST_REQUIRE(buffered.hash(true) == streamed.hash(true));
+    BOOST_REQUIRE(buffered.hash() == bitcoin_hash(buffered.to_data(true, false)));
+    BOOST_REQUIRE(buffered.hash(true) == bitcoin_hash(raw_tx));
+    BOOST_REQUIRE(buffered.hash() != buffered.hash(true));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__from_data__witness_buffer_stripped__expected_hashes)
+{
+    static const auto raw_tx = to_chunk(base16_literal(WITNESS_TX));
+    const auto buffered = chain::transaction::factory(raw_tx, true, false);
+    BOOST_REQUIRE(buffered.is_valid());
+    BOOST_REQUIRE(!buffered.is_segregated());
+    BOOST_REQUIRE(buffered.hash() == bitcoin_hash(buffered.to_data(true)));
+    BOOST_REQUIRE(buffered.hash(true) == buffered.hash());
+}
+
+BOOST_AUTO_TEST_CASE(transaction__from_data__non_canonical_buffer__hashes_canonical)
+{
+    // The single input count of TX1 is re-encoded as a three byte varint.
+    const auto canonical = to_chunk(base16_literal(TX1));
+    auto non_canonical = canonical;
+    non_canonical[4] = 0xfd;
+    non_canonical.insert(non_canonical.begin() + 5, { 0x01, 0x00 });
+
+    const auto tx = chain::transaction::factory(non_canonical);
+    BOOST_REQUIRE(tx.is_valid());
+    BOOST_REQUIRE(tx.hash() == hash_literal(TX1_HASH));
+}
+
+// Test helper, the signature hash of the first input from a fresh context.
+static hash_digest first_sighash(const chain::transaction& tx)
+{
+    static const auto code = chain::script(chain::script::to_pay_null_data_pattern(
+        data_chunk{ 42 }));
+    return chain::script::generate_signature_hash(tx, 0, code,
+        machine::sighash_algorithm::all);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__set_version__cached_sighash__recomputed)
+{
+    auto instance = chain::transaction::factory(to_chunk(base16_literal(TX4)));
+    const auto original = first_sighash(instance);
+    instance.set_version(instance.version() + 1u);
+
+    const chain::transaction expected(instance.version(), instance.locktime(),
+        instance.inputs(), instance.outputs());
+    BOOST_REQUIRE(first_sighash(instance) != original);
+    BOOST_REQUIRE(first_sighash(instance) == first_sighash(expected));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__set_locktime__cached_sighash__recomputed)
+{
+    auto instance = chain::transaction::factory(to_chunk(base16_literal(TX4)));
+    const auto original = first_sighash(instance);
+    instance.set_locktime(instance.locktime() + 1u);
+
+    const chain::transaction expected(instance.version(), instance.locktime(),
+        instance.inputs(), instance.outputs());
+    BOOST_REQUIRE(first_sighash(instance) != original);
+    BOOST_REQUIRE(first_sighash(instance) == first_sighash(expected));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__copy_assign__cached_sighash__recomputed)
+{
+    const auto other = chain::transaction::factory(to_chunk(base16_literal(TX1)));
+    auto instance = chain::transaction::factory(to_chunk(base16_literal(TX4)));
+    const auto expected = first_sighash(other);
+    BOOST_REQUIRE(first_sighash(instance) != expected);
+
+    instance = other;
+    BOOST_REQUIRE(first_sighash(instance) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__move_assign__cached_sighash__recomputed)
+{
+    auto other = chain::transaction::factory(to_chunk(base16_literal(TX1)));
+    auto instance = chain::transaction::factory(to_chunk(base16_literal(TX4)));
+    const auto expected = first_sighash(other);
+    BOOST_REQUIRE(first_sighash(instance) != expected);
+
+    instance = std::move(other);
+    BOOST_REQUIRE(first_sighash(instance) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__outputs__edited_cached_sighash__recomputed)
+{
+    auto instance = chain::transaction::factory(to_chunk(base16_literal(TX4)));
+    const auto original = first_sighash(instance);
+    instance.outputs()[0].set_value(99);
+
+    const chain::transaction expected(instance.version(), instance.locktime(),
+        instance.inputs(), instance.outputs());
+    BOOST_REQUIRE(first_sighash(instance) != original);
+    BOOST_REQUIRE(first_sighash(instance) == first_sighash(expected));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__release_signature_hashes__cached_sighash__recomputed)
+{
+    const auto instance = chain::transaction::factory(to_chunk(base16_literal(TX4)));
+    const auto original = first_sighash(instance);
+    instance.release_signature_hashes();
+    BOOST_REQUIRE(first_sighash(instance) == original);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__inputs__retained_push_back__recomputed)
+{
+    static const auto code = chain::script(
+        chain::script::to_pay_null_data_pattern(data_chunk{ 42 }));
+
+    auto instance = chain::transaction::factory(to_chunk(base16_literal(TX4)));
+    auto& inputs = instance.inputs();
+    const auto original = first_sighash(instance);
+    inputs.push_back(inputs.front());
+
+    const chain::transaction expected(instance.version(), instance.locktime(),
+        instance.inputs(), instance.outputs());
+    const auto last = static_cast<uint32_t>(inputs.size() - 1u);
+    BOOST_REQUIRE(first_sighash(instance) != original);
+    BOOST_REQUIRE(first_sighash(instance) == first_sighash(expected));
+    BOOST_REQUIRE(chain::script::generate_signature_hash(instance, last, code,
+        machine::sighash_algorithm::all) ==
+        chain::script::generate_signature_hash(expected, last, code,
+            machine::sighash_algorithm::all));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
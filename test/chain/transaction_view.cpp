@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(transaction_view_tests)
+
+#define VIEW_TX \
+"0100000001f08e44a96bfb5ae63eda1a6620adae37ee37ee4777fb0336e1bbbc" \
+"4de65310fc010000006a473044022050d8368cacf9bf1b8fb1f7cfd9aff63294" \
+"789eb1760139e7ef41f083726dadc4022067796354aba8f2e02363c5e510aa7e" \
+"2830b115472fb31de67d16972867f13945012103e589480b2f746381fca01a9b" \
+"12c517b7a482a203c8b2742985da0ac72cc078f2ffffffff02f0c9c467000000" \
+"001976a914d9d78e26df4e4601cf9b26d09c7b280ee764469f88ac80c4600f00" \
+"0000001976a9141ee32412020a324b93b1a1acfdfff6ab9ca8fac288ac000000" \
+"00"
+
+#define VIEW_TX_HASH \
+"bf7c3f5a69a78edd81f3eff7e93a37fb2d7da394d48db4d85e7e5353b9b8e270"
+
+#define VIEW_WITNESS_TX \
+"01000000000101db6b1b20aa0fd7b23880be2ecbd4a98130974cf4748fb66092ac4d3c" \
+"eb1a5477010000001716001479091972186c449eb1ded22b78e40d009bdf0089feffff" \
+"ff02b8b4eb0b000000001976a914a457b684d7f0d539a46a45bbc043f35b59d0d96388" \
+"ac0008af2f000000001976a914fd270b1ee6abcaea97fea7ad0402e8bd8ad6d77c88ac" \
+"02473044022047ac8e878352d3ebbde1c94ce3a10d057c24175747116f8288e5d794d1" \
+"2d482f0220217f36a485cae903c713331d877c1f64677e3622ad4010726870540656fe" \
+"9dcb012103ad1d8e89212f0b92c74d23bb710c00662ad1470198ac48c43f7d6f93a2a2" \
+"687392040000"
+
+// Test helper.
+static void require_equivalent(const chain::transaction_view& view,
+    const chain::transaction& tx)
+{
+    BOOST_REQUIRE(view.is_valid());
+    BOOST_REQUIRE_EQUAL(view.is_segregated(), tx.is_segregated());
+    BOOST_REQUIRE_EQUAL(view.version(), tx.version());
+    BOOST_REQUIRE_EQUAL(view.locktime(), tx.locktime());
+    BOOST_REQUIRE_EQUAL(view.serialized_size(), tx.serialized_size(true, true));
+    BOOST_REQUIRE(view.hash() == tx.hash());
+    BOOST_REQUIRE(view.hash(true) == tx.hash(true));
+    BOOST_REQUIRE_EQUAL(view.inputs(), tx.inputs().size());
+    BOOST_REQUIRE_EQUAL(view.outputs(), tx.outputs().size());
+
+    for (size_t index = 0; index < view.inputs(); ++index)
+    {
+        const auto& input = tx.inputs()[index];
+        BOOST_REQUIRE(view.previous_output(index) == input.previous_output());
+        BOOST_REQUIRE(view.input_script(index) == input.script());
+        BOOST_REQUIRE_EQUAL(view.sequence(index), input.sequence());
+    }
+
+    for (size_t index = 0; index < view.outputs(); ++index)
+    {
+        const auto& output = tx.outputs()[index];
+        BOOST_REQUIRE_EQUAL(view.value(index), output.value());
+        BOOST_REQUIRE(view.output_script(index) == output.script());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__constructor__default__invalid)
+{
+    const chain::transaction_view instance;
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__from_data__legacy__equivalent)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, VIEW_TX));
+    chain::transaction_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    require_equivalent(instance, chain::transaction::factory(data, true, true));
+    BOOST_REQUIRE(instance.hash() == hash_literal(VIEW_TX_HASH));
+    BOOST_REQUIRE(!instance.is_coinbase());
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__from_data__segregated__equivalent)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, VIEW_WITNESS_TX));
+    chain::transaction_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    BOOST_REQUIRE(instance.is_segregated());
+    BOOST_REQUIRE(instance.hash() != instance.hash(true));
+    require_equivalent(instance, chain::transaction::factory(data, true, true));
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__from_data__trailing_bytes__excluded)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, VIEW_WITNESS_TX));
+    const auto size = data.size();
+    data.push_back(0x42);
+    chain::transaction_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), size);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__from_data__insufficient_bytes__failure)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, VIEW_WITNESS_TX));
+    data.pop_back();
+    chain::transaction_view instance;
+    BOOST_REQUIRE(!instance.from_data(data));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__to_transaction__segregated__equals_factory)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, VIEW_WITNESS_TX));
+    chain::transaction_view instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    const auto expected = chain::transaction::factory(data, true, true);
+    BOOST_REQUIRE(instance.to_transaction() == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
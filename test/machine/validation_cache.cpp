@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(validation_cache_tests)
+
+static const data_chunk value1{ 0x01, 0x02, 0x03 };
+static const data_chunk value2{ 0x04, 0x05 };
+
+BOOST_AUTO_TEST_CASE(validation_cache__construct__default__disabled)
+{
+    validation_cache instance;
+    BOOST_REQUIRE(!instance.enabled());
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(validation_cache__key__same_instance__deterministic)
+{
+    validation_cache instance(10);
+    BOOST_REQUIRE(instance.key({ value1, value2 }) == instance.key({ value1, value2 }));
+    BOOST_REQUIRE(instance.key({ value1, value2 }) != instance.key({ value2, value1 }));
+}
+
+BOOST_AUTO_TEST_CASE(validation_cache__key__distinct_instances__salted)
+{
+    validation_cache instance1(10);
+    validation_cache instance2(10);
+    BOOST_REQUIRE(instance1.key({ value1 }) != instance2.key({ value1 }));
+}
+
+BOOST_AUTO_TEST_CASE(validation_cache__contains__disabled__false_uncounted)
+{
+    validation_cache instance;
+    const auto key = instance.key({ value1 });
+    instance.insert(key);
+    BOOST_REQUIRE(!instance.contains(key));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(validation_cache__contains__inserted__hit)
+{
+    validation_cache instance(10);
+    const auto key1 = instance.key({ value1 });
+    const auto key2 = instance.key({ value2 });
+    BOOST_REQUIRE(!instance.contains(key1));
+    instance.insert(key1);
+    BOOST_REQUIRE(instance.contains(key1));
+    BOOST_REQUIRE(!instance.contains(key2));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(validation_cache__insert__beyond_capacity__bounded)
+{
+    // A capacity of one is one entry per shard.
+    validation_cache instance(1);
+    hash_list keys;
+
+    for (uint8_t value = 0; value < 100; ++value)
+    {
+        keys.push_back(instance.key({ data_chunk{ value } }));
+        instance.insert(keys.back());
+    }
+
+    BOOST_REQUIRE_LE(instance.size(), 16u);
+    BOOST_REQUIRE(instance.contains(keys.back()));
+}
+
+BOOST_AUTO_TEST_CASE(validation_cache__resize__populated__cleared)
+{
+    validation_cache instance(10);
+    const auto key = instance.key({ value1 });
+    instance.insert(key);
+    BOOST_REQUIRE(instance.contains(key));
+
+    instance.resize(20);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 20u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 0u);
+    BOOST_REQUIRE(!instance.contains(key));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -131,6 +131,83 @@ BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signature__negative__test)
     BOOST_REQUIRE(!verify_signature(point, sighash, signature));
 }
 
+// Jobs refer to their points, which must outlive them.
+static const ec_compressed point2 = base16_literal(COMPRESSED2);
+static const data_chunk invalid_point{ 0x42 };
+
+// Test helper.
+static ec_compressed make_point1()
+{
+    ec_compressed point1;
+    const ec_secret secret1 = base16_literal(SECRET1);
+    BOOST_REQUIRE(secret_to_public(point1, secret1));
+    return point1;
+}
+
+// Test helper.
+static verify_job::list make_jobs(const ec_compressed& point1)
+{
+    ec_signature signature;
+    der_signature distinguished;
+    BOOST_REQUIRE(decode_base16(distinguished, SIGNATURE2));
+    BOOST_REQUIRE(parse_signature(signature, distinguished, false));
+
+    ec_signature signature1;
+    const auto hash1 = bitcoin_hash(data_chunk{ 'd', 'a', 't', 'a' });
+    const ec_secret secret1 = base16_literal(SECRET1);
+    BOOST_REQUIRE(sign(signature1, secret1, hash1));
+
+    return
+    {
+        { point2, hash_literal(SIGHASH2), signature, 0, false },
+        { point1, hash1, signature1, 1, false },
+        { point2, hash_literal(SIGHASH2), signature, 2, false },
+        { point1, hash1, signature1, 3, false }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signatures__all_valid__true)
+{
+    const auto point1 = make_point1();
+    auto jobs = make_jobs(point1);
+    BOOST_REQUIRE(verify_signatures(jobs));
+
+    for (const auto& job: jobs)
+        BOOST_REQUIRE(job.valid);
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signatures__one_invalid__false_tagged)
+{
+    const auto point1 = make_point1();
+    auto jobs = make_jobs(point1);
+    jobs[2].signature[10] = 110;
+    jobs[3].point = invalid_point;
+    BOOST_REQUIRE(!verify_signatures(jobs));
+    BOOST_REQUIRE(jobs[0].valid);
+    BOOST_REQUIRE(jobs[1].valid);
+    BOOST_REQUIRE(!jobs[2].valid);
+    BOOST_REQUIRE(!jobs[3].valid);
+    BOOST_REQUIRE_EQUAL(jobs[2].tag, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signatures__threadpool__expected)
+{
+    threadpool pool(2);
+    const auto point1 = make_point1();
+    auto jobs = make_jobs(point1);
+    BOOST_REQUIRE(verify_signatures(jobs, pool));
+
+    jobs[1].hash[0] = 0;
+    BOOST_REQUIRE(!verify_signatures(jobs, pool));
+    BOOST_REQUIRE(jobs[0].valid);
+    BOOST_REQUIRE(!jobs[1].valid);
+    BOOST_REQUIRE(jobs[2].valid);
+    BOOST_REQUIRE(jobs[3].valid);
+
+    pool.shutdown();
+    pool.join();
+}
+
 BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add__positive__test)
 {
     ec_secret secret1{ { 1, 2, 3 } };
@@ -158,6 +235,38 @@ BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add__negative__test)
     BOOST_REQUIRE(!ec_add(public1, secret2));
 }
 
+BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add__points__matches_single)
+{
+    const ec_secret secret{ { 1, 2, 3 } };
+    const secret_list scalars{ { { 3, 2, 1 } }, { { 4, 5, 6 } }, { { 7 } } };
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+
+    point_list sums;
+    BOOST_REQUIRE(ec_add(sums, point, scalars));
+    BOOST_REQUIRE_EQUAL(sums.size(), scalars.size());
+
+    for (size_t index = 0; index < scalars.size(); ++index)
+    {
+        auto expected = point;
+        BOOST_REQUIRE(ec_add(expected, scalars[index]));
+        BOOST_REQUIRE(sums[index] == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add__points_infinity__false)
+{
+    // = n - 1
+    const ec_secret secret = base16_literal("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140");
+    ec_secret one{ { 0 } };
+    one[31] = 1;
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+
+    point_list sums;
+    BOOST_REQUIRE(!ec_add(sums, point, { one }));
+}
+
 BOOST_AUTO_TEST_CASE(elliptic_curve__ec_multiply_test)
 {
     ec_secret secret1{{0}};
@@ -19,6 +19,11 @@
 #include "hash.hpp"
 
 #include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
 #include <bitcoin/bitcoin.hpp>
 
 using namespace bc;
@@ -58,6 +63,103 @@ BOOST_AUTO_TEST_CASE(sha256_hash_test)
     BOOST_REQUIRE_EQUAL(encode_base16(hash), "3a6eb0790f39ac87c94f3856b2dd2c5d110e6811602261a9a923d3bb23adc8b7");
 }
 
+BOOST_AUTO_TEST_CASE(sha256_hash__multiple_blocks__expected)
+{
+    const std::string text("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+    const auto hash = sha256_hash(data_chunk(text.begin(), text.end()));
+    BOOST_REQUIRE_EQUAL(encode_base16(hash), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+BOOST_AUTO_TEST_CASE(sha256_hash__million_a__expected)
+{
+    const data_chunk chunk(1000000, 'a');
+    const auto hash = sha256_hash(chunk);
+    BOOST_REQUIRE_EQUAL(encode_base16(hash), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash__single_block__expected)
+{
+    data_chunk block(64);
+
+    for (size_t index = 0; index < block.size(); ++index)
+        block[index] = static_cast<uint8_t>(index);
+
+    BOOST_REQUIRE_EQUAL(encode_hash(bitcoin_hash(block)), encode_hash(sha256_hash(sha256_hash(block))));
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_blocks__empty__empty)
+{
+    BOOST_REQUIRE(bitcoin_hash_blocks(data_chunk{}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_blocks__partial_block__not_hashed)
+{
+    BOOST_REQUIRE_EQUAL(bitcoin_hash_blocks(data_chunk(64 + 63, 0x42)).size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_blocks__all_lane_widths__matches_bitcoin_hash)
+{
+    // 23 blocks covers each of the 8 way, 4 way and single block engines.
+    const size_t count = 23;
+    data_chunk blocks(count * 64);
+
+    for (size_t index = 0; index < blocks.size(); ++index)
+        blocks[index] = static_cast<uint8_t>(index * 7 + index / 64);
+
+    const auto hashes = bitcoin_hash_blocks(blocks);
+    BOOST_REQUIRE_EQUAL(hashes.size(), count);
+
+    for (size_t block = 0; block < count; ++block)
+    {
+        const data_chunk chunk(blocks.begin() + block * 64, blocks.begin() + (block + 1) * 64);
+        BOOST_REQUIRE_EQUAL(encode_hash(hashes[block]), encode_hash(sha256_hash(sha256_hash(chunk))));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_blocks__generic_engine__matches_bitcoin_hash)
+{
+    const data_chunk blocks(3 * 64, 0x42);
+    hash_list hashes;
+    BOOST_REQUIRE(bitcoin_hash_blocks(hashes, blocks, "generic"));
+    BOOST_REQUIRE_EQUAL(hashes.size(), 3u);
+    BOOST_REQUIRE_EQUAL(encode_hash(hashes.back()), encode_hash(sha256_hash(sha256_hash(data_chunk(64, 0x42)))));
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_blocks__unknown_engine__false)
+{
+    hash_list hashes;
+    BOOST_REQUIRE(!bitcoin_hash_blocks(hashes, data_chunk(64, 0x42), "sha-3"));
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_blocks__supported_engines__match_generic)
+{
+    // 23 blocks covers the lanes of each engine and its single block tail.
+    const size_t count = 23;
+    data_chunk blocks(count * 64);
+
+    for (size_t index = 0; index < blocks.size(); ++index)
+        blocks[index] = static_cast<uint8_t>(index * 7 + index / 64);
+
+    hash_list expected;
+    BOOST_REQUIRE(bitcoin_hash_blocks(expected, blocks, "generic"));
+
+    // An engine that is not supported by this cpu is not tested.
+    for (const auto engine: { "sha-ni", "sse4.1", "avx2" })
+    {
+        hash_list hashes;
+        if (bitcoin_hash_blocks(hashes, blocks, engine))
+        {
+            BOOST_TEST_MESSAGE(engine);
+            BOOST_REQUIRE(hashes == expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha256_engines__always__not_empty)
+{
+    BOOST_REQUIRE(!sha256_engines().empty());
+}
+
 BOOST_AUTO_TEST_CASE(sha512_hash_test)
 {
     const data_chunk chunk{ 'd', 'a', 't', 'a' };
@@ -90,6 +192,56 @@ BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch__vectors__expected)
+{
+    const auto& first = pkcs5_pbkdf2_hmac_sha512_tests[2];
+    const auto& second = pkcs5_pbkdf2_hmac_sha512_tests[3];
+    BOOST_REQUIRE_EQUAL(first.iterations, second.iterations);
+
+    const auto hashes = pkcs5_pbkdf2_hmac_sha512(
+        { to_chunk(first.passphrase), to_chunk(second.passphrase) },
+        { to_chunk(first.salt), to_chunk(second.salt) }, first.iterations);
+
+    BOOST_REQUIRE_EQUAL(hashes.size(), 2u);
+    BOOST_REQUIRE_EQUAL(encode_base16(hashes[0]), first.result);
+    BOOST_REQUIRE_EQUAL(encode_base16(hashes[1]), second.result);
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch__partial_lanes__matches_single)
+{
+    static const size_t count = 9;
+    static const size_t iterations = 2048;
+    data_stack passphrases;
+    data_stack salts;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        passphrases.push_back(data_chunk(index * 17, 'p'));
+        salts.push_back(to_chunk("mnemonic" + std::to_string(index)));
+    }
+
+    const auto hashes = pkcs5_pbkdf2_hmac_sha512(passphrases, salts,
+        iterations);
+
+    BOOST_REQUIRE_EQUAL(hashes.size(), count);
+
+    for (size_t index = 0; index < count; ++index)
+        BOOST_REQUIRE(hashes[index] == pkcs5_pbkdf2_hmac_sha512(
+            passphrases[index], salts[index], iterations));
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch__empty__empty)
+{
+    BOOST_REQUIRE(pkcs5_pbkdf2_hmac_sha512(data_stack{}, data_stack{},
+        2048).empty());
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch__mismatched__throws)
+{
+    BOOST_REQUIRE_THROW(pkcs5_pbkdf2_hmac_sha512(data_stack{ {} },
+        data_stack{}, 2048), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(scrypt_hash_test)
 {
     for (const auto& result: scrypt_hash_tests)
@@ -100,4 +252,77 @@ BOOST_AUTO_TEST_CASE(scrypt_hash_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(scrypt_hash__unaligned_size__matches_scrypt)
+{
+    const data_chunk data{ 'd', 'a', 't', 'a' };
+    const auto expected = scrypt<hash_size>(data, data, 1024u, 1u, 1u);
+    BOOST_REQUIRE_EQUAL(encode_base16(scrypt_hash(data)), encode_base16(expected));
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_hash_blocks__odd_count__expected)
+{
+    data_chunk blocks;
+
+    for (const auto& result: scrypt_hash_tests)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        extend_data(blocks, data);
+    }
+
+    // A trailing partial block is not hashed.
+    blocks.push_back(0x42);
+
+    const auto hashes = scrypt_hash_blocks(blocks, 80);
+    BOOST_REQUIRE_EQUAL(hashes.size(), scrypt_hash_tests.size());
+
+    for (size_t index = 0; index < hashes.size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(hashes[index]), scrypt_hash_tests[index].result);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_hash_blocks__zero_size__empty)
+{
+    BOOST_REQUIRE(scrypt_hash_blocks(data_chunk(80, 0x42), 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_engines__always__not_empty)
+{
+    BOOST_REQUIRE(!scrypt_engines().empty());
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__equal_digests__equal)
+{
+    const auto hash = sha256_hash(to_chunk("libbitcoin"));
+    const auto copy = hash;
+    BOOST_REQUIRE_EQUAL(salted_hash(hash), salted_hash(copy));
+    BOOST_REQUIRE_EQUAL(std::hash<hash_digest>()(hash), salted_hash(copy));
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__short_hash__std_hash_matches)
+{
+    const auto hash = ripemd160_hash(to_chunk("libbitcoin"));
+    BOOST_REQUIRE_EQUAL(std::hash<short_hash>()(hash), salted_hash(hash));
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__distinct_indexes__differ)
+{
+    BOOST_REQUIRE(salted_hash(null_hash, 0) != salted_hash(null_hash, 1));
+    BOOST_REQUIRE(salted_hash(null_hash) != salted_hash(null_hash, 1));
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__unordered_set__finds_each_duplicate)
+{
+    static const size_t count = 100;
+    std::unordered_set<hash_digest> set(count);
+    size_t duplicates = 0;
+
+    for (size_t index = 0; index < 2 * count; ++index)
+    {
+        const auto value = to_little_endian(index % count);
+        duplicates += set.insert(sha256_hash(to_chunk(value))).second ? 0 : 1;
+    }
+
+    BOOST_REQUIRE_EQUAL(duplicates, count);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
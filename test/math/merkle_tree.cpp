@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(merkle_tree_tests)
+
+// Block 100000 transaction hashes and merkle root.
+#define MERKLE_TX0 "8c14f0db3df150123e6f3dbbf30f8b955a8249b62ac1d1ff16284aefa3d06d87"
+#define MERKLE_TX1 "fff2525b8931402dd09222c50775608f75787bd2b87e56995a7bdd30f79702c4"
+#define MERKLE_TX2 "6359f0868171b1d194cbee1af2f16ea598ae8fad666d9b012c8ed2b79a236ec4"
+#define MERKLE_TX3 "e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d"
+#define MERKLE_ROOT "f3e94742aca4b5ef85488dc37c06c3282295ffec960994b2c0d5ac2a25a95766"
+
+// Test helper, the unbatched pairwise reduction.
+static hash_digest pairwise_root(hash_list merkle)
+{
+    if (merkle.empty())
+        return null_hash;
+
+    while (merkle.size() > 1)
+    {
+        if (merkle.size() % 2 != 0)
+            merkle.push_back(merkle.back());
+
+        hash_list update;
+        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
+            update.push_back(bitcoin_hash(build_chunk({ it[0], it[1] })));
+
+        merkle = update;
+    }
+
+    return merkle.front();
+}
+
+// Test helper.
+static hash_list make_leaves(size_t count)
+{
+    hash_list leaves;
+
+    for (size_t leaf = 0; leaf < count; ++leaf)
+        leaves.push_back(sha256_hash(to_little_endian(leaf)));
+
+    return leaves;
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__constructor__default__empty)
+{
+    const merkle_tree instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.height(), 0u);
+    BOOST_REQUIRE(instance.root() == null_hash);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__reduce__empty__null_hash)
+{
+    BOOST_REQUIRE(merkle_tree::reduce({}) == null_hash);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__root__single__leaf)
+{
+    const auto leaf = hash_literal(MERKLE_TX0);
+    const merkle_tree instance(hash_list{ leaf });
+    BOOST_REQUIRE_EQUAL(instance.height(), 1u);
+    BOOST_REQUIRE(instance.root() == leaf);
+    BOOST_REQUIRE(instance.branch(0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__root__block_100000__expected)
+{
+    const hash_list leaves
+    {
+        hash_literal(MERKLE_TX0),
+        hash_literal(MERKLE_TX1),
+        hash_literal(MERKLE_TX2),
+        hash_literal(MERKLE_TX3)
+    };
+
+    const merkle_tree instance(leaves);
+    BOOST_REQUIRE_EQUAL(instance.size(), 4u);
+    BOOST_REQUIRE_EQUAL(instance.height(), 3u);
+    BOOST_REQUIRE(instance.root() == hash_literal(MERKLE_ROOT));
+    BOOST_REQUIRE(merkle_tree::reduce(hash_list(leaves)) == hash_literal(MERKLE_ROOT));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__root__all_sizes__matches_pairwise)
+{
+    // Covers odd levels and every combination of kernel lane counts.
+    for (size_t count = 1; count <= 70; ++count)
+    {
+        const auto leaves = make_leaves(count);
+        const auto expected = pairwise_root(leaves);
+        BOOST_REQUIRE(merkle_tree(leaves).root() == expected);
+        BOOST_REQUIRE(merkle_tree::reduce(hash_list(leaves)) == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__tree__odd_level__not_duplicated)
+{
+    const merkle_tree instance(make_leaves(5));
+    BOOST_REQUIRE_EQUAL(instance.height(), 4u);
+    BOOST_REQUIRE_EQUAL(instance.tree()[0].size(), 5u);
+    BOOST_REQUIRE_EQUAL(instance.tree()[1].size(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.tree()[2].size(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.tree()[3].size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__branch__all_leaves__proves_root)
+{
+    const auto leaves = make_leaves(13);
+    const merkle_tree instance(leaves);
+
+    for (size_t index = 0; index < leaves.size(); ++index)
+    {
+        const auto branch = instance.branch(index);
+        BOOST_REQUIRE_EQUAL(branch.size(), instance.height() - 1u);
+        BOOST_REQUIRE(merkle_tree::branch_root(leaves[index], branch, index) == instance.root());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__branch__out_of_range__empty)
+{
+    const merkle_tree instance(make_leaves(3));
+    BOOST_REQUIRE(instance.branch(3).empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__partial__match_count_mismatch__false)
+{
+    hash_list hashes;
+    data_chunk flags;
+    const merkle_tree instance(make_leaves(3));
+    BOOST_REQUIRE(!instance.partial(hashes, flags, { true, false }));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__partial__no_matches__root_only)
+{
+    hash_list hashes;
+    data_chunk flags;
+    const merkle_tree instance(make_leaves(7));
+    BOOST_REQUIRE(instance.partial(hashes, flags, std::vector<bool>(7, false)));
+    BOOST_REQUIRE_EQUAL(hashes.size(), 1u);
+    BOOST_REQUIRE(hashes.front() == instance.root());
+    BOOST_REQUIRE(flags == data_chunk{ 0x00 });
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__partial__odd_last_match__expected)
+{
+    hash_list hashes;
+    data_chunk flags;
+    const auto leaves = make_leaves(3);
+    const merkle_tree instance(leaves);
+    BOOST_REQUIRE(instance.partial(hashes, flags, { false, false, true }));
+
+    // Bits: root (1), left subtree (0), right subtree (1), leaf two (1).
+    BOOST_REQUIRE(flags == data_chunk{ 0x0d });
+    BOOST_REQUIRE_EQUAL(hashes.size(), 2u);
+    BOOST_REQUIRE(hashes[0] == instance.tree()[1][0]);
+    BOOST_REQUIRE(hashes[1] == leaves[2]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
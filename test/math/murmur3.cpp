@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(murmur3_tests)
+
+// Test helper.
+static uint32_t murmur3_base16(const std::string& data, uint32_t seed)
+{
+    data_chunk chunk;
+    BOOST_REQUIRE(decode_base16(chunk, data));
+    return murmur3(chunk, seed);
+}
+
+BOOST_AUTO_TEST_CASE(murmur3__murmur3__empty__expected)
+{
+    BOOST_REQUIRE_EQUAL(murmur3_base16("", 0x00000000), 0x00000000u);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("", 0xfba4c795), 0x6a396f08u);
+}
+
+BOOST_AUTO_TEST_CASE(murmur3__murmur3__partial_words__expected)
+{
+    BOOST_REQUIRE_EQUAL(murmur3_base16("00", 0x00000000), 0x514e28b7u);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("00", 0xfba4c795), 0xea3f0b17u);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("ff", 0x00000000), 0xfd6cf10du);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("0011", 0x00000000), 0x16c6b7abu);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("001122", 0x00000000), 0x8eb51c3du);
+}
+
+BOOST_AUTO_TEST_CASE(murmur3__murmur3__multiple_words__expected)
+{
+    BOOST_REQUIRE_EQUAL(murmur3_base16("00112233", 0x00000000), 0xb4471bf8u);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("0011223344", 0x00000000), 0xe2301fa8u);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("001122334455", 0x00000000), 0xfc2e4a15u);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("00112233445566", 0x00000000), 0xb074502cu);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("0011223344556677", 0x00000000), 0x8034d2a0u);
+    BOOST_REQUIRE_EQUAL(murmur3_base16("001122334455667788", 0x00000000), 0xb4698defu);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(siphash_tests)
+
+// Reference key (bytes 0x00..0x0f) and vectors of SipHash-2-4.
+static const half_hash key
+{
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    }
+};
+
+// Test helper, the message of bytes 0x00..(size - 1).
+static data_chunk counting(size_t size)
+{
+    data_chunk message(size);
+
+    for (size_t index = 0; index < size; ++index)
+        message[index] = static_cast<uint8_t>(index);
+
+    return message;
+}
+
+BOOST_AUTO_TEST_CASE(siphash__to_siphash_key__reference__little_endian_words)
+{
+    const auto instance = to_siphash_key(key);
+    BOOST_REQUIRE_EQUAL(std::get<0>(instance), 0x0706050403020100u);
+    BOOST_REQUIRE_EQUAL(std::get<1>(instance), 0x0f0e0d0c0b0a0908u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__empty__reference)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, data_chunk{}), 0x726fdb47dd0e0e31u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__partial_word__reference)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, counting(15)), 0xa129ca6149be45e5u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__hash_digest__reference)
+{
+    hash_digest hash;
+    const auto message = counting(hash_size);
+    std::copy(message.begin(), message.end(), hash.begin());
+    const auto expected = 0x7127512f72f27cceu;
+    BOOST_REQUIRE_EQUAL(siphash(to_siphash_key(key), hash), expected);
+    BOOST_REQUIRE_EQUAL(siphash(key, message), expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
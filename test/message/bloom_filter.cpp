@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(bloom_filter_tests)
+
+static const uint8_t update_all = static_cast<uint8_t>(bloom_filter::update::all);
+
+// Test helper.
+static data_chunk base16(const std::string& text)
+{
+    data_chunk out;
+    BOOST_REQUIRE(decode_base16(out, text));
+    return out;
+}
+
+// Test helper, a transaction paying to the given output script data.
+static chain::transaction make_transaction(
+    const chain::output_point& previous, const data_chunk& push)
+{
+    const chain::script script(machine::operation::list
+    {
+        machine::operation(small_chunk(push)),
+        machine::operation(machine::opcode::checksig)
+    });
+
+    return { 1, 0, { { previous, {}, 0xffffffff } }, { { 42, script } } };
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__bip37_vectors__expected_filter)
+{
+    bloom_filter instance(data_chunk(3, 0x00), 5, 0, update_all);
+    instance.insert(base16("99108ad8ed9bb6274d3980bab5a85c048f0950c8"));
+    instance.insert(base16("b5a2c786d9ef4658287ced5914b37a1b4aa32eee"));
+    instance.insert(base16("b9300670b4c5366e95b2699e8b18bc75e5f729c5"));
+    BOOST_REQUIRE(instance.filter() == base16("614e9b"));
+    BOOST_REQUIRE(instance.contains(base16("99108ad8ed9bb6274d3980bab5a85c048f0950c8")));
+    BOOST_REQUIRE(!instance.contains(base16("19108ad8ed9bb6274d3980bab5a85c048f0950c8")));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__tweaked__expected_filter)
+{
+    bloom_filter instance(data_chunk(3, 0x00), 5, 2147483649, update_all);
+    instance.insert(base16("99108ad8ed9bb6274d3980bab5a85c048f0950c8"));
+    instance.insert(base16("b5a2c786d9ef4658287ced5914b37a1b4aa32eee"));
+    instance.insert(base16("b9300670b4c5366e95b2699e8b18bc75e5f729c5"));
+    BOOST_REQUIRE(instance.filter() == base16("ce4299"));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_valid__oversized__false)
+{
+    const filter_load oversized(data_chunk(bloom_filter::max_filter_size + 1),
+        1, 0, 0);
+    const filter_load excess_functions(data_chunk(1),
+        bloom_filter::max_hash_functions + 1, 0, 0);
+    BOOST_REQUIRE(bloom_filter(filter_load(data_chunk(1), 1, 0, 0)).is_valid());
+    BOOST_REQUIRE(!bloom_filter(oversized).is_valid());
+    BOOST_REQUIRE(!bloom_filter(excess_functions).is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__empty_and_full__short_circuit)
+{
+    const auto tx = make_transaction({ null_hash, 0 }, data_chunk(20, 0x42));
+    bloom_filter empty(data_chunk(8, 0x00), 5, 0, update_all);
+    bloom_filter full(data_chunk(8, 0xff), 5, 0, update_all);
+    BOOST_REQUIRE(!empty.match(tx));
+    BOOST_REQUIRE(full.match(tx));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__zero_length__matches_everything)
+{
+    const auto tx = make_transaction({ null_hash, 0 }, data_chunk(20, 0x42));
+    bloom_filter instance(data_chunk{}, 5, 0, update_all);
+    instance.insert(data_chunk(20, 0x24));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.filter().empty());
+    BOOST_REQUIRE(instance.contains(data_chunk(20, 0x24)));
+    BOOST_REQUIRE(instance.match(tx));
+    BOOST_REQUIRE(bloom_filter().match(tx));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__output_data_update_all__spend_matched)
+{
+    const data_chunk key_hash(20, 0x42);
+    const auto funding = make_transaction({ null_hash, 0 }, key_hash);
+    const auto spending = make_transaction({ funding.hash(), 0 }, data_chunk(20, 0x24));
+    const auto unrelated = make_transaction({ null_hash, 1 }, data_chunk(20, 0x24));
+
+    bloom_filter instance(data_chunk(100, 0x00), 10, 0, update_all);
+    instance.insert(key_hash);
+    BOOST_REQUIRE(!instance.match(unrelated));
+    BOOST_REQUIRE(instance.match(funding));
+    BOOST_REQUIRE(instance.contains(chain::point{ funding.hash(), 0 }));
+    BOOST_REQUIRE(instance.match(spending));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__update_none__spend_not_matched)
+{
+    const data_chunk key_hash(20, 0x42);
+    const auto funding = make_transaction({ null_hash, 0 }, key_hash);
+    const auto spending = make_transaction({ funding.hash(), 0 }, data_chunk(20, 0x24));
+
+    bloom_filter instance(data_chunk(100, 0x00), 10, 0, 0);
+    instance.insert(key_hash);
+    BOOST_REQUIRE(instance.match(funding));
+    BOOST_REQUIRE(!instance.match(spending));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__to_merkle_block__one_match__partial_tree)
+{
+    const auto first = make_transaction({ null_hash, 0 }, data_chunk(20, 0x01));
+    const auto second = make_transaction({ null_hash, 1 }, data_chunk(20, 0x02));
+    const auto third = make_transaction({ null_hash, 2 }, data_chunk(20, 0x03));
+    const chain::block block(chain::header{}, { first, second, third });
+
+    bloom_filter instance(data_chunk(100, 0x00), 10, 0, 0);
+    instance.insert(second.hash());
+
+    std::vector<bool> matches;
+    const auto result = instance.to_merkle_block(block, matches);
+    BOOST_REQUIRE(matches == (std::vector<bool>{ false, true, false }));
+
+    const merkle_tree tree({ first.hash(), second.hash(), third.hash() });
+    const merkle_block expected(block.header(), tree, matches);
+    BOOST_REQUIRE(result == expected);
+    BOOST_REQUIRE_EQUAL(result.total_transactions(), 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(compact_block_reconstructor_tests)
+
+static const uint64_t nonce = 0x0102030405060708;
+
+// Test helper, distinct transactions by locktime.
+static chain::transaction::list make_transactions(size_t count,
+    uint32_t first=0)
+{
+    chain::transaction::list transactions;
+
+    for (size_t index = 0; index < count; ++index)
+        transactions.emplace_back(1, first + index, chain::input::list{},
+            chain::output::list{ { index, {} } });
+
+    return transactions;
+}
+
+static chain::header make_header(const chain::transaction::list& transactions)
+{
+    const chain::block block({ 1, null_hash, null_hash, 42, 0x207fffff, 7 },
+        transactions);
+    return { 1, null_hash, block.generate_merkle_root(), 42, 0x207fffff, 7 };
+}
+
+// Test helper, the serialized (little-endian) short id of a transaction.
+static compact_block::short_id encode(const compact_block_reconstructor& keyed,
+    const chain::transaction& transaction)
+{
+    auto id = keyed.short_id(transaction.hash());
+    compact_block::short_id value;
+
+    for (auto& byte: value)
+    {
+        byte = static_cast<uint8_t>(id);
+        id >>= 8;
+    }
+
+    return value;
+}
+
+// Test helper, encodes short ids for all but the prefilled first transaction.
+static compact_block make_compact(const chain::transaction::list& transactions)
+{
+    const auto header = make_header(transactions);
+    const compact_block_reconstructor keyed({ header, nonce, {}, {} });
+    compact_block::short_id_list ids;
+
+    for (size_t index = 1; index < transactions.size(); ++index)
+        ids.push_back(encode(keyed, transactions[index]));
+
+    return { header, nonce, ids, { { 0, transactions.front() } } };
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__match__all_candidates__complete)
+{
+    const auto transactions = make_transactions(5);
+    compact_block_reconstructor instance(make_compact(transactions));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.is_complete());
+
+    // Unrelated candidates and duplicates are not placed.
+    auto candidates = make_transactions(100, 1000);
+    candidates.insert(candidates.end(), transactions.rbegin(),
+        transactions.rend());
+
+    BOOST_REQUIRE_EQUAL(instance.match(candidates), 4u);
+    BOOST_REQUIRE(instance.is_complete());
+    BOOST_REQUIRE(!instance.match(transactions[1]));
+    BOOST_REQUIRE(instance.missing().empty());
+
+    const auto block = instance.to_block();
+    BOOST_REQUIRE(block.transactions() == transactions);
+    BOOST_REQUIRE(block.generate_merkle_root() == block.header().merkle());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__to_request__missing__differential_indexes)
+{
+    const auto transactions = make_transactions(6);
+    const auto compact = make_compact(transactions);
+    compact_block_reconstructor instance(compact);
+    BOOST_REQUIRE(instance.match(transactions[1]));
+    BOOST_REQUIRE(instance.match(transactions[3]));
+    BOOST_REQUIRE(instance.match(transactions[4]));
+    BOOST_REQUIRE(!instance.is_complete());
+    BOOST_REQUIRE(!instance.to_block().is_valid());
+
+    const auto missing = instance.missing();
+    BOOST_REQUIRE(missing == (std::vector<uint64_t>{ 2, 5 }));
+
+    const auto request = instance.to_request();
+    BOOST_REQUIRE(request.block_hash() == compact.header().hash());
+    BOOST_REQUIRE(request.indexes() == (std::vector<uint64_t>{ 2, 2 }));
+
+    const block_transactions response(compact.header().hash(),
+        { transactions[2], transactions[5] });
+    BOOST_REQUIRE(instance.fill(response));
+    BOOST_REQUIRE(instance.is_complete());
+    BOOST_REQUIRE(instance.to_block().transactions() == transactions);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__fill__mismatched_response__false)
+{
+    const auto transactions = make_transactions(3);
+    compact_block_reconstructor instance(make_compact(transactions));
+    const block_transactions wrong_hash(null_hash, { transactions[1],
+        transactions[2] });
+    const block_transactions wrong_count(instance.to_request().block_hash(),
+        { transactions[1] });
+    BOOST_REQUIRE(!instance.fill(wrong_hash));
+    BOOST_REQUIRE(!instance.fill(wrong_count));
+    BOOST_REQUIRE_EQUAL(instance.missing().size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__construct__duplicate_short_ids__invalid)
+{
+    const auto transactions = make_transactions(3);
+    auto compact = make_compact(transactions);
+    compact.short_ids()[1] = compact.short_ids()[0];
+    compact_block_reconstructor instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(!instance.match(transactions[1]));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__construct__prefilled_index_overflow__invalid)
+{
+    const auto transactions = make_transactions(3);
+    auto compact = make_compact(transactions);
+    compact.transactions().front().set_index(3);
+    const compact_block_reconstructor instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__construct__differential_prefilled__placed)
+{
+    const auto transactions = make_transactions(4);
+    const auto header = make_header(transactions);
+    const compact_block_reconstructor keyed({ header, nonce, {}, {} });
+
+    // Absolute indexes 1 and 3 are encoded as 1 and 1.
+    const compact_block compact(header, nonce,
+    {
+        encode(keyed, transactions[0]),
+        encode(keyed, transactions[2])
+    },
+    {
+        { 1, transactions[1] },
+        { 1, transactions[3] }
+    });
+
+    compact_block_reconstructor instance(compact);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.missing() == (std::vector<uint64_t>{ 0, 2 }));
+    BOOST_REQUIRE_EQUAL(instance.match(transactions), 2u);
+    BOOST_REQUIRE(instance.to_block().transactions() == transactions);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(frame_tests)
+
+static const uint32_t magic = 0xd9b4bef9;
+
+// Test helper, a serialized genesis block payload.
+static frame::payload_ptr make_payload()
+{
+    const bc::settings mainnet(config::settings::mainnet);
+    const block instance(chain::block(mainnet.genesis_block));
+    return std::make_shared<const frame::shared_payload>(
+        serialize_payload(version::level::maximum, instance));
+}
+
+BOOST_AUTO_TEST_CASE(frame__to_data__block_payload__equals_serialize)
+{
+    const bc::settings mainnet(config::settings::mainnet);
+    const block instance(chain::block(mainnet.genesis_block));
+    const auto expected = serialize(version::level::maximum, instance, magic);
+    const frame framed(magic, block::command, make_payload());
+    BOOST_REQUIRE_EQUAL(framed.size(), expected.size());
+    BOOST_REQUIRE(framed.to_data() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(frame__constructor__payload__not_copied)
+{
+    const auto payload = make_payload();
+    const frame first(magic, block::command, payload);
+    const frame second(magic + 1, block::command, payload);
+    BOOST_REQUIRE_EQUAL(&first.payload(), &payload->data);
+    BOOST_REQUIRE_EQUAL(&second.payload(), &payload->data);
+    BOOST_REQUIRE(first.heading() != second.heading());
+}
+
+BOOST_AUTO_TEST_CASE(frame__to_buffers__block_payload__heading_then_payload)
+{
+    const auto payload = make_payload();
+    const frame framed(magic, block::command, payload);
+    const auto buffers = framed.to_buffers();
+
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_size(buffers[0]),
+        heading::satoshi_fixed_size());
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_size(buffers[1]),
+        payload->data.size());
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_cast<const uint8_t*>(buffers[1]),
+        payload->data.data());
+
+    const auto head = heading::factory(to_chunk(framed.heading()));
+    BOOST_REQUIRE(head.type() == message_type::block);
+    BOOST_REQUIRE_EQUAL(head.payload_size(), payload->data.size());
+    BOOST_REQUIRE_EQUAL(head.checksum(), bitcoin_checksum(payload->data));
+    BOOST_REQUIRE_EQUAL(head.checksum(), payload->checksum);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -742,4 +742,105 @@ BOOST_AUTO_TEST_CASE(headers__is_sequential__disordered__false)
     BOOST_REQUIRE(!instance.is_sequential());
 }
 
+// Test helper, mainnet headers one and two.
+static header::list get_mainnet_headers()
+{
+    return
+    {
+        header(1u,
+            hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"),
+            hash_literal("0e3e2357e806b6cdb1f70b54c3a3a17b6714ee1f0e68bebb44a74b1efd512098"),
+            1231469665u, 0x1d00ffff, 2573394689u),
+        header(1u,
+            hash_literal("00000000839a8e6886ab5951d76f411475428afc90947ee320161bbf18eb6048"),
+            hash_literal("9b0fc92260312ce44e74ef369f5c66bbb85848f2eddd5a7a1cde251e54ccfdd5"),
+            1231469744u, 0x1d00ffff, 1639830024u)
+    };
+}
+
+// Test helper, mainnet genesis block state.
+static chain::chain_state get_genesis_state(const settings& settings)
+{
+    static const chain::chain_state::checkpoints checkpoints;
+    const chain::block block(settings.genesis_block);
+    const auto& genesis = block.header();
+
+    chain::chain_state::data values;
+    values.height = 0;
+    values.hash = genesis.hash();
+    values.bip9_bit0_hash = null_hash;
+    values.bip9_bit1_hash = null_hash;
+    values.bits.self = genesis.bits();
+    values.version.self = genesis.version();
+    values.timestamp.self = genesis.timestamp();
+    values.timestamp.retarget = genesis.timestamp();
+    return { std::move(values), checkpoints, machine::rule_fork::all_rules, 0,
+        settings };
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__valid_proof_of_work__success)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    const headers instance(get_mainnet_headers());
+    size_t failed;
+    BOOST_REQUIRE_EQUAL(instance.check(failed, settings.timestamp_limit_seconds,
+        settings.proof_of_work_limit, pool), error::success);
+    BOOST_REQUIRE_EQUAL(failed, 2u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__invalid_proof_of_work__lowest_index)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    auto elements = get_mainnet_headers();
+    elements.insert(elements.begin(), elements.back());
+    elements[1].set_nonce(0);
+    elements[2].set_nonce(0);
+    const headers instance(std::move(elements));
+    size_t failed;
+    BOOST_REQUIRE_EQUAL(instance.check(failed, settings.timestamp_limit_seconds,
+        settings.proof_of_work_limit, pool), error::invalid_proof_of_work);
+    BOOST_REQUIRE_EQUAL(failed, 1u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(headers__validate__linked__success_states_populated)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    const auto parent = get_genesis_state(settings);
+    const headers instance(get_mainnet_headers());
+    size_t failed;
+    BOOST_REQUIRE_EQUAL(instance.validate(failed, parent, settings, pool),
+        error::success);
+    BOOST_REQUIRE_EQUAL(failed, 2u);
+
+    const auto state = instance.elements().back().metadata.state;
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE_EQUAL(state->height(), 2u);
+    BOOST_REQUIRE(state->hash() == instance.elements().back().hash());
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(headers__validate__unlinked__orphan_block_index)
+{
+    threadpool pool(2);
+    const settings settings(config::settings::mainnet);
+    const auto parent = get_genesis_state(settings);
+    auto elements = get_mainnet_headers();
+    elements.back() = elements.front();
+    const headers instance(std::move(elements));
+    size_t failed;
+    BOOST_REQUIRE_EQUAL(instance.validate(failed, parent, settings, pool),
+        error::orphan_block);
+    BOOST_REQUIRE_EQUAL(failed, 1u);
+    pool.shutdown();
+    pool.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -137,6 +137,25 @@ BOOST_AUTO_TEST_CASE(merkle_block__constructor_5__always__equals_params)
     BOOST_REQUIRE(flags == instance.flags());
 }
 
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_6__no_matches__root_only)
+{
+    const chain::header header;
+    const merkle_tree tree(hash_list{ null_hash, null_hash, null_hash });
+    const message::merkle_block instance(header, tree, { false, false, false });
+    BOOST_REQUIRE_EQUAL(instance.total_transactions(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.hashes().size(), 1u);
+    BOOST_REQUIRE(instance.hashes().front() == tree.root());
+    BOOST_REQUIRE(instance.flags() == data_chunk{ 0x00 });
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_6__match_count_mismatch__invalid)
+{
+    const chain::header header;
+    const merkle_tree tree(hash_list{ null_hash, null_hash, null_hash });
+    const message::merkle_block instance(header, tree, { true });
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
 BOOST_AUTO_TEST_CASE(from_data_insufficient_data_fails)
 {
     const data_chunk data{ 10 };
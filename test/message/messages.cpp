@@ -22,6 +22,42 @@
 using namespace bc;
 using namespace bc::message;
 
+static const uint32_t versions[]
+{
+    version::level::minimum,
+    version::level::bip31,
+    version::level::bip37,
+    version::level::bip61,
+    version::level::bip133,
+    version::level::bip152
+};
+
+// serialize throws if serialized_size does not match the written size.
+template <typename Message>
+static void require_serialized_size(const Message& instance)
+{
+    for (const auto level: versions)
+    {
+        const auto expected = instance.to_data(level);
+        BOOST_REQUIRE_EQUAL(instance.serialized_size(level), expected.size());
+        BOOST_REQUIRE(serialize_payload(level, instance) == expected);
+        BOOST_REQUIRE_EQUAL(serialize(level, instance, 0).size(),
+            heading::satoshi_fixed_size() + expected.size());
+    }
+}
+
+static const hash_list hashes{ null_hash, { { 0x42 } } };
+
+static const network_address address_value(42, 1, { { 0x01, 0x02 } }, 8333);
+
+static const chain::header header_value(1, null_hash, null_hash, 2, 3, 4);
+
+static chain::transaction transaction_value()
+{
+    const bc::settings mainnet(config::settings::mainnet);
+    return chain::block(mainnet.genesis_block).transactions().front();
+}
+
 BOOST_AUTO_TEST_SUITE(messages_tests)
 
 BOOST_AUTO_TEST_CASE(messages__variable_uint_size__one_byte__expected)
@@ -48,4 +84,67 @@ BOOST_AUTO_TEST_CASE(messages__variable_uint_size__eight_byte__expected)
     BOOST_REQUIRE_EQUAL(variable_uint_size(value), 9u);
 }
 
+BOOST_AUTO_TEST_CASE(messages__serialize__ping__heading_and_payload)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    const ping instance(0x0102030405060708);
+    const auto payload = instance.to_data(ping::version_maximum);
+    const auto result = serialize(ping::version_maximum, instance, magic);
+    BOOST_REQUIRE_EQUAL(result.size(), heading::satoshi_fixed_size() + payload.size());
+
+    const auto head = heading::factory(result);
+    BOOST_REQUIRE(head.type() == message_type::ping);
+    BOOST_REQUIRE_EQUAL(head.magic(), magic);
+    BOOST_REQUIRE_EQUAL(head.payload_size(), payload.size());
+    BOOST_REQUIRE_EQUAL(head.checksum(), bitcoin_checksum(payload));
+    BOOST_REQUIRE(std::equal(payload.begin(), payload.end(),
+        result.begin() + heading::satoshi_fixed_size()));
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize_payload__block__expected)
+{
+    const bc::settings mainnet(config::settings::mainnet);
+    const block instance(chain::block(mainnet.genesis_block));
+    const auto expected = instance.to_data(version::level::maximum);
+    BOOST_REQUIRE(serialize_payload(version::level::maximum, instance) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialized_size__every_message__matches_written_size)
+{
+    const bc::settings mainnet(config::settings::mainnet);
+    const auto tx = transaction_value();
+    const auto type = inventory_vector::type_id::block;
+
+    require_serialized_size(address({ address_value, address_value }));
+    require_serialized_size(alert({ 1, 2, 3 }, { 4, 5 }));
+    require_serialized_size(block(chain::block(mainnet.genesis_block)));
+    require_serialized_size(block_transactions(null_hash, { tx, tx }));
+    require_serialized_size(compact_block(header_value, 42, { { { 1 } } },
+        { prefilled_transaction(0, tx) }));
+    require_serialized_size(fee_filter(1000));
+    require_serialized_size(filter_add({ 1, 2, 3 }));
+    require_serialized_size(filter_clear());
+    require_serialized_size(filter_load({ 1, 2, 3 }, 4, 5, 6));
+    require_serialized_size(get_address());
+    require_serialized_size(get_block_transactions(null_hash, { 1, 2 }));
+    require_serialized_size(get_blocks(hashes, null_hash));
+    require_serialized_size(get_data(hashes, type));
+    require_serialized_size(get_headers(hashes, null_hash));
+    require_serialized_size(headers({ header_value, header_value }));
+    require_serialized_size(inventory(hashes, type));
+    require_serialized_size(memory_pool());
+    require_serialized_size(merkle_block(header_value, 2, hashes, { 1 }));
+    require_serialized_size(not_found(hashes, type));
+    require_serialized_size(ping(42));
+    require_serialized_size(pong(42));
+    require_serialized_size(reject(reject::reason_code::duplicate,
+        block::command, "reason", null_hash));
+    require_serialized_size(send_compact(true, 1));
+    require_serialized_size(send_headers());
+    require_serialized_size(transaction(tx));
+    require_serialized_size(verack());
+    require_serialized_size(version(version::level::maximum, 1, 2,
+        address_value, address_value, 3, "/agent/", 4, true));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
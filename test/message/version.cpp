@@ -1252,4 +1252,19 @@ BOOST_AUTO_TEST_CASE(version__operator_boolean_not_equals__differs__returns_true
     BOOST_REQUIRE(instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(version__serialized_size__bip37_value_below_bip37_version__excludes_relay)
+{
+    const auto lower = message::version::level::bip37 - 1u;
+    message::version instance;
+    instance.set_value(message::version::level::bip37);
+    instance.set_user_agent("my agent");
+    instance.set_relay(true);
+
+    const auto data = instance.to_data(lower);
+    BOOST_REQUIRE_EQUAL(data.size(), instance.serialized_size(lower));
+    BOOST_REQUIRE_EQUAL(data.size() + 1u, instance.serialized_size(version_maximum));
+    BOOST_REQUIRE_EQUAL(message::serialize(lower, instance, 0u).size(),
+        message::heading::satoshi_fixed_size() + data.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(dispatcher_tests)
+
+// Test helper, counts the invocations of each bucket.
+static std::vector<size_t> partition_counts(dispatcher& dispatch,
+    size_t buckets)
+{
+    std::vector<std::atomic<size_t>> counts(buckets);
+
+    for (auto& count: counts)
+        count = 0;
+
+    dispatch.partition(buckets, [&counts](size_t bucket)
+    {
+        ++counts[bucket];
+    });
+
+    return { counts.begin(), counts.end() };
+}
+
+BOOST_AUTO_TEST_CASE(dispatcher__partition__zero_buckets__no_calls)
+{
+    threadpool pool(2);
+    dispatcher dispatch(pool, "test");
+    BOOST_REQUIRE(partition_counts(dispatch, 0).empty());
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(dispatcher__partition__running_pool__each_bucket_once)
+{
+    threadpool pool(4);
+    dispatcher dispatch(pool, "test");
+    const auto counts = partition_counts(dispatch, 16);
+    BOOST_REQUIRE(counts == std::vector<size_t>(16, 1));
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(dispatcher__partition__stopped_pool__each_bucket_once)
+{
+    threadpool pool(2);
+    pool.shutdown();
+    pool.join();
+    dispatcher dispatch(pool, "test");
+    const auto counts = partition_counts(dispatch, 4);
+    BOOST_REQUIRE(counts == std::vector<size_t>(4, 1));
+}
+
+BOOST_AUTO_TEST_CASE(dispatcher__partition__from_only_pool_thread__completes)
+{
+    threadpool pool(1);
+    dispatcher dispatch(pool, "test");
+    std::promise<std::vector<size_t>> result;
+
+    // The only pool thread is the caller, so it must run every bucket.
+    dispatch.concurrent([&]()
+    {
+        result.set_value(partition_counts(dispatch, 3));
+    });
+
+    const auto counts = result.get_future().get();
+    BOOST_REQUIRE(counts == std::vector<size_t>(3, 1));
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(flat_hash_set_tests)
+
+// Test helper, collides every key into one probe sequence.
+struct constant_hash
+{
+    uint64_t operator()(const uint32_t&) const
+    {
+        return 42;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__construct__zero_capacity__empty)
+{
+    const flat_hash_set<hash_digest> instance(0);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(!instance.contains(null_hash));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__distinct__true_and_contained)
+{
+    const std::vector<hash_digest> keys
+    {
+        null_hash,
+        bitcoin_hash(data_chunk{ 42 }),
+        bitcoin_hash(data_chunk{ 24 })
+    };
+
+    flat_hash_set<hash_digest> instance(keys.size());
+
+    for (const auto& key: keys)
+        BOOST_REQUIRE(instance.insert(key));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), keys.size());
+
+    for (const auto& key: keys)
+        BOOST_REQUIRE(instance.contains(key));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__equal_key__false)
+{
+    const auto key = bitcoin_hash(data_chunk{ 42 });
+    const auto copy = key;
+    flat_hash_set<hash_digest> instance(2);
+    BOOST_REQUIRE(instance.insert(key));
+    BOOST_REQUIRE(!instance.insert(copy));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__colliding_hashes__compared_exactly)
+{
+    std::vector<uint32_t> keys(100);
+
+    for (uint32_t index = 0; index < keys.size(); ++index)
+        keys[index] = index;
+
+    flat_hash_set<uint32_t, constant_hash> instance(keys.size());
+
+    for (const auto& key: keys)
+        BOOST_REQUIRE(instance.insert(key));
+
+    const uint32_t repeat = 99;
+    const uint32_t absent = 100;
+    BOOST_REQUIRE(!instance.insert(repeat));
+    BOOST_REQUIRE(!instance.contains(absent));
+    BOOST_REQUIRE_EQUAL(instance.size(), keys.size());
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__beyond_capacity__grows)
+{
+    std::vector<uint32_t> keys(100);
+
+    for (uint32_t index = 0; index < keys.size(); ++index)
+        keys[index] = index;
+
+    flat_hash_set<uint32_t> instance(1);
+
+    for (const auto& key: keys)
+        BOOST_REQUIRE(instance.insert(key));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), keys.size());
+
+    for (const auto& key: keys)
+        BOOST_REQUIRE(instance.contains(key));
+
+    const uint32_t repeat = 0;
+    const uint32_t absent = 100;
+    BOOST_REQUIRE(!instance.insert(repeat));
+    BOOST_REQUIRE(!instance.contains(absent));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__zero_capacity__grows)
+{
+    const auto key = bitcoin_hash(data_chunk{ 42 });
+    flat_hash_set<hash_digest> instance(0);
+    BOOST_REQUIRE(instance.insert(key));
+    BOOST_REQUIRE(instance.contains(key));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__clear__populated__empty_reusable)
+{
+    const auto key = bitcoin_hash(data_chunk{ 42 });
+    flat_hash_set<hash_digest> instance(1);
+    BOOST_REQUIRE(instance.insert(key));
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(!instance.contains(key));
+    BOOST_REQUIRE(instance.insert(key));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__point_set__same_checksum__distinct)
+{
+    const chain::point first{ null_hash, 1 };
+    const chain::point second{ null_hash, 32769 };
+    BOOST_REQUIRE_EQUAL(first.checksum(), second.checksum());
+
+    chain::point_set instance(2);
+    BOOST_REQUIRE(instance.insert(first));
+    BOOST_REQUIRE(instance.insert(second));
+    BOOST_REQUIRE(!instance.insert(chain::point{ null_hash, 1 }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(once_value_tests)
+
+BOOST_AUTO_TEST_CASE(once_value__constructor__default__empty)
+{
+    const once_value<size_t> instance;
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(once_value__constructor__value__published)
+{
+    const once_value<size_t> instance(42);
+    BOOST_REQUIRE(!instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(0); }), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(once_value__get__repeated__computes_once)
+{
+    size_t calls = 0;
+    const once_value<size_t> instance;
+    const auto factory = [&calls]() { return ++calls; };
+
+    BOOST_REQUIRE_EQUAL(instance.get(factory), 1u);
+    BOOST_REQUIRE_EQUAL(instance.get(factory), 1u);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+    BOOST_REQUIRE(!instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(once_value__get__throwing_factory__remains_empty)
+{
+    const once_value<size_t> instance;
+    const auto thrower = []() -> size_t { throw std::runtime_error("fail"); };
+
+    BOOST_REQUIRE_THROW(instance.get(thrower), std::runtime_error);
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(7); }), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(once_value__get__concurrent__computes_once)
+{
+    static const size_t threads = 8;
+    std::atomic<size_t> calls(0);
+    std::atomic<bool> start(false);
+    const once_value<hash_digest> instance;
+    std::vector<hash_digest> results(threads);
+    std::vector<std::thread> workers;
+
+    const auto factory = [&calls]()
+    {
+        ++calls;
+        return bitcoin_hash(to_chunk(std::string("once")));
+    };
+
+    for (size_t index = 0; index < threads; ++index)
+    {
+        workers.emplace_back([&, index]()
+        {
+            while (!start)
+                std::this_thread::yield();
+
+            results[index] = instance.get(factory);
+        });
+    }
+
+    start = true;
+    for (auto& worker: workers)
+        worker.join();
+
+    BOOST_REQUIRE_EQUAL(calls.load(), 1u);
+
+    for (const auto& result: results)
+        BOOST_REQUIRE(result == results.front());
+}
+
+BOOST_AUTO_TEST_CASE(once_value__copy__published__copied)
+{
+    const once_value<size_t> instance(42);
+    const auto copy = instance;
+    BOOST_REQUIRE(!instance.empty());
+    BOOST_REQUIRE(!copy.empty());
+    BOOST_REQUIRE_EQUAL(copy.get([]() { return size_t(0); }), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(once_value__copy__empty__empty)
+{
+    const once_value<size_t> instance;
+    const auto copy = instance;
+    BOOST_REQUIRE(copy.empty());
+}
+
+BOOST_AUTO_TEST_CASE(once_value__move__published__moved_and_source_reset)
+{
+    once_value<data_chunk> instance(data_chunk{ 1, 2, 3 });
+    const auto moved = std::move(instance);
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE(!moved.empty());
+    BOOST_REQUIRE_EQUAL(moved.get([]() { return data_chunk{}; }).size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(once_value__set__empty__published)
+{
+    once_value<size_t> instance;
+    instance.set(42);
+    BOOST_REQUIRE(!instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(0); }), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(once_value__reset__published__empty)
+{
+    once_value<size_t> instance(42);
+    instance.reset();
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(7); }), 7u);
+}
+
+// A cache slot was previously a boxed value guarded by an upgrade mutex.
+BOOST_AUTO_TEST_CASE(once_value__size__smaller_than_locked_box)
+{
+    const auto boxed = sizeof(std::shared_ptr<hash_digest>) +
+        sizeof(upgrade_mutex) + sizeof(hash_digest);
+    BOOST_REQUIRE_LT(sizeof(once_value<hash_digest>), boxed);
+    BOOST_REQUIRE_LT(sizeof(chain::header), boxed);
+}
+
+BOOST_AUTO_TEST_CASE(once_value__header_hash__repeated__expected)
+{
+    const chain::header header(1, null_hash, null_hash, 2, 3, 4);
+    const auto expected = header.hash();
+    BOOST_REQUIRE(header.hash() == expected);
+    BOOST_REQUIRE(header.hash() == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
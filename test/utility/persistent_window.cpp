@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(persistent_window_tests)
+
+typedef persistent_window<uint32_t> window;
+
+BOOST_AUTO_TEST_CASE(persistent_window__constructor__default__empty)
+{
+    const window instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(instance.begin() == instance.end());
+}
+
+BOOST_AUTO_TEST_CASE(persistent_window__push_back_pop_front__slide__expected)
+{
+    window instance{ 1, 2, 3 };
+    std::deque<uint32_t> expected{ 1, 2, 3 };
+
+    for (uint32_t value = 4; value < 200; ++value)
+    {
+        instance.push_back(value);
+        instance.pop_front();
+        expected.push_back(value);
+        expected.pop_front();
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.size(), 3u);
+    BOOST_REQUIRE(std::equal(instance.begin(), instance.end(),
+        expected.begin()));
+    BOOST_REQUIRE_EQUAL(instance.front(), 197u);
+    BOOST_REQUIRE_EQUAL(instance.back(), 199u);
+    BOOST_REQUIRE_EQUAL(*std::next(instance.crbegin()), 198u);
+}
+
+BOOST_AUTO_TEST_CASE(persistent_window__copy__advance__shares_storage)
+{
+    const window parent{ 1, 2, 3 };
+    auto child = parent;
+    BOOST_REQUIRE(parent.is_shared());
+
+    child.push_back(4);
+    child.pop_front();
+    BOOST_REQUIRE(child.is_shared());
+    BOOST_REQUIRE_EQUAL(child.cbegin(), parent.cbegin() + 1);
+    BOOST_REQUIRE(parent == (window{ 1, 2, 3 }));
+    BOOST_REQUIRE(child == (window{ 2, 3, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(persistent_window__push_back__fork__siblings_independent)
+{
+    const window parent{ 1, 2, 3 };
+    auto first = parent;
+    auto second = parent;
+    first.push_back(4);
+    second.push_back(5);
+    BOOST_REQUIRE(parent == (window{ 1, 2, 3 }));
+    BOOST_REQUIRE(first == (window{ 1, 2, 3, 4 }));
+    BOOST_REQUIRE(second == (window{ 1, 2, 3, 5 }));
+}
+
+BOOST_AUTO_TEST_CASE(persistent_window__pop_back__shared__sibling_preserved)
+{
+    window parent{ 1, 2, 3 };
+    auto child = parent;
+    child.push_back(4);
+    parent.pop_back();
+    parent.push_back(5);
+    BOOST_REQUIRE(parent == (window{ 1, 2, 5 }));
+    BOOST_REQUIRE(child == (window{ 1, 2, 3, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(persistent_window__mutable_iteration__shared__detaches)
+{
+    const window parent{ 1, 2, 3 };
+    auto child = parent;
+
+    for (auto& value: child)
+        value *= 2;
+
+    BOOST_REQUIRE(!child.is_shared());
+    BOOST_REQUIRE(!parent.is_shared());
+    BOOST_REQUIRE(parent == (window{ 1, 2, 3 }));
+    BOOST_REQUIRE(child == (window{ 2, 4, 6 }));
+}
+
+BOOST_AUTO_TEST_CASE(persistent_window__resize__grow_and_shrink__expected)
+{
+    window instance;
+    instance.resize(3, 7);
+    BOOST_REQUIRE(instance == (window{ 7, 7, 7 }));
+    instance.resize(1);
+    BOOST_REQUIRE(instance == (window{ 7 }));
+    instance.clear();
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(persistent_window__move__source_empty)
+{
+    window source{ 1, 2, 3 };
+    const window instance(std::move(source));
+    BOOST_REQUIRE(source.empty());
+    BOOST_REQUIRE(instance == (window{ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
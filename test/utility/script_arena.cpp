@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(script_arena_tests)
+
+static bool is_aligned(const void* pointer, size_t alignment)
+{
+    return (reinterpret_cast<uintptr_t>(pointer) & (alignment - 1)) == 0;
+}
+
+BOOST_AUTO_TEST_CASE(script_arena__constructor__default__empty)
+{
+    const script_arena instance;
+    BOOST_REQUIRE_EQUAL(instance.allocated(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.reserved(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(script_arena__allocate__mixed_alignment__aligned)
+{
+    script_arena instance;
+    const auto first = instance.allocate(1, 1);
+    const auto second = instance.allocate(8, 8);
+    const auto third = instance.allocate(3, 1);
+    const auto fourth = instance.allocate(16, 16);
+
+    BOOST_REQUIRE(first != nullptr);
+    BOOST_REQUIRE(is_aligned(second, 8));
+    BOOST_REQUIRE(third != nullptr);
+    BOOST_REQUIRE(is_aligned(fourth, 16));
+    BOOST_REQUIRE_EQUAL(instance.allocated(), 28u);
+    BOOST_REQUIRE_EQUAL(instance.reserved(), script_arena::default_chunk_size);
+}
+
+BOOST_AUTO_TEST_CASE(script_arena__allocate__exceeds_chunk__reserves_chunk)
+{
+    script_arena instance(64);
+    instance.allocate(40, 1);
+    BOOST_REQUIRE_EQUAL(instance.reserved(), 64u);
+
+    instance.allocate(40, 1);
+    BOOST_REQUIRE_EQUAL(instance.reserved(), 128u);
+    BOOST_REQUIRE_EQUAL(instance.allocated(), 80u);
+}
+
+BOOST_AUTO_TEST_CASE(script_arena__allocate__oversized__dedicated_chunk)
+{
+    script_arena instance(64);
+    const auto pointer = static_cast<uint8_t*>(instance.allocate(1000, 8));
+    BOOST_REQUIRE(is_aligned(pointer, 8));
+    BOOST_REQUIRE_GE(instance.reserved(), 1000u);
+
+    // The memory is writable across the full extent.
+    std::fill(pointer, pointer + 1000, 0x42);
+    BOOST_REQUIRE_EQUAL(pointer[999], 0x42);
+}
+
+BOOST_AUTO_TEST_CASE(script_arena__ptr__copies__share_arena)
+{
+    const script_arena::ptr memory(new script_arena);
+    const auto copy = memory;
+    copy->allocate(10, 1);
+    BOOST_REQUIRE(copy == memory);
+    BOOST_REQUIRE_EQUAL(memory->allocated(), 10u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
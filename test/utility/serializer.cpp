@@ -528,4 +528,38 @@ BOOST_AUTO_TEST_CASE(read_bytes_to_eof)
     BOOST_REQUIRE_EQUAL(false, !source);
 }
 
+BOOST_AUTO_TEST_CASE(deserializer__position__pointer_iterator__addresses_next_byte)
+{
+    const data_chunk data{ 0x01, 0x02, 0x03, 0x04, 0x05 };
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    BOOST_REQUIRE(source.position() == begin);
+
+    source.read_2_bytes_little_endian();
+    BOOST_REQUIRE(source.position() == begin + 2);
+
+    source.read_4_bytes_little_endian();
+    BOOST_REQUIRE(!source);
+    BOOST_REQUIRE(source.position() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(deserializer__position__container_iterator__null)
+{
+    const data_chunk data{ 0x01, 0x02 };
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    BOOST_REQUIRE(source.position() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(serializer__make_safe_serializer__write_past_end__invalid_without_writing)
+{
+    data_chunk data(3, 0x00);
+    auto sink = make_safe_serializer(data.begin(), data.end());
+    sink.write_2_bytes_little_endian(0x0201);
+    BOOST_REQUIRE(sink);
+    sink.write_2_bytes_little_endian(0x0403);
+    BOOST_REQUIRE(!sink);
+    BOOST_REQUIRE(sink.position() == data.begin() + 2);
+    BOOST_REQUIRE(data == data_chunk({ 0x01, 0x02, 0x00 }));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
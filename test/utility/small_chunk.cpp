@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2011-2018 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(small_chunk_tests)
+
+BOOST_AUTO_TEST_CASE(small_chunk__constructor__default__empty_inline)
+{
+    const small_chunk instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE(instance.is_inline());
+    BOOST_REQUIRE_EQUAL(instance.capacity(), small_chunk::inline_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__constructor__signature_size__inline)
+{
+    const data_chunk expected(max_endorsement_size, 0x42);
+    const small_chunk instance(expected);
+    BOOST_REQUIRE(instance.is_inline());
+    BOOST_REQUIRE(instance == expected);
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__constructor__oversized__heap)
+{
+    const data_chunk expected(small_chunk::inline_capacity + 1u, 0x42);
+    const small_chunk instance(expected);
+    BOOST_REQUIRE(!instance.is_inline());
+    BOOST_REQUIRE(instance == expected);
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__push_back__past_inline__preserves_bytes)
+{
+    small_chunk instance;
+    data_chunk expected;
+
+    for (size_t index = 0; index < 3u * small_chunk::inline_capacity; ++index)
+    {
+        const auto value = static_cast<uint8_t>(index);
+        instance.push_back(value);
+        expected.push_back(value);
+    }
+
+    BOOST_REQUIRE(!instance.is_inline());
+    BOOST_REQUIRE(instance == expected);
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__move__inline__source_empty)
+{
+    small_chunk source{ 1, 2, 3 };
+    const small_chunk instance(std::move(source));
+    BOOST_REQUIRE(source.empty());
+    BOOST_REQUIRE(instance == (data_chunk{ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__move__heap__takes_allocation)
+{
+    small_chunk source(2u * small_chunk::inline_capacity, 0x42);
+    const auto data = source.data();
+    const small_chunk instance(std::move(source));
+    BOOST_REQUIRE_EQUAL(instance.data(), data);
+    BOOST_REQUIRE(source.empty());
+    BOOST_REQUIRE(source.is_inline());
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__insert__front__shifts_tail)
+{
+    small_chunk instance{ 3, 4 };
+    const data_chunk prefix{ 1, 2 };
+    instance.insert(instance.begin(), prefix.begin(), prefix.end());
+    BOOST_REQUIRE(instance == (data_chunk{ 1, 2, 3, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__insert__self_across_growth__expected)
+{
+    small_chunk instance(small_chunk::inline_capacity, 0x42);
+    instance.insert(instance.end(), instance.begin(), instance.end());
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u * small_chunk::inline_capacity);
+    BOOST_REQUIRE(instance == data_chunk(instance.size(), 0x42));
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__erase__middle__expected)
+{
+    small_chunk instance{ 1, 2, 3, 4 };
+    instance.erase(instance.begin() + 1, instance.begin() + 3);
+    BOOST_REQUIRE(instance == (data_chunk{ 1, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__shrink_to_fit__small_heap__inline)
+{
+    small_chunk instance(2u * small_chunk::inline_capacity, 0x42);
+    instance.resize(hash_size);
+    instance.shrink_to_fit();
+    BOOST_REQUIRE(instance.is_inline());
+    BOOST_REQUIRE(instance == data_chunk(hash_size, 0x42));
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__to_data_stack__round_trip__expected)
+{
+    const data_stack expected
+    {
+        data_chunk(short_hash_size, 0x01),
+        data_chunk(2u * small_chunk::inline_capacity, 0x02),
+        data_chunk{}
+    };
+
+    BOOST_REQUIRE(to_data_stack(to_small_stack(expected)) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(small_chunk__encode_base16__slice__expected)
+{
+    const small_chunk instance{ 0xba, 0xad, 0xf0, 0x0d };
+    BOOST_REQUIRE_EQUAL(encode_base16(instance), "baadf00d");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
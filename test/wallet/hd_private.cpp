@@ -17,6 +17,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <boost/test/unit_test.hpp>
+
+#include <cstdint>
 #include <bitcoin/bitcoin.hpp>
 
 using namespace bc;
@@ -130,4 +132,37 @@ BOOST_AUTO_TEST_CASE(hd_private__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_range__short_seed__matches_derive_private)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    secret_list normal;
+    secret_list hardened;
+    BOOST_REQUIRE(m.derive_private_range(normal, 0, 10));
+    BOOST_REQUIRE(m.derive_private_range(hardened, hd_first_hardened_key, 10));
+    BOOST_REQUIRE_EQUAL(normal.size(), 10u);
+    BOOST_REQUIRE_EQUAL(hardened.size(), 10u);
+
+    for (uint32_t index = 0; index < 10; ++index)
+    {
+        BOOST_REQUIRE(normal[index] == m.derive_private(index).secret());
+        BOOST_REQUIRE(hardened[index] ==
+            m.derive_private(hd_first_hardened_key + index).secret());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_range__spans_hardened__false)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    secret_list secrets;
+    BOOST_REQUIRE(!m.derive_private_range(secrets, hd_first_hardened_key - 1, 2));
+    BOOST_REQUIRE(!m.derive_private_range(secrets, max_uint32, 2));
+    BOOST_REQUIRE(m.derive_private_range(secrets, max_uint32, 1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
 #include <bitcoin/bitcoin.hpp>
 
 using namespace bc;
@@ -95,4 +98,82 @@ BOOST_AUTO_TEST_CASE(hd_public__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__short_seed__matches_derive_public)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_public m0h_pub = hd_private(seed, hd_private::mainnet)
+        .derive_public(hd_first_hardened_key);
+
+    point_list points;
+    BOOST_REQUIRE(m0h_pub.derive_public_range(points, 5, 20));
+    BOOST_REQUIRE_EQUAL(points.size(), 20u);
+
+    for (uint32_t index = 0; index < points.size(); ++index)
+        BOOST_REQUIRE(points[index] == m0h_pub.derive_public(5 + index).point());
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__hardened__false)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    point_list points;
+    BOOST_REQUIRE(!m_pub.derive_public_range(points, hd_first_hardened_key, 1));
+    BOOST_REQUIRE(!m_pub.derive_public_range(points,
+        hd_first_hardened_key - 1, 2));
+    BOOST_REQUIRE(m_pub.derive_public_range(points,
+        hd_first_hardened_key - 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__threadpool__matches_sequential)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    threadpool pool(3);
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    point_list expected;
+    point_list actual;
+    BOOST_REQUIRE(m_pub.derive_public_range(expected, 0, 100));
+    BOOST_REQUIRE(m_pub.derive_public_range(actual, 0, 100, pool));
+    BOOST_REQUIRE(actual == expected);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__stopped_threadpool__matches_sequential)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    threadpool pool(3);
+    pool.shutdown();
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    point_list expected;
+    point_list actual;
+    BOOST_REQUIRE(m_pub.derive_public_range(expected, 0, 100));
+    BOOST_REQUIRE(m_pub.derive_public_range(actual, 0, 100, pool));
+    BOOST_REQUIRE(actual == expected);
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__payment_address__expected)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    payment_address::list addresses;
+    BOOST_REQUIRE(m_pub.derive_public_range(addresses, 0, 3,
+        payment_address::testnet_p2kh));
+    BOOST_REQUIRE_EQUAL(addresses.size(), 3u);
+
+    for (uint32_t index = 0; index < addresses.size(); ++index)
+        BOOST_REQUIRE(addresses[index] == payment_address(ec_public(
+            m_pub.derive_public(index).point()), payment_address::testnet_p2kh));
+}
+
 BOOST_AUTO_TEST_SUITE_END()